@@ -1,8 +1,15 @@
 #pragma once
 
+#include <climits>
+#include <memory>
 #include <vector>
 #include <string>
 #include <windows.h>
+#include "FileLoader.h"
+#include "TextDocument.h"
+#include "UndoHistory.h"
+#include "UndoJournal.h"
+#include "WrapLayout.h"
 
 // Seçim yapısı
 struct Selection
@@ -21,19 +28,31 @@ struct Selection
 // Editör penceresi yapısı
 struct EditorPane
 {
-    std::vector<std::string> lines;
+    TextDocument document;
+    std::shared_ptr<FileLoader> loader; // dosya arka planda yüklenirken dolu, belge salt okunur
+    UndoHistory history;                // belgeye ait undo/redo geçmişi
+    std::shared_ptr<UndoJournal> journal; // geçmişin diskteki kopyası (dosyaya bağlı paneller)
     int cursor_row;
     int cursor_col;
     int scroll_top;
+    int scroll_row;   // satır kaydırmada scroll_top satırının yukarıda kalan görsel satırları
+    int scroll_pixel; // yumuşak kaydırma: ilk satırın yukarıda kalan piksel sayısı
+    int scroll_left;  // yatay kaydırma: soldan gizlenen sütun sayısı
     RECT rect;
     bool is_active;
     Selection selection;
     std::string filename;
     bool modified;
+    bool find_results; // dosyalarda arama sonuç paneli (salt okunur, Enter sonucu açar)
+    int dirty_first;   // son çizimden beri düzenlenen satırlar (dirty_first > dirty_last: bilinmiyor)
+    int dirty_last;
+    WrapLayout wrap;                // satır kaydırma açıkken satırların görsel satır sayıları
+    std::shared_ptr<WrapWorker> wrap_worker; // genişlik değişince tüm satırlar arka planda ölçülürken dolu
+    std::vector<WrapLayout::LineEdit> wrap_edits; // wrap_worker'ın anlık görüntüsünden sonraki düzenlemeler
 
-    EditorPane() : cursor_row(0), cursor_col(0), scroll_top(0), is_active(false), modified(false)
+    EditorPane() : cursor_row(0), cursor_col(0), scroll_top(0), scroll_row(0), scroll_pixel(0), scroll_left(0), is_active(false), modified(false), find_results(false),
+                   dirty_first(INT_MAX), dirty_last(-1)
     {
-        lines.push_back("");
         filename = "Untitled";
     }
 };
\ No newline at end of file
@@ -0,0 +1,86 @@
+#include "FileLoader.h"
+
+#include <algorithm>
+
+namespace
+{
+    // İlk parça ilk ekranı hemen doldurur, sonrakiler iki katına çıkar
+    const size_t FIRST_BATCH = 256 * 1024;
+    const size_t MAX_BATCH = 64 * 1024 * 1024;
+}
+
+FileLoader::FileLoader(std::shared_ptr<MappedFile> mapped_file, std::function<void()> progress)
+    : file(std::move(mapped_file)), on_progress(std::move(progress)), scanned(0), done(false), cancelled(false)
+{
+    worker = std::thread(&FileLoader::run, this);
+}
+
+FileLoader::~FileLoader()
+{
+    cancelled = true;
+    if (worker.joinable())
+        worker.join();
+}
+
+int FileLoader::progressPercent() const
+{
+    if (file->size() == 0)
+        return 100;
+    return static_cast<int>((scanned * 100) / file->size());
+}
+
+void FileLoader::run()
+{
+    const char *data = file->data();
+    size_t size = file->size();
+    size_t pos = 0;
+    size_t batch_size = FIRST_BATCH;
+
+    while (!cancelled)
+    {
+        size_t end = std::min(size, pos + batch_size);
+
+        Batch batch;
+        indexLines(data, pos, end, batch.newlines, batch.stats);
+        batch.last = end == size;
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            pending.push_back(std::move(batch));
+        }
+        scanned = end;
+        ready.notify_all();
+
+        if (on_progress)
+            on_progress();
+
+        if (end == size)
+            break;
+
+        pos = end;
+        batch_size = std::min(batch_size * 2, MAX_BATCH);
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        done = true;
+    }
+    ready.notify_all();
+}
+
+void FileLoader::takeBatches(std::vector<Batch> &out)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    while (!pending.empty())
+    {
+        out.push_back(std::move(pending.front()));
+        pending.pop_front();
+    }
+}
+
+void FileLoader::waitForBatch()
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    ready.wait(lock, [this]()
+               { return !pending.empty() || done; });
+}
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "LineIndex.h"
+#include "LineScanner.h"
+#include "MappedFile.h"
+
+// Dosyayı arka plan thread'inde indeksler.
+// İlk parça küçük tutulur (ilk ekran hemen çizilsin), sonraki parçalar büyür.
+// Hazır olan parçalar kuyruğa konur, UI thread'i takeBatches ile alıp belgeye ekler.
+class FileLoader
+{
+public:
+    struct Batch
+    {
+        LineIndex newlines; // mutlak '\n' konumları
+        ScanStats stats;
+        bool last;
+
+        Batch() : last(false) {}
+    };
+
+    // on_progress her parça hazır olduğunda worker thread'inden çağrılır
+    FileLoader(std::shared_ptr<MappedFile> file, std::function<void()> on_progress);
+    ~FileLoader();
+    FileLoader(const FileLoader &) = delete;
+    FileLoader &operator=(const FileLoader &) = delete;
+
+    const std::shared_ptr<MappedFile> &mappedFile() const { return file; }
+    size_t totalBytes() const { return file->size(); }
+    size_t scannedBytes() const { return scanned; }
+    int progressPercent() const;
+
+    // Bekleyen parçaları sırayla out'a taşır
+    void takeBatches(std::vector<Batch> &out);
+    // Bekleyen parça olana ya da yükleme bitene kadar bekle
+    void waitForBatch();
+
+private:
+    std::shared_ptr<MappedFile> file;
+    std::function<void()> on_progress;
+
+    std::mutex mutex;
+    std::condition_variable ready;
+    std::deque<Batch> pending;
+    std::atomic<size_t> scanned;
+    std::atomic<bool> done;
+    std::atomic<bool> cancelled;
+    std::thread worker;
+
+    void run();
+};
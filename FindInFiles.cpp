@@ -0,0 +1,262 @@
+#include "FindInFiles.h"
+
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include "MappedFile.h"
+
+namespace
+{
+    // İkili dosya tespiti için bakılan baş kısım (git ve grep de NUL byte arar)
+    const size_t BINARY_PROBE = 8 * 1024;
+    // Sonuç satırında gösterilen en fazla byte
+    const size_t PREVIEW_LENGTH = 200;
+}
+
+FindInFiles::FindInFiles(const std::string &root, const std::string &search_text, bool fold_case, bool regex,
+                         std::function<void()> progress, unsigned threads)
+    : FindInFiles(root, search_text, fold_case, regex, nullptr, std::move(progress), threads)
+{
+}
+
+FindInFiles::FindInFiles(const std::string &root, const std::string &search_text, bool fold_case, bool regex,
+                         std::function<bool(const std::filesystem::directory_entry &)> skip_file,
+                         std::function<void()> progress, unsigned threads)
+    : text(search_text), ignore_case(fold_case), use_regex(regex), on_progress(std::move(progress)),
+      skip(std::move(skip_file)), outstanding(0), queued(0), sleeping(0), notified(false), result_count(0), files_searched(0), binary_files(0),
+      skipped_files(0), bytes_searched(0), cancelled(false), running(0)
+{
+    start(std::vector<Task>(1, Task{root, true}), threads);
+}
+
+void FindInFiles::start(std::vector<Task> seeds, unsigned threads)
+{
+    if (threads == 0)
+        threads = std::max(1u, std::thread::hardware_concurrency());
+
+    for (unsigned i = 0; i < threads; i++)
+        queues.push_back(std::unique_ptr<TaskQueue>(new TaskQueue()));
+    // Başlangıç işleri kuyruklara sırayla dağıtılır, kalan dengesizliği çalma giderir
+    for (size_t i = 0; i < seeds.size(); i++)
+        pushTask(static_cast<unsigned>(i % threads), std::move(seeds[i]));
+
+    running = threads;
+    for (unsigned i = 0; i < threads; i++)
+        workers.push_back(std::thread(&FindInFiles::run, this, i));
+}
+
+FindInFiles::~FindInFiles()
+{
+    cancel();
+    for (std::thread &worker : workers)
+    {
+        if (worker.joinable())
+            worker.join();
+    }
+}
+
+void FindInFiles::cancel()
+{
+    cancelled = true;
+    wakeWorkers(true);
+}
+
+void FindInFiles::wakeWorkers(bool all)
+{
+    // Uyuyan yoksa kilit alınmaz. sleeping kilit altında artırılıp sonra koşula bakıldığından
+    // ya uyuyan değişikliği görür ya da burada sayılır; kilit bekleme başlamadan bildirimin kaybolmasını önler
+    if (sleeping == 0)
+        return;
+    {
+        std::lock_guard<std::mutex> lock(idle_mutex);
+    }
+    if (all)
+        work_ready.notify_all();
+    else
+        work_ready.notify_one();
+}
+
+void FindInFiles::takeResults(std::vector<FileMatch> &out)
+{
+    std::lock_guard<std::mutex> lock(result_mutex);
+    for (FileMatch &match : pending)
+        out.push_back(std::move(match));
+    pending.clear();
+    notified = false;
+}
+
+void FindInFiles::run(unsigned index)
+{
+    // Düzenli ifade önbelleği thread başına
+    SearchQuery query(text, ignore_case, use_regex);
+    std::vector<FileMatch> results;
+    Task task;
+
+    while (!cancelled && query.valid())
+    {
+        if (takeTask(index, task))
+        {
+            if (task.directory)
+            {
+                listDirectory(index, task.path);
+            }
+            else
+            {
+                searchFile(query, task.path, results);
+                if (!results.empty())
+                    publish(results);
+            }
+            // Son görev bittiyse bekleyenler çıkabilir
+            if (--outstanding == 0)
+                wakeWorkers(true);
+            continue;
+        }
+
+        // Kuyruklar boş ama başka thread dizin listeliyorsa yeni iş gelebilir
+        std::unique_lock<std::mutex> lock(idle_mutex);
+        sleeping++;
+        work_ready.wait(lock, [this]()
+                        { return cancelled || outstanding == 0 || queued > 0; });
+        sleeping--;
+        if (outstanding == 0)
+            break;
+    }
+
+    // Son biten thread bitişi bildirir
+    if (--running == 0 && on_progress)
+        on_progress();
+}
+
+bool FindInFiles::takeTask(unsigned index, Task &task)
+{
+    // Kendi kuyruğunun sonu (derinlik öncelikli, dizin önbellekte sıcak)
+    {
+        TaskQueue &own = *queues[index];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        if (!own.tasks.empty())
+        {
+            task = std::move(own.tasks.back());
+            own.tasks.pop_back();
+            queued--;
+            return true;
+        }
+    }
+
+    // Diğerlerinin başından çal
+    for (size_t step = 1; step < queues.size(); step++)
+    {
+        TaskQueue &victim = *queues[(index + step) % queues.size()];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (!victim.tasks.empty())
+        {
+            task = std::move(victim.tasks.front());
+            victim.tasks.pop_front();
+            queued--;
+            return true;
+        }
+    }
+    return false;
+}
+
+void FindInFiles::pushTask(unsigned index, Task task)
+{
+    outstanding++;
+    {
+        TaskQueue &own = *queues[index];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        own.tasks.push_back(std::move(task));
+    }
+    queued++;
+    wakeWorkers(false);
+}
+
+void FindInFiles::listDirectory(unsigned index, const std::string &path)
+{
+    namespace fs = std::filesystem;
+    try
+    {
+        std::error_code error;
+        for (fs::directory_iterator it(path, error), end; !error && it != end && !cancelled; it.increment(error))
+        {
+            const fs::directory_entry &entry = *it;
+            std::string name = entry.path().filename().string();
+            if (name.empty() || name[0] == '.')
+                continue;
+
+            std::error_code type_error;
+            if (entry.is_directory(type_error))
+            {
+                if (!entry.is_symlink(type_error)) // döngüye girmemek için bağlantılar izlenmez
+                    pushTask(index, Task{entry.path().string(), true});
+            }
+            else if (entry.is_regular_file(type_error))
+            {
+                if (skip && skip(entry))
+                    skipped_files++;
+                else
+                    pushTask(index, Task{entry.path().string(), false});
+            }
+        }
+    }
+    catch (...)
+    {
+        // Adı çevrilemeyen girdiler (Windows'ta Unicode yol) atlanır
+    }
+}
+
+void FindInFiles::searchFile(SearchQuery &query, const std::string &path, std::vector<FileMatch> &out)
+{
+    std::shared_ptr<MappedFile> file = MappedFile::open(path);
+    if (!file || file->size() == 0)
+        return;
+
+    const char *data = file->data();
+    size_t size = file->size();
+    files_searched++;
+    if (memchr(data, 0, std::min(size, BINARY_PROBE)))
+    {
+        binary_files++;
+        return;
+    }
+    bytes_searched += size;
+
+    // Satır numarası eşleşmeler arasında sayılarak ilerletilir
+    size_t line = 0, counted = 0;
+    size_t pos = 0, match_start = 0, match_end = 0;
+    while (!cancelled && pos <= size && query.find(data, size, pos, match_start, match_end))
+    {
+        line += std::count(data + counted, data + match_start, '\n');
+        counted = match_start;
+
+        size_t line_start = match_start;
+        while (line_start > 0 && data[line_start - 1] != '\n')
+            line_start--;
+        const char *newline = static_cast<const char *>(memchr(data + match_start, '\n', size - match_start));
+        size_t line_end = newline ? static_cast<size_t>(newline - data) : size;
+
+        size_t preview_end = std::min(line_end, line_start + PREVIEW_LENGTH);
+        if (preview_end > line_start && data[preview_end - 1] == '\r')
+            preview_end--;
+        out.push_back(FileMatch{path, line, match_start - line_start,
+                                std::string(data + line_start, preview_end - line_start)});
+        pos = line_end + 1; // satır başına tek sonuç
+    }
+}
+
+void FindInFiles::publish(std::vector<FileMatch> &results)
+{
+    bool notify = false;
+    {
+        std::lock_guard<std::mutex> lock(result_mutex);
+        for (FileMatch &match : results)
+            pending.push_back(std::move(match));
+        notify = !notified.exchange(true);
+    }
+    if ((result_count += results.size()) >= MAX_RESULTS)
+        cancel();
+    results.clear();
+
+    // UI önceki bildirimi almadıysa yeni mesaj gönderilmez
+    if (notify && on_progress)
+        on_progress();
+}
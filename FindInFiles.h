@@ -0,0 +1,107 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "SearchWorker.h"
+
+struct FileMatch
+{
+    std::string path;
+    size_t line;   // 0 tabanlı
+    size_t column; // byte
+    std::string preview;
+};
+
+// Çalışma alanında paralel arama (find in files)
+// - Dizin ağacı work-stealing havuzla gezilir: her thread kendi kuyruğunun sonundan iş alır,
+//   boşalınca diğerlerinin başından çalar (başta duran işler büyük alt ağaçlardır)
+// - Dosyalar kopyalanmadan eşlenir; ilk 8 KB'ında NUL byte olan dosyalar ikili sayılıp atlanır
+// - Gizli dizinler (.git gibi) ve sembolik bağlantılı dizinler gezilmez
+// - Satır başına tek sonuç; sonuçlar dosya dosya gelir, UI thread'i takeResults ile alır
+class FindInFiles
+{
+public:
+    static constexpr size_t MAX_RESULTS = 100000;
+
+    // on_progress yeni sonuç bekliyorsa ve bitişte worker thread'inden çağrılır (UI alana kadar bir kez)
+    FindInFiles(const std::string &root, const std::string &text, bool ignore_case, bool use_regex,
+                std::function<void()> on_progress, unsigned threads = 0);
+    // Ağaç gezilirken skip'in true döndürdüğü dosyalar açılmaz (trigram indeksinin eleyebildikleri)
+    FindInFiles(const std::string &root, const std::string &text, bool ignore_case, bool use_regex,
+                std::function<bool(const std::filesystem::directory_entry &)> skip, std::function<void()> on_progress,
+                unsigned threads = 0);
+    ~FindInFiles();
+    FindInFiles(const FindInFiles &) = delete;
+    FindInFiles &operator=(const FindInFiles &) = delete;
+
+    void cancel();
+    bool finished() const { return running == 0; }
+    bool truncated() const { return result_count >= MAX_RESULTS; }
+
+    // Bekleyen sonuçları out'un sonuna taşır
+    void takeResults(std::vector<FileMatch> &out);
+
+    size_t filesSearched() const { return files_searched; }
+    size_t binaryFiles() const { return binary_files; }
+    size_t skippedFiles() const { return skipped_files; }
+    size_t bytesSearched() const { return bytes_searched; }
+
+private:
+    struct Task
+    {
+        std::string path;
+        bool directory;
+    };
+
+    struct TaskQueue
+    {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    std::string text;
+    bool ignore_case;
+    bool use_regex;
+    std::function<void()> on_progress;
+    std::function<bool(const std::filesystem::directory_entry &)> skip;
+
+    std::vector<std::unique_ptr<TaskQueue>> queues;
+    std::atomic<size_t> outstanding; // kuyrukta ya da işlenmekte olan görev sayısı; 0 olunca iş biter
+    std::atomic<size_t> queued;      // kuyrukta bekleyen görev sayısı
+
+    // İş bulamayan thread'ler yeni görev, bitiş ya da iptal gelene kadar burada uyur
+    std::mutex idle_mutex;
+    std::condition_variable work_ready;
+    std::atomic<unsigned> sleeping;
+
+    std::mutex result_mutex;
+    std::vector<FileMatch> pending;
+    std::atomic<bool> notified; // UI'a haber verildi, henüz almadı
+
+    std::atomic<size_t> result_count;
+    std::atomic<size_t> files_searched;
+    std::atomic<size_t> binary_files;
+    std::atomic<size_t> skipped_files;
+    std::atomic<size_t> bytes_searched;
+    std::atomic<bool> cancelled;
+    std::atomic<unsigned> running;
+    std::vector<std::thread> workers;
+
+    void start(std::vector<Task> seeds, unsigned threads);
+    void run(unsigned index);
+    bool takeTask(unsigned index, Task &task);
+    void pushTask(unsigned index, Task task);
+    void wakeWorkers(bool all);
+    void listDirectory(unsigned index, const std::string &path);
+    void searchFile(SearchQuery &query, const std::string &path, std::vector<FileMatch> &out);
+    void publish(std::vector<FileMatch> &results);
+};
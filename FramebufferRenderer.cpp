@@ -0,0 +1,143 @@
+#include "FramebufferRenderer.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+
+FramebufferRenderer::FramebufferRenderer()
+    : target(nullptr), target_width(0), target_height(0), stride(0), atlas(nullptr), clip{0, 0, 0, 0}, written(0)
+{
+}
+
+void FramebufferRenderer::attach(uint32_t *pixels, int width, int height, ptrdiff_t row_stride, GlyphAtlas *glyphs)
+{
+    target = pixels;
+    target_width = pixels ? width : 0;
+    target_height = pixels ? height : 0;
+    stride = row_stride;
+    atlas = glyphs;
+    clip = RenderRect{0, 0, target_width, target_height};
+}
+
+void FramebufferRenderer::setClip(const RenderRect &rect)
+{
+    clip.left = std::max(rect.left, 0);
+    clip.top = std::max(rect.top, 0);
+    clip.right = std::min(rect.right, target_width);
+    clip.bottom = std::min(rect.bottom, target_height);
+}
+
+void FramebufferRenderer::fillRect(const RenderRect &rect, RenderColor color)
+{
+    int left = std::max(rect.left, clip.left);
+    int right = std::min(rect.right, clip.right);
+    int top = std::max(rect.top, clip.top);
+    int bottom = std::min(rect.bottom, clip.bottom);
+    if (left >= right || top >= bottom)
+        return;
+
+    uint32_t pixel = framebufferPixel(color);
+    for (int y = top; y < bottom; y++)
+        std::fill(row(y) + left, row(y) + right, pixel);
+    written += static_cast<unsigned long long>(right - left) * (bottom - top);
+}
+
+void FramebufferRenderer::drawText(int x, int y, const char *text, size_t length, RenderColor color,
+                                   RenderColor background)
+{
+    if (!atlas || length == 0)
+        return;
+    int cell_width = atlas->cellWidth();
+    int top = std::max(y, clip.top);
+    int bottom = std::min(y + atlas->cellHeight(), clip.bottom);
+    if (top >= bottom || x >= clip.right)
+        return;
+
+    // Sadece kırpma alanıyla kesişen karakterler: soldaki ve sağdaki kısım hiç okunmaz
+    size_t first = x < clip.left ? static_cast<size_t>(clip.left - x) / cell_width : 0;
+    size_t last = std::min(length, static_cast<size_t>(clip.right - x + cell_width - 1) / cell_width);
+    if (first >= last)
+        return;
+    int span_left = std::max(x + static_cast<int>(first) * cell_width, clip.left);
+    int span_right = std::min(x + static_cast<int>(last) * cell_width, clip.right);
+    size_t cell_pixels = atlas->cellPixels();
+    uint32_t pixel = framebufferPixel(color);
+
+    if (background == TRANSPARENT_COLOR)
+    {
+        // Saydam arka plan: kapsamaya göre mevcut piksellerle karıştırılır
+        for (int py = top; py < bottom; py++)
+        {
+            uint32_t *pixels = row(py);
+            for (size_t i = first; i < last; i++)
+            {
+                int cell_x = x + static_cast<int>(i) * cell_width;
+                const uint8_t *alpha = atlas->coverage(static_cast<unsigned char>(text[i])) + (py - y) * cell_width;
+                for (int px = std::max(cell_x, clip.left); px < std::min(cell_x + cell_width, clip.right); px++)
+                {
+                    uint8_t a = alpha[px - cell_x];
+                    if (a)
+                    {
+                        pixels[px] = a == 255 ? pixel : GlyphAtlas::blend(pixels[px], pixel, a);
+                        written++;
+                    }
+                }
+            }
+        }
+        return;
+    }
+
+    // Kenarlarda kırpılan hücreler ayrı, aradaki tam hücreler sabit genişlikte kopyalanır
+    const uint32_t *glyphs = atlas->colored(pixel, framebufferPixel(background));
+    size_t inner_first = x + static_cast<int>(first) * cell_width < clip.left ? first + 1 : first;
+    size_t inner_last = x + static_cast<int>(last) * cell_width > clip.right ? last - 1 : last;
+    for (int py = top; py < bottom; py++)
+    {
+        uint32_t *pixels = row(py);
+        size_t glyph_row = static_cast<size_t>(py - y) * cell_width;
+        for (size_t i = first; i < last; i++)
+        {
+            int cell_x = x + static_cast<int>(i) * cell_width;
+            const uint32_t *glyph = glyphs + GlyphAtlas::glyphIndex(static_cast<unsigned char>(text[i])) * cell_pixels +
+                                    glyph_row;
+            if (i >= inner_first && i < inner_last)
+            {
+                std::memcpy(pixels + cell_x, glyph, cell_width * sizeof(uint32_t));
+                continue;
+            }
+            int left = std::max(cell_x, clip.left);
+            int right = std::min(cell_x + cell_width, clip.right);
+            std::memcpy(pixels + left, glyph + (left - cell_x), (right - left) * sizeof(uint32_t));
+        }
+    }
+    written += static_cast<unsigned long long>(span_right - span_left) * (bottom - top);
+}
+
+int FramebufferRenderer::textWidth(const char *, size_t length)
+{
+    return atlas ? static_cast<int>(length) * atlas->cellWidth() : 0;
+}
+
+void FramebufferRenderer::scroll(const RenderRect &rect, int dy)
+{
+    int left = std::max(rect.left, 0);
+    int right = std::min(rect.right, target_width);
+    int top = std::max(rect.top, 0);
+    int bottom = std::min(rect.bottom, target_height);
+    if (left >= right || top >= bottom || dy == 0 || std::abs(dy) >= bottom - top)
+        return;
+
+    // Satırlar üst üste bindiği için kopyalama yönü kaydırma yönünün tersinden başlar
+    size_t bytes = static_cast<size_t>(right - left) * sizeof(uint32_t);
+    if (dy > 0)
+    {
+        for (int y = bottom - 1; y >= top + dy; y--)
+            std::memmove(row(y) + left, row(y - dy) + left, bytes);
+    }
+    else
+    {
+        for (int y = top; y < bottom + dy; y++)
+            std::memmove(row(y) + left, row(y - dy) + left, bytes);
+    }
+    written += static_cast<unsigned long long>(right - left) * (bottom - top - std::abs(dy));
+}
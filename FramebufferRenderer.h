@@ -0,0 +1,49 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include "GlyphAtlas.h"
+#include "Renderer.h"
+
+// Framebuffer pikselleri 0x00RRGGBB (32 bit DIB düzeni); RenderColor'dan kırmızı ve mavi yer değiştirir.
+// Dönüşüm kendisinin tersidir
+inline uint32_t framebufferPixel(RenderColor color)
+{
+    return (color & 0x0000FF00) | ((color & 0xFF) << 16) | ((color >> 16) & 0xFF);
+}
+
+// 32 bit piksel belleğine yazılımla çizen renderer; metin glyph atlasından kopyalanır
+// Bellek türetilen sınıfa aittir: HeadlessRenderer kendi vektörü, GdiRenderer pencerenin DIB section'ı
+class FramebufferRenderer : public Renderer
+{
+public:
+    void setClip(const RenderRect &rect) override;
+    RenderRect clipRect() const override { return clip; }
+    void fillRect(const RenderRect &rect, RenderColor color) override;
+    void drawText(int x, int y, const char *text, size_t length, RenderColor color, RenderColor background) override;
+    int textWidth(const char *text, size_t length) override;
+    void scroll(const RenderRect &rect, int dy) override;
+
+    // Yazılan piksel sayısı (doldurma + yazı), resetCounters ile sıfırlanır
+    unsigned long long pixelsWritten() const { return written; }
+    void resetCounters() { written = 0; }
+
+protected:
+    FramebufferRenderer();
+
+    // stride: satırlar arası piksel sayısı (alttan yukarı DIB'de negatif). pixels null ise hiçbir şey çizilmez
+    void attach(uint32_t *pixels, int width, int height, ptrdiff_t stride, GlyphAtlas *atlas);
+    uint32_t *row(int y) const { return target + y * stride; }
+
+private:
+    uint32_t *target;
+    int target_width;
+    int target_height;
+    ptrdiff_t stride;
+    GlyphAtlas *atlas;
+    RenderRect clip;
+    unsigned long long written;
+
+    FramebufferRenderer(const FramebufferRenderer &) = delete;
+    FramebufferRenderer &operator=(const FramebufferRenderer &) = delete;
+};
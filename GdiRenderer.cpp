@@ -0,0 +1,86 @@
+#include "GdiRenderer.h"
+
+GdiRenderer::GdiRenderer(HDC hdc, GlyphAtlas &atlas)
+{
+    // GDI'ın bekleyen çizimleri bitmeden DIB belleğine yazılmaz
+    GdiFlush();
+
+    DIBSECTION section;
+    HGDIOBJ bitmap = GetCurrentObject(hdc, OBJ_BITMAP);
+    if (GetObject(bitmap, sizeof(section), &section) != sizeof(section) || section.dsBm.bmBitsPixel != 32 ||
+        !section.dsBm.bmBits)
+        return;
+
+    // 32 bit satırlar hizalı: satır başına tam genişlik kadar piksel
+    int width = section.dsBm.bmWidth;
+    int height = section.dsBm.bmHeight;
+    uint32_t *bits = static_cast<uint32_t *>(section.dsBm.bmBits);
+    if (section.dsBmih.biHeight > 0)
+        attach(bits + static_cast<size_t>(height - 1) * width, width, height, -static_cast<ptrdiff_t>(width), &atlas);
+    else
+        attach(bits, width, height, width, &atlas);
+}
+
+void GdiRenderer::rasterizeFont(HFONT font, GlyphAtlas &atlas)
+{
+    // 16x8 hücrelik beyaz-siyah tabloya her karakter bir kez yazılır, parlaklık kapsama olur
+    // (ClearType renk kanalları ortalanır)
+    int cell_width = atlas.cellWidth();
+    int cell_height = atlas.cellHeight();
+    int sheet_width = cell_width * 16;
+
+    BITMAPINFO info = {};
+    info.bmiHeader.biSize = sizeof(BITMAPINFOHEADER);
+    info.bmiHeader.biWidth = sheet_width;
+    info.bmiHeader.biHeight = -cell_height * 8; // yukarıdan aşağı
+    info.bmiHeader.biPlanes = 1;
+    info.bmiHeader.biBitCount = 32;
+    info.bmiHeader.biCompression = BI_RGB;
+
+    void *bits = nullptr;
+    HDC dc = CreateCompatibleDC(NULL);
+    HBITMAP sheet = CreateDIBSection(dc, &info, DIB_RGB_COLORS, &bits, NULL, 0);
+    if (!dc || !sheet || !bits)
+    {
+        if (sheet)
+            DeleteObject(sheet);
+        if (dc)
+            DeleteDC(dc);
+        return;
+    }
+
+    HGDIOBJ old_bitmap = SelectObject(dc, sheet);
+    HGDIOBJ old_font = SelectObject(dc, font);
+    SetBkMode(dc, OPAQUE);
+    SetBkColor(dc, RGB(0, 0, 0));
+    SetTextColor(dc, RGB(255, 255, 255));
+    for (int ch = 32; ch < 127; ch++)
+    {
+        char text = static_cast<char>(ch);
+        TextOutA(dc, (ch % 16) * cell_width, (ch / 16) * cell_height, &text, 1);
+    }
+    GdiFlush();
+
+    const uint32_t *pixels = static_cast<const uint32_t *>(bits);
+    for (int ch = 0; ch < 128; ch++)
+    {
+        uint8_t *coverage = atlas.coverage(static_cast<unsigned char>(ch));
+        for (int y = 0; y < cell_height; y++)
+        {
+            const uint32_t *row = pixels + static_cast<size_t>((ch / 16) * cell_height + y) * sheet_width +
+                                  (ch % 16) * cell_width;
+            for (int x = 0; x < cell_width; x++)
+            {
+                uint32_t pixel = row[x];
+                coverage[y * cell_width + x] =
+                    static_cast<uint8_t>(((pixel & 0xFF) + ((pixel >> 8) & 0xFF) + ((pixel >> 16) & 0xFF)) / 3);
+            }
+        }
+    }
+    atlas.invalidate();
+
+    SelectObject(dc, old_font);
+    SelectObject(dc, old_bitmap);
+    DeleteObject(sheet);
+    DeleteDC(dc);
+}
@@ -0,0 +1,24 @@
+#pragma once
+
+#include <windows.h>
+#include "FramebufferRenderer.h"
+#include "GlyphAtlas.h"
+
+// Windows RECT ile RenderRect aynı düzende
+inline RenderRect renderRect(const RECT &rect)
+{
+    return RenderRect{static_cast<int>(rect.left), static_cast<int>(rect.top), static_cast<int>(rect.right),
+                      static_cast<int>(rect.bottom)};
+}
+
+// Pencerenin arka tamponuna (DC'de seçili 32 bit DIB section) doğrudan yazan renderer
+// Metin satır başına TextOut yerine yazı tipinden önceden rasterize edilmiş glyph atlasından kopyalanır
+class GdiRenderer : public FramebufferRenderer
+{
+public:
+    // hdc'de seçili bitmap 32 bit DIB section değilse hiçbir şey çizilmez
+    GdiRenderer(HDC hdc, GlyphAtlas &atlas);
+
+    // Yazı tipinin ASCII glyph'lerini atlasın hücrelerine rasterize eder (yazı tipi ya da boyutu değişince)
+    static void rasterizeFont(HFONT font, GlyphAtlas &atlas);
+};
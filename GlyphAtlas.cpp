@@ -0,0 +1,68 @@
+#include "GlyphAtlas.h"
+
+#include <algorithm>
+
+namespace
+{
+    // Bir çizimde kullanılan renk çifti sayısı az; aşılırsa tablo baştan kurulur
+    const size_t MAX_COLOR_PAIRS = 32;
+}
+
+GlyphAtlas::GlyphAtlas(int width, int height)
+    : cell_width(std::max(width, 1)), cell_height(std::max(height, 1)), coverages(128 * cellPixels(), 0), last_used(0), builds(0)
+{
+}
+
+void GlyphAtlas::invalidate()
+{
+    colors.clear();
+    last_used = 0;
+}
+
+uint32_t GlyphAtlas::blend(uint32_t background, uint32_t color, uint8_t alpha)
+{
+    uint32_t result = 0;
+    for (int shift = 0; shift < 24; shift += 8)
+    {
+        uint32_t from = (background >> shift) & 0xFF;
+        uint32_t to = (color >> shift) & 0xFF;
+        result |= ((from * (255 - alpha) + to * alpha + 127) / 255) << shift;
+    }
+    return result;
+}
+
+const uint32_t *GlyphAtlas::colored(uint32_t color, uint32_t background)
+{
+    if (last_used < colors.size() && colors[last_used].color == color && colors[last_used].background == background)
+        return colors[last_used].pixels.data();
+
+    for (size_t i = 0; i < colors.size(); i++)
+    {
+        if (colors[i].color == color && colors[i].background == background)
+        {
+            last_used = i;
+            return colors[i].pixels.data();
+        }
+    }
+
+    if (colors.size() >= MAX_COLOR_PAIRS)
+        colors.clear();
+    colors.push_back(ColoredGlyphs{color, background, std::vector<uint32_t>(coverages.size())});
+    std::vector<uint32_t> &pixels = colors.back().pixels;
+    for (size_t i = 0; i < coverages.size(); i++)
+    {
+        uint8_t alpha = coverages[i];
+        pixels[i] = alpha == 0 ? background : alpha == 255 ? color : blend(background, color, alpha);
+    }
+    last_used = colors.size() - 1;
+    builds++;
+    return pixels.data();
+}
+
+size_t GlyphAtlas::memoryUsage() const
+{
+    size_t bytes = coverages.capacity();
+    for (const ColoredGlyphs &glyphs : colors)
+        bytes += glyphs.pixels.capacity() * sizeof(uint32_t);
+    return bytes;
+}
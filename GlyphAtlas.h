@@ -0,0 +1,52 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Sabit genişlikli yazı tipinin önceden rasterize edilmiş ASCII glyph'leri
+// Kapsama değerleri (0 boş - 255 dolu) yazı tipi ya da boyutu değişince bir kez doldurulur.
+// Her (yazı rengi, arka plan) çifti için hazır pikseller ilk kullanımda üretilir;
+// böylece bir karakter çizmek hücre satırı başına bir kopyadır
+class GlyphAtlas
+{
+public:
+    GlyphAtlas(int cell_width, int cell_height);
+
+    int cellWidth() const { return cell_width; }
+    int cellHeight() const { return cell_height; }
+    size_t cellPixels() const { return static_cast<size_t>(cell_width) * cell_height; }
+
+    // Karakterin cell_width x cell_height kapsama değerleri; değiştirdikten sonra invalidate() çağrılmalı
+    uint8_t *coverage(unsigned char ch) { return coverages.data() + glyphIndex(ch) * cellPixels(); }
+    const uint8_t *coverage(unsigned char ch) const { return coverages.data() + glyphIndex(ch) * cellPixels(); }
+    // Renklendirilmiş glyph'leri atar
+    void invalidate();
+
+    // 128 karakterlik renkli glyph tablosu (framebuffer piksel düzeninde); karakter i: tablo + i * cellPixels()
+    const uint32_t *colored(uint32_t color, uint32_t background);
+
+    // ASCII dışı karakterler '?' olarak çizilir
+    static size_t glyphIndex(unsigned char ch) { return ch < 128 ? ch : '?'; }
+    // Kapsamaya göre iki pikselin karışımı
+    static uint32_t blend(uint32_t background, uint32_t color, uint8_t alpha);
+
+    size_t memoryUsage() const;
+    // Üretilen renkli glyph tablosu sayısı
+    unsigned long long tableBuilds() const { return builds; }
+
+private:
+    struct ColoredGlyphs
+    {
+        uint32_t color;
+        uint32_t background;
+        std::vector<uint32_t> pixels;
+    };
+
+    int cell_width;
+    int cell_height;
+    std::vector<uint8_t> coverages;
+    std::vector<ColoredGlyphs> colors;
+    size_t last_used; // ardışık çizimler çoğunlukla aynı renkle
+    unsigned long long builds;
+};
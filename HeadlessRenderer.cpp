@@ -0,0 +1,50 @@
+#include "HeadlessRenderer.h"
+
+#include <algorithm>
+
+namespace
+{
+    // Hücrenin üst ve altında boşluk bırakılır (satır aralığı gibi)
+    const int GLYPH_MARGIN = 2;
+}
+
+HeadlessRenderer::HeadlessRenderer(int width, int height, int char_width, int char_height)
+    : frame_width(std::max(width, 1)), frame_height(std::max(height, 1)),
+      frame(static_cast<size_t>(frame_width) * frame_height, 0), atlas(char_width, char_height)
+{
+    // Yazdırılabilir her karakter için sabit bir desen: karakterden türetilen xorshift dizisi,
+    // yaklaşık yarısı dolu (gerçek glyph'lerin kapsamasına yakın)
+    int cell_width = atlas.cellWidth();
+    int cell_height = atlas.cellHeight();
+    for (int ch = 33; ch < 127; ch++)
+    {
+        uint32_t state = 2166136261u ^ static_cast<uint32_t>(ch) * 16777619u;
+        uint8_t *coverage = atlas.coverage(static_cast<unsigned char>(ch));
+        for (int row = GLYPH_MARGIN; row < cell_height - GLYPH_MARGIN; row++)
+        {
+            for (int col = 0; col < cell_width; col++)
+            {
+                if (col % 32 == 0)
+                {
+                    state ^= state << 13;
+                    state ^= state >> 17;
+                    state ^= state << 5;
+                }
+                uint32_t bits = state & (state >> 7);
+                coverage[row * cell_width + col] = (bits >> (col % 32)) & 1 ? 255 : 0;
+            }
+        }
+    }
+    attach(frame.data(), frame_width, frame_height, frame_width, &atlas);
+}
+
+uint64_t HeadlessRenderer::checksum() const
+{
+    uint64_t hash = 14695981039346656037ull;
+    for (uint32_t value : frame)
+    {
+        hash ^= value;
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
@@ -0,0 +1,31 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include "FramebufferRenderer.h"
+#include "GlyphAtlas.h"
+
+// Bellekteki 32 bit framebuffer'a çizen yazılım renderer'ı (pencere gerektirmez)
+// Yazı tipi sentetiktir: her karakterin hücrede sabit, karaktere özgü bir bit deseni vardır.
+// Okunabilir değildir ama glyph atlasından kopyalama maliyeti gerçek yazı tipiyle aynıdır; çıktı deterministiktir,
+// checksum() ile çizim değişiklikleri yakalanabilir.
+class HeadlessRenderer : public FramebufferRenderer
+{
+public:
+    HeadlessRenderer(int width, int height, int char_width, int char_height);
+
+    int width() const { return frame_width; }
+    int height() const { return frame_height; }
+    // Framebuffer düzeninde (0x00RRGGBB) pikseller
+    const uint32_t *pixels() const { return frame.data(); }
+    RenderColor pixel(int x, int y) const { return framebufferPixel(frame[static_cast<size_t>(y) * frame_width + x]); }
+
+    // Framebuffer içeriğinin FNV-1a özeti
+    uint64_t checksum() const;
+
+private:
+    int frame_width;
+    int frame_height;
+    std::vector<uint32_t> frame;
+    GlyphAtlas atlas;
+};
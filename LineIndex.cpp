@@ -0,0 +1,66 @@
+#include "LineIndex.h"
+
+#include <algorithm>
+
+void LineIndex::clear()
+{
+    low.clear();
+    segment_starts.assign(1, 0);
+}
+
+void LineIndex::push_back(size_t position)
+{
+    size_t segment = static_cast<size_t>(static_cast<uint64_t>(position) >> 32);
+    while (segment_starts.size() <= segment)
+        segment_starts.push_back(low.size());
+    low.push_back(static_cast<uint32_t>(position));
+}
+
+void LineIndex::appendRelative(size_t base, const uint32_t *relative, size_t count)
+{
+    if (count == 0)
+        return;
+
+    // Hepsi son segmentin içindeyse alt 32 biti doğrudan yaz
+    size_t first_segment = static_cast<size_t>(static_cast<uint64_t>(base + relative[0]) >> 32);
+    size_t last_segment = static_cast<size_t>(static_cast<uint64_t>(base + relative[count - 1]) >> 32);
+    if (first_segment == last_segment && first_segment + 1 == segment_starts.size())
+    {
+        size_t size = low.size();
+        low.resize(size + count);
+        for (size_t i = 0; i < count; i++)
+            low[size + i] = static_cast<uint32_t>(base + relative[i]);
+        return;
+    }
+
+    for (size_t i = 0; i < count; i++)
+        push_back(base + relative[i]);
+}
+
+void LineIndex::append(const LineIndex &other)
+{
+    low.reserve(low.size() + other.size());
+    for (size_t i = 0; i < other.size(); i++)
+        push_back(other[i]);
+}
+
+size_t LineIndex::operator[](size_t index) const
+{
+    // 4 GB altı dosyalar için hızlı yol
+    if (segment_starts.size() == 1)
+        return low[index];
+
+    size_t segment = std::upper_bound(segment_starts.begin(), segment_starts.end(), index) - segment_starts.begin() - 1;
+    return static_cast<size_t>((static_cast<uint64_t>(segment) << 32) | low[index]);
+}
+
+size_t LineIndex::lowerBound(size_t position) const
+{
+    size_t segment = static_cast<size_t>(static_cast<uint64_t>(position) >> 32);
+    if (segment >= segment_starts.size())
+        return low.size();
+
+    size_t first = segment_starts[segment];
+    size_t last = segment + 1 < segment_starts.size() ? segment_starts[segment + 1] : low.size();
+    return std::lower_bound(low.begin() + first, low.begin() + last, static_cast<uint32_t>(position)) - low.begin();
+}
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Satır sonu ('\n') konumlarının sıkıştırılmış, sıralı indeksi
+// Konumların alt 32 biti tutulur; 4 GB sınırını aşan dosyalar için her 4 GB'lık
+// segmentin ilk elemanı ayrıca saklanır. Bellek kullanımı ~4 byte/satır.
+class LineIndex
+{
+public:
+    LineIndex() : segment_starts(1, 0) {}
+
+    void clear();
+    void reserve(size_t count) { low.reserve(count); }
+    void push_back(size_t position);
+    // base + relative[i] konumlarını toplu ekle (sıralı olmalı)
+    void appendRelative(size_t base, const uint32_t *relative, size_t count);
+    void append(const LineIndex &other);
+
+    size_t size() const { return low.size(); }
+    bool empty() const { return low.empty(); }
+    size_t operator[](size_t index) const;
+
+    // position'dan büyük ya da eşit ilk elemanın sırası
+    size_t lowerBound(size_t position) const;
+    // [start, start + length) aralığındaki eleman sayısı
+    size_t countInRange(size_t start, size_t length) const { return lowerBound(start + length) - lowerBound(start); }
+
+    size_t memoryUsage() const { return low.capacity() * sizeof(uint32_t) + segment_starts.capacity() * sizeof(size_t); }
+
+private:
+    std::vector<uint32_t> low;          // konumların alt 32 biti
+    std::vector<size_t> segment_starts; // segment_starts[k]: üst 32 biti k olan ilk elemanın sırası
+};
@@ -0,0 +1,251 @@
+#include "LineScanner.h"
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define GLITCH_X86 1
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+#define GLITCH_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define GLITCH_TARGET_AVX2
+#endif
+
+namespace
+{
+    const size_t PARALLEL_THRESHOLD = 4 * 1024 * 1024; // bunun altı tek thread
+    const size_t CHUNK_SIZE = 16 * 1024 * 1024;
+
+    inline unsigned countTrailingZeros(uint32_t mask)
+    {
+#ifdef _MSC_VER
+        unsigned long index;
+        _BitScanForward(&index, mask);
+        return index;
+#else
+        return __builtin_ctz(mask);
+#endif
+    }
+
+    inline unsigned popCount(uint32_t mask)
+    {
+#ifdef _MSC_VER
+        return __popcnt(mask);
+#else
+        return __builtin_popcount(mask);
+#endif
+    }
+
+    // Maske içindeki her '\n' bitini göreli konum olarak ekle
+    inline void emitMask(uint32_t mask, size_t relative, std::vector<uint32_t> &positions)
+    {
+        while (mask)
+        {
+            positions.push_back(static_cast<uint32_t>(relative + countTrailingZeros(mask)));
+            mask &= mask - 1;
+        }
+    }
+
+    size_t scanScalar(const char *data, size_t begin, size_t from, size_t end,
+                      std::vector<uint32_t> &positions, ScanStats &stats)
+    {
+        for (size_t i = from; i < end; i++)
+        {
+            if (data[i] == '\n')
+            {
+                positions.push_back(static_cast<uint32_t>(i - begin));
+                stats.newlines++;
+                if (i > 0 && data[i - 1] == '\r')
+                    stats.crlf++;
+            }
+        }
+        return end;
+    }
+
+#ifdef GLITCH_X86
+    size_t scanSse2(const char *data, size_t begin, size_t end,
+                    std::vector<uint32_t> &positions, ScanStats &stats)
+    {
+        const __m128i newline = _mm_set1_epi8('\n');
+        const __m128i carriage = _mm_set1_epi8('\r');
+        uint32_t prev_cr = (begin > 0 && data[begin - 1] == '\r') ? 1 : 0;
+
+        size_t i = begin;
+        for (; i + 16 <= end; i += 16)
+        {
+            __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + i));
+            uint32_t nl_mask = static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(block, newline)));
+            if (nl_mask)
+            {
+                uint32_t cr_mask = static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(block, carriage)));
+                stats.newlines += popCount(nl_mask);
+                stats.crlf += popCount(nl_mask & ((cr_mask << 1) | prev_cr));
+                emitMask(nl_mask, i - begin, positions);
+            }
+            prev_cr = data[i + 15] == '\r' ? 1 : 0;
+        }
+        return i;
+    }
+
+    GLITCH_TARGET_AVX2 size_t scanAvx2(const char *data, size_t begin, size_t end,
+                                       std::vector<uint32_t> &positions, ScanStats &stats)
+    {
+        const __m256i newline = _mm256_set1_epi8('\n');
+        const __m256i carriage = _mm256_set1_epi8('\r');
+        uint32_t prev_cr = (begin > 0 && data[begin - 1] == '\r') ? 1 : 0;
+
+        size_t i = begin;
+        for (; i + 32 <= end; i += 32)
+        {
+            __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(data + i));
+            uint32_t nl_mask = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(block, newline)));
+            if (nl_mask)
+            {
+                uint32_t cr_mask = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(block, carriage)));
+                stats.newlines += popCount(nl_mask);
+                stats.crlf += popCount(nl_mask & ((cr_mask << 1) | prev_cr));
+                emitMask(nl_mask, i - begin, positions);
+            }
+            prev_cr = data[i + 31] == '\r' ? 1 : 0;
+        }
+        return i;
+    }
+#endif
+}
+
+bool scannerSupported(ScannerKind kind)
+{
+    switch (kind)
+    {
+    case SCANNER_SCALAR:
+        return true;
+#ifdef GLITCH_X86
+    case SCANNER_SSE2:
+        return true; // x86-64 taban komut seti
+    case SCANNER_AVX2:
+#if defined(__GNUC__) || defined(__clang__)
+        return __builtin_cpu_supports("avx2");
+#elif defined(_MSC_VER)
+    {
+        int info[4];
+        __cpuid(info, 0);
+        if (info[0] < 7)
+            return false;
+        __cpuid(info, 1);
+        bool osxsave = (info[2] & (1 << 27)) != 0;
+        bool avx = (info[2] & (1 << 28)) != 0;
+        if (!osxsave || !avx || (_xgetbv(0) & 0x6) != 0x6)
+            return false;
+        __cpuidex(info, 7, 0);
+        return (info[1] & (1 << 5)) != 0;
+    }
+#else
+        return false;
+#endif
+#endif
+    default:
+        return false;
+    }
+}
+
+ScannerKind detectScanner()
+{
+    static const ScannerKind kind = scannerSupported(SCANNER_AVX2)   ? SCANNER_AVX2
+                                    : scannerSupported(SCANNER_SSE2) ? SCANNER_SSE2
+                                                                     : SCANNER_SCALAR;
+    return kind;
+}
+
+const char *scannerName(ScannerKind kind)
+{
+    switch (kind)
+    {
+    case SCANNER_AVX2:
+        return "avx2";
+    case SCANNER_SSE2:
+        return "sse2";
+    default:
+        return "scalar";
+    }
+}
+
+void scanNewlines(ScannerKind kind, const char *data, size_t begin, size_t end,
+                  std::vector<uint32_t> &positions, ScanStats &stats)
+{
+    size_t done = begin;
+#ifdef GLITCH_X86
+    if (kind == SCANNER_AVX2)
+        done = scanAvx2(data, begin, end, positions, stats);
+    else if (kind == SCANNER_SSE2)
+        done = scanSse2(data, begin, end, positions, stats);
+#else
+    (void)kind;
+#endif
+    // Vektör genişliğine sığmayan kuyruk
+    scanScalar(data, begin, done, end, positions, stats);
+}
+
+void indexLines(const char *data, size_t begin, size_t end, LineIndex &index, ScanStats &stats, unsigned threads)
+{
+    if (end <= begin)
+        return;
+
+    ScannerKind kind = detectScanner();
+    if (threads == 0)
+        threads = std::max(1u, std::thread::hardware_concurrency());
+
+    size_t chunk_count = (end - begin + CHUNK_SIZE - 1) / CHUNK_SIZE;
+    std::vector<std::vector<uint32_t>> chunk_positions(chunk_count);
+    std::vector<ScanStats> chunk_stats(chunk_count);
+
+    // Her thread sıradaki parçayı alır; parçalar kendi konum listesini doldurur
+    std::atomic<size_t> next_chunk(0);
+    auto worker = [&]()
+    {
+        for (size_t c = next_chunk++; c < chunk_count; c = next_chunk++)
+        {
+            size_t chunk_begin = begin + c * CHUNK_SIZE;
+            size_t chunk_end = std::min(end, chunk_begin + CHUNK_SIZE);
+            chunk_positions[c].reserve((chunk_end - chunk_begin) / 64);
+            scanNewlines(kind, data, chunk_begin, chunk_end, chunk_positions[c], chunk_stats[c]);
+        }
+    };
+
+    if (end - begin < PARALLEL_THRESHOLD || threads == 1 || chunk_count == 1)
+    {
+        worker();
+    }
+    else
+    {
+        std::vector<std::thread> pool;
+        unsigned pool_size = static_cast<unsigned>(std::min<size_t>(threads, chunk_count)) - 1;
+        for (unsigned t = 0; t < pool_size; t++)
+            pool.emplace_back(worker);
+        worker(); // çağıran thread de çalışır
+        for (std::thread &thread : pool)
+            thread.join();
+    }
+
+    // Parça sonuçlarını sırayla tek indekste birleştir
+    size_t total = 0;
+    for (const ScanStats &chunk : chunk_stats)
+        total += chunk.newlines;
+    index.reserve(index.size() + total);
+
+    for (size_t c = 0; c < chunk_count; c++)
+    {
+        size_t chunk_begin = begin + c * CHUNK_SIZE;
+        index.appendRelative(chunk_begin, chunk_positions[c].data(), chunk_positions[c].size());
+        std::vector<uint32_t>().swap(chunk_positions[c]);
+
+        stats.newlines += chunk_stats[c].newlines;
+        stats.crlf += chunk_stats[c].crlf;
+    }
+}
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "LineIndex.h"
+
+// Satır sonu tarayıcısı: '\n' konumlarını SIMD ile bulur, CRLF çiftlerini sayar.
+// Uygun komut seti çalışma zamanında seçilir (AVX2 > SSE2 > scalar).
+enum ScannerKind
+{
+    SCANNER_SCALAR,
+    SCANNER_SSE2,
+    SCANNER_AVX2
+};
+
+struct ScanStats
+{
+    size_t newlines; // '\n' sayısı
+    size_t crlf;     // '\r' ile önlenen '\n' sayısı
+
+    ScanStats() : newlines(0), crlf(0) {}
+
+    // Çoğunluk CRLF ise dosya CRLF kabul edilir
+    bool isCrlf() const { return newlines > 0 && crlf * 2 > newlines; }
+};
+
+ScannerKind detectScanner();
+bool scannerSupported(ScannerKind kind);
+const char *scannerName(ScannerKind kind);
+
+// [begin, end) içindeki '\n' konumlarını begin'e göre göreli olarak ekler (end - begin < 4 GB)
+void scanNewlines(ScannerKind kind, const char *data, size_t begin, size_t end,
+                  std::vector<uint32_t> &positions, ScanStats &stats);
+
+// [begin, end) aralığını indeksle ve mutlak konumları index'e ekle.
+// Büyük girdiler parçalara bölünüp çekirdekler arasında paralel taranır, sonuçlar sırayla birleştirilir.
+// threads = 0 ise donanım thread sayısı kullanılır.
+void indexLines(const char *data, size_t begin, size_t end, LineIndex &index, ScanStats &stats, unsigned threads = 0);
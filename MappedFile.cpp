@@ -0,0 +1,127 @@
+#include "MappedFile.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <cstdio>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#ifdef _WIN32
+
+std::shared_ptr<MappedFile> MappedFile::open(const std::string &path)
+{
+    // FILE_SHARE_DELETE: eşli dosya kaydederken kenara taşınabilsin
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+                              NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+    if (file == INVALID_HANDLE_VALUE)
+        return nullptr;
+
+    LARGE_INTEGER file_size;
+    if (!GetFileSizeEx(file, &file_size))
+    {
+        CloseHandle(file);
+        return nullptr;
+    }
+
+    std::shared_ptr<MappedFile> mapped(new MappedFile());
+    mapped->file_path = path;
+    mapped->length = static_cast<size_t>(file_size.QuadPart);
+
+    // Boş dosya eşlenemez, boş içerik olarak aç
+    if (mapped->length > 0)
+    {
+        HANDLE mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+        if (mapping)
+        {
+            mapped->view = static_cast<const char *>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+            CloseHandle(mapping); // view açık kaldıkça section yaşar
+        }
+        if (!mapped->view)
+        {
+            CloseHandle(file);
+            return nullptr;
+        }
+    }
+
+    CloseHandle(file);
+    return mapped;
+}
+
+MappedFile::~MappedFile()
+{
+    if (view)
+        UnmapViewOfFile(view);
+}
+
+bool MappedFile::replaceFile(const std::string &tmp_path, const std::string &target_path)
+{
+    if (MoveFileExA(tmp_path.c_str(), target_path.c_str(), MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH))
+        return true;
+
+    // Hedef hâlâ eşliyse üzerine yazılamaz: önce kenara taşı, sonra sil (eşleme kapanınca kalkar)
+    std::string aside = target_path + ".glitch-old";
+    DeleteFileA(aside.c_str());
+    if (!MoveFileExA(target_path.c_str(), aside.c_str(), MOVEFILE_REPLACE_EXISTING))
+        return false;
+    if (!MoveFileExA(tmp_path.c_str(), target_path.c_str(), MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH))
+    {
+        MoveFileExA(aside.c_str(), target_path.c_str(), MOVEFILE_REPLACE_EXISTING);
+        return false;
+    }
+    DeleteFileA(aside.c_str());
+    return true;
+}
+
+#else
+
+std::shared_ptr<MappedFile> MappedFile::open(const std::string &path)
+{
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+        return nullptr;
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || !S_ISREG(st.st_mode))
+    {
+        ::close(fd);
+        return nullptr;
+    }
+
+    std::shared_ptr<MappedFile> mapped(new MappedFile());
+    mapped->file_path = path;
+    mapped->length = static_cast<size_t>(st.st_size);
+
+    // Boş dosya eşlenemez, boş içerik olarak aç
+    if (mapped->length > 0)
+    {
+        void *view = mmap(nullptr, mapped->length, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (view == MAP_FAILED)
+        {
+            ::close(fd);
+            return nullptr;
+        }
+        madvise(view, mapped->length, MADV_SEQUENTIAL);
+        mapped->view = static_cast<const char *>(view);
+    }
+
+    ::close(fd); // eşleme fd kapansa da geçerli kalır
+    return mapped;
+}
+
+MappedFile::~MappedFile()
+{
+    if (view)
+        munmap(const_cast<char *>(view), length);
+}
+
+bool MappedFile::replaceFile(const std::string &tmp_path, const std::string &target_path)
+{
+    // rename atomiktir; eski inode eşli kaldığı sürece yaşamaya devam eder
+    return std::rename(tmp_path.c_str(), target_path.c_str()) == 0;
+}
+
+#endif
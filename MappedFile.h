@@ -0,0 +1,32 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <string>
+
+// Salt okunur bellek eşlemeli dosya (Linux'ta mmap, Windows'ta file mapping)
+// Dosya içeriği kopyalanmaz; sayfalar erişildikçe işletim sistemi tarafından yüklenir.
+class MappedFile
+{
+public:
+    ~MappedFile();
+    MappedFile(const MappedFile &) = delete;
+    MappedFile &operator=(const MappedFile &) = delete;
+
+    // Dosyayı eşle, başarısız olursa nullptr döner
+    static std::shared_ptr<MappedFile> open(const std::string &path);
+
+    const char *data() const { return view; }
+    size_t size() const { return length; }
+    const std::string &path() const { return file_path; }
+
+    // tmp dosyasını hedefin yerine koy (hedef hâlâ eşliyse bile)
+    static bool replaceFile(const std::string &tmp_path, const std::string &target_path);
+
+private:
+    MappedFile() : view(nullptr), length(0) {}
+
+    const char *view;
+    size_t length;
+    std::string file_path;
+};
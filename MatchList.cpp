@@ -0,0 +1,419 @@
+#include "MatchList.h"
+
+#include <algorithm>
+
+void EditMap::add(const TextChange &change)
+{
+    // Değişikliğe değen bölgeler [first, last) tek bölgede birleşir, sonrakiler kayar
+    size_t end = change.offset + change.removed;
+    size_t first = 0;
+    while (first < list.size() && list[first].end < change.offset)
+        first++;
+    size_t last = first;
+    while (last < list.size() && list[last].start <= end)
+        last++;
+
+    // Düzenlenmemiş konum önceki bölgenin sonuna göre anlık görüntüye taşınır
+    auto toSnapshot = [this](size_t offset, size_t before)
+    { return before == 0 ? offset : offset - list[before - 1].end + list[before - 1].snapshot_end; };
+
+    Region region{toSnapshot(change.offset, first), toSnapshot(end, last), change.offset, end};
+    if (first < last)
+    {
+        if (list[first].start <= change.offset)
+            region.snapshot_start = list[first].snapshot_start;
+        region.start = std::min(region.start, list[first].start);
+        if (list[last - 1].end >= end)
+            region.snapshot_end = list[last - 1].snapshot_end;
+        region.end = std::max(region.end, list[last - 1].end);
+    }
+    region.end = region.end - change.removed + change.inserted;
+
+    for (size_t i = last; i < list.size(); i++)
+    {
+        list[i].start = list[i].start - change.removed + change.inserted;
+        list[i].end = list[i].end - change.removed + change.inserted;
+    }
+    list.erase(list.begin() + first, list.begin() + last);
+    list.insert(list.begin() + first, region);
+}
+
+size_t EditMap::map(size_t offset, bool region_end) const
+{
+    auto after = std::upper_bound(list.begin(), list.end(), offset, [](size_t value, const Region &region)
+                                  { return value < region.snapshot_end; });
+    if (after != list.end() && after->snapshot_start < offset)
+        return region_end ? after->end : after->start;
+    if (after == list.begin())
+        return offset;
+    --after;
+    return offset - after->snapshot_end + after->end;
+}
+
+MatchList::MatchList() : nodes(1, Node{0, 0, 0, 0, 0, 0, 0}), root(0), seed(2463534242u)
+{
+}
+
+void MatchList::clear()
+{
+    std::vector<Node>(1, Node{0, 0, 0, 0, 0, 0, 0}).swap(nodes);
+    std::vector<uint32_t>().swap(free_nodes);
+    root = 0;
+}
+
+uint32_t MatchList::allocate(size_t gap, size_t length)
+{
+    // xorshift: düğüm öncelikleri ağacı beklenen O(log n) derinlikte tutar
+    seed ^= seed << 13;
+    seed ^= seed >> 17;
+    seed ^= seed << 5;
+    Node node{gap, gap + length, static_cast<uint32_t>(length), 1, 0, 0, seed};
+
+    if (!free_nodes.empty())
+    {
+        uint32_t index = free_nodes.back();
+        free_nodes.pop_back();
+        nodes[index] = node;
+        return index;
+    }
+    nodes.push_back(node);
+    return static_cast<uint32_t>(nodes.size() - 1);
+}
+
+void MatchList::release(uint32_t node)
+{
+    if (!node)
+        return;
+    release(nodes[node].left);
+    release(nodes[node].right);
+    free_nodes.push_back(node);
+}
+
+void MatchList::pull(uint32_t node)
+{
+    Node &n = nodes[node];
+    n.count = 1 + nodes[n.left].count + nodes[n.right].count;
+    n.span = nodes[n.left].span + n.gap + n.length + nodes[n.right].span;
+}
+
+uint32_t MatchList::merge(uint32_t left, uint32_t right)
+{
+    if (!left || !right)
+        return left ? left : right;
+    if (nodes[left].priority > nodes[right].priority)
+    {
+        nodes[left].right = merge(nodes[left].right, right);
+        pull(left);
+        return left;
+    }
+    nodes[right].left = merge(left, nodes[right].left);
+    pull(right);
+    return right;
+}
+
+void MatchList::split(uint32_t node, size_t base, size_t offset, uint32_t &left, uint32_t &right)
+{
+    if (!node)
+    {
+        left = right = 0;
+        return;
+    }
+
+    // Sağ alt ağaç bu eşleşmenin sonundan, sol alt ağaç base'den başlar
+    size_t start = base + nodes[nodes[node].left].span + nodes[node].gap;
+    if (start < offset)
+    {
+        split(nodes[node].right, start + nodes[node].length, offset, nodes[node].right, right);
+        left = node;
+    }
+    else
+    {
+        split(nodes[node].left, base, offset, left, nodes[node].left);
+        right = node;
+    }
+    pull(node);
+}
+
+void MatchList::addGap(uint32_t node, size_t delta)
+{
+    // İlk eşleşmenin gap'i değişince arkasındaki her şey kayar (delta taşmalı çıkarma da olabilir)
+    if (!node)
+        return;
+    if (nodes[node].left)
+        addGap(nodes[node].left, delta);
+    else
+        nodes[node].gap += delta;
+    pull(node);
+}
+
+uint32_t MatchList::build(const std::vector<SearchMatch> &matches, size_t base)
+{
+    // Sıralı girdiden O(k) treap: sağ kenar yığında tutulur
+    std::vector<uint32_t> spine;
+    size_t previous = base;
+    for (const SearchMatch &match : matches)
+    {
+        uint32_t node = allocate(match.start - previous, match.end - match.start);
+        previous = match.end;
+
+        uint32_t last = 0;
+        while (!spine.empty() && nodes[spine.back()].priority < nodes[node].priority)
+        {
+            last = spine.back();
+            spine.pop_back();
+            pull(last);
+        }
+        nodes[node].left = last;
+        if (!spine.empty())
+            nodes[spine.back()].right = node;
+        spine.push_back(node);
+    }
+    for (size_t i = spine.size(); i-- > 0;)
+        pull(spine[i]);
+    return spine.empty() ? 0 : spine.front();
+}
+
+bool MatchList::lowerBound(size_t offset, SearchMatch &match, size_t &index) const
+{
+    bool found = false;
+    uint32_t node = root;
+    size_t base = 0, before = 0;
+    while (node)
+    {
+        const Node &n = nodes[node];
+        size_t start = base + nodes[n.left].span + n.gap;
+        if (start >= offset)
+        {
+            found = true;
+            match = SearchMatch{start, start + n.length};
+            index = before + nodes[n.left].count;
+            node = n.left;
+        }
+        else
+        {
+            before += nodes[n.left].count + 1;
+            base = start + n.length;
+            node = n.right;
+        }
+    }
+    return found;
+}
+
+bool MatchList::at(size_t index, SearchMatch &match) const
+{
+    uint32_t node = root;
+    size_t base = 0;
+    while (node)
+    {
+        const Node &n = nodes[node];
+        size_t left_count = nodes[n.left].count;
+        size_t start = base + nodes[n.left].span + n.gap;
+        if (index < left_count)
+        {
+            node = n.left;
+        }
+        else if (index == left_count)
+        {
+            match = SearchMatch{start, start + n.length};
+            return true;
+        }
+        else
+        {
+            index -= left_count + 1;
+            base = start + n.length;
+            node = n.right;
+        }
+    }
+    return false;
+}
+
+void MatchList::collect(size_t from, size_t to, std::vector<SearchMatch> &out) const
+{
+    collect(root, 0, from, to, out);
+}
+
+void MatchList::collect(uint32_t node, size_t base, size_t from, size_t to, std::vector<SearchMatch> &out) const
+{
+    if (!node)
+        return;
+
+    // Sol alt ağaç [base, start - gap) içinde biter, sağ alt ağaç end'den başlar
+    const Node &n = nodes[node];
+    size_t start = base + nodes[n.left].span + n.gap;
+    size_t end = start + n.length;
+    if (start - n.gap > from && base < to)
+        collect(n.left, base, from, to, out);
+    if (start < to && end > from)
+        out.push_back(SearchMatch{start, end});
+    if (end < to)
+        collect(n.right, end, from, to, out);
+}
+
+bool MatchList::covering(size_t offset, SearchMatch &match) const
+{
+    size_t index = size();
+    SearchMatch next;
+    lowerBound(offset, next, index);
+    return index > 0 && at(index - 1, match) && match.end > offset;
+}
+
+void MatchList::erase(size_t from, size_t to, size_t delta)
+{
+    uint32_t before = 0, removed = 0, after = 0, rest = 0;
+    split(root, 0, from, before, rest);
+    split(rest, nodes[before].span, to, removed, after);
+    addGap(after, nodes[removed].span + delta);
+    release(removed);
+    root = merge(before, after);
+}
+
+void MatchList::replace(size_t from, size_t to, const std::vector<SearchMatch> &matches)
+{
+    // Aralığın başını kesen ya da yeni eşleşmelerle çakışan eski eşleşmeler de gider
+    SearchMatch cut;
+    if (covering(from, cut))
+        from = cut.start;
+    if (!matches.empty())
+        to = std::max(to, matches.back().end);
+    erase(from, to, 0);
+    if (matches.empty())
+        return;
+
+    uint32_t before = 0, after = 0;
+    split(root, 0, from, before, after);
+    uint32_t added = build(matches, nodes[before].span);
+    addGap(after, 0 - nodes[added].span);
+    root = merge(merge(before, added), after);
+}
+
+void MatchList::update(const TextDocument &document, SearchQuery &query, const std::vector<TextChange> &changes)
+{
+    // Önce tüm değişiklikler kaydırılır; yeniden taranacak bölgeler her değişiklikte yeni konumlarına taşınır
+    std::vector<SearchMatch> dirty;
+    for (const TextChange &change : changes)
+    {
+        size_t removed_end = change.offset + change.removed;
+        size_t inserted_end = change.offset + change.inserted;
+        for (SearchMatch &region : dirty)
+        {
+            region.start = region.start < change.offset ? region.start
+                           : region.start >= removed_end ? region.start - change.removed + change.inserted
+                                                         : change.offset;
+            region.end = region.end < change.offset ? region.end
+                         : region.end >= removed_end ? region.end - change.removed + change.inserted
+                                                     : inserted_end;
+        }
+
+        // Silinen bölgede başlayan ya da düzenleme noktasını kesen eşleşmeler gider, sonrakiler kayar.
+        // Giden eşleşmelerin kapladığı yer de taranır; eski ayrıştırmanın orada ne bulduğu artık bilinmez
+        SearchMatch cut;
+        size_t from = covering(change.offset, cut) ? cut.start : change.offset;
+        size_t to = covering(removed_end, cut) ? cut.end - change.removed + change.inserted : inserted_end;
+        erase(from, removed_end, change.inserted - change.removed);
+        dirty.push_back(SearchMatch{from, std::max(to, inserted_end)});
+
+        // Bölgeler sıralı ve ayrık tutulur
+        std::sort(dirty.begin(), dirty.end(), [](const SearchMatch &a, const SearchMatch &b)
+                  { return a.start < b.start; });
+        size_t kept = 0;
+        for (size_t i = 1; i < dirty.size(); i++)
+        {
+            if (dirty[i].start <= dirty[kept].end)
+                dirty[kept].end = std::max(dirty[kept].end, dirty[i].end);
+            else
+                dirty[++kept] = dirty[i];
+        }
+        dirty.resize(kept + 1);
+    }
+
+    if (!query.valid())
+        return;
+    for (const SearchMatch &region : dirty)
+        rescan(document, query, region.start, region.end);
+}
+
+void MatchList::merge(const TextDocument &document, SearchQuery &query, size_t from, size_t to,
+                      const std::vector<SearchMatch> &matches, const EditMap &edits)
+{
+    if (edits.empty())
+    {
+        replace(from, to, matches);
+        return;
+    }
+
+    // Bölgelerle eşleşmeler aynı sırada ilerler; bölgeye değmeyen eşleşme önceki bölgenin kaydırmasıyla taşınır.
+    // Bölgeye değen eşleşme atılır, kapladığı yer yeniden taranacak bölgelere eklenir (update'teki gibi)
+    const std::vector<EditMap::Region> &regions = edits.regions();
+    std::vector<SearchMatch> moved;
+    std::vector<SearchMatch> dirty;
+    moved.reserve(matches.size());
+    size_t next = 0;
+    for (const SearchMatch &match : matches)
+    {
+        while (next < regions.size() && regions[next].snapshot_end <= match.start)
+            next++;
+        if (next < regions.size() && match.start < regions[next].snapshot_end && match.end > regions[next].snapshot_start)
+        {
+            dirty.push_back(SearchMatch{edits.map(match.start, false), edits.map(match.end, true)});
+            continue;
+        }
+        size_t start = edits.map(match.start, false);
+        moved.push_back(SearchMatch{start, start + (match.end - match.start)});
+    }
+
+    size_t mapped_from = edits.map(from, false);
+    size_t mapped_to = edits.map(to, true);
+    replace(mapped_from, mapped_to, moved);
+    if (!query.valid())
+        return;
+
+    // Aralığa değen düzenlenmiş bölgeler son hal üzerinde yeniden taranır. Aralığın başı da taranır:
+    // önündeki eşleşmeler düzenlemelerden sonra bulunmuştur, ayrıştırma oradan kayabilir
+    dirty.push_back(SearchMatch{mapped_from, mapped_from});
+    for (const EditMap::Region &region : regions)
+    {
+        if (region.start <= mapped_to && region.end >= mapped_from)
+            dirty.push_back(SearchMatch{region.start, region.end});
+    }
+    std::sort(dirty.begin(), dirty.end(), [](const SearchMatch &a, const SearchMatch &b)
+              { return a.start < b.start; });
+    size_t kept = 0;
+    for (size_t i = 1; i < dirty.size(); i++)
+    {
+        if (dirty[i].start <= dirty[kept].end)
+            dirty[kept].end = std::max(dirty[kept].end, dirty[i].end);
+        else
+            dirty[++kept] = dirty[i];
+    }
+    dirty.resize(kept + 1);
+    for (const SearchMatch &region : dirty)
+        rescan(document, query, region.start, region.end);
+}
+
+void MatchList::rescan(const TextDocument &document, SearchQuery &query, size_t from, size_t to)
+{
+    // Bölgeden önce başlayıp içine uzanabilecek eşleşmeler ve hemen sonrasındaki eşleşme de taranır
+    // (düzenli ifadede \b ve ^ bir önceki karaktere bakar)
+    SearchMatch cut;
+    from -= std::min(from, query.reach());
+    if (covering(from, cut))
+        from = cut.start;
+    to = std::min(document.length(), to + 1);
+
+    std::vector<SearchMatch> found;
+    while (from < to)
+    {
+        found.clear();
+        query.findAll(document, from, to, found);
+        size_t end = found.empty() ? to : std::max(to, found.back().end);
+
+        // Yeni tarama eski bir eşleşmenin ortasında bittiyse eski ayrıştırma oradan itibaren geçersiz,
+        // tarama eski eşleşmelerle hizalanana kadar sürer
+        bool overrun = covering(end, cut);
+        replace(from, end, found);
+        if (!overrun)
+            break;
+        from = end;
+        to = cut.end;
+    }
+}
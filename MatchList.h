@@ -0,0 +1,100 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "SearchWorker.h"
+
+// Arka plan taraması sürerken belgeye uygulanan değişikliklerin birleşik hali.
+// Anlık görüntüdeki konumları belgenin son haline taşır; düzenlenen bölgeler iki konum sisteminde de
+// sıralı ve ayrık tutulur (birbirine değen değişiklikler tek bölgede birleşir).
+class EditMap
+{
+public:
+    struct Region
+    {
+        size_t snapshot_start, snapshot_end; // anlık görüntüde değişen aralık
+        size_t start, end;                   // belgenin son halindeki karşılığı
+    };
+
+    void clear() { list.clear(); }
+    bool empty() const { return list.empty(); }
+    const std::vector<Region> &regions() const { return list; }
+
+    // Belgeye sırayla uygulanan değişiklik (konumlar değişiklik anındaki belgeye göre)
+    void add(const TextChange &change);
+    // Anlık görüntüdeki offset'in son haldeki karşılığı; düzenlenen bölgenin içindeyse bölgenin başı ya da sonu
+    size_t map(size_t offset, bool region_end) const;
+
+private:
+    std::vector<Region> list;
+};
+
+// Belgedeki arama eşleşmelerinin düzenlemelerle birlikte güncellenen sıralı listesi
+// - Eşleşmeler bir treap'te tutulur; her düğüm mutlak konum yerine önceki eşleşmenin sonundan
+//   uzaklığını (gap) saklar, alt ağaç toplamları konumu verir (Rope'taki byte sayıları gibi)
+// - Düzenlemeden sonraki tüm eşleşmeleri kaydırmak tek bir gap değişikliğidir: O(log n)
+// - Düzenlenen bölge yeniden taranır, tarama eski eşleşmelerle hizalanana kadar sürer
+// - Sıra/konum aramaları (sonraki eşleşme, "3 of 120", görünür satırlar) O(log n)
+// Eşleşmeler çakışmaz ve boş değildir; başları da sonları da sıralıdır.
+class MatchList
+{
+public:
+    MatchList();
+
+    size_t size() const { return nodes[root].count; }
+    bool empty() const { return root == 0; }
+    void clear();
+
+    // [from, to) içinde başlayan eşleşmeleri matches ile değiştirir (sıralı, hepsi aralıkta başlamalı)
+    void replace(size_t from, size_t to, const std::vector<SearchMatch> &matches);
+
+    // Belgeye sırayla uygulanan değişiklikleri yansıtır: eşleşmeler kaydırılır, etkilenen bölgeler
+    // document (son hali) üzerinde query ile yeniden taranır
+    void update(const TextDocument &document, SearchQuery &query, const std::vector<TextChange> &changes);
+
+    // Anlık görüntünün [from, to) taramasını (matches) belgenin son haline taşıyıp replace gibi yerleştirir.
+    // Düzenlenen bölgelere değen eşleşmeler atılır, o bölgeler document üzerinde yeniden taranır
+    void merge(const TextDocument &document, SearchQuery &query, size_t from, size_t to,
+               const std::vector<SearchMatch> &matches, const EditMap &edits);
+
+    // offset'te ya da sonrasında başlayan ilk eşleşme ve sırası
+    bool lowerBound(size_t offset, SearchMatch &match, size_t &index) const;
+    bool at(size_t index, SearchMatch &match) const;
+    // [from, to) ile kesişen eşleşmeler, belge sırasında
+    void collect(size_t from, size_t to, std::vector<SearchMatch> &out) const;
+
+    size_t memoryUsage() const { return nodes.capacity() * sizeof(Node); }
+
+private:
+    struct Node
+    {
+        size_t gap;  // önceki eşleşmenin sonundan (ya da alt ağacın başından) bu eşleşmenin başına
+        size_t span; // alt ağaçtaki gap + uzunluk toplamı
+        uint32_t length;
+        uint32_t count;
+        uint32_t left, right; // 0: yok
+        uint32_t priority;
+    };
+
+    std::vector<Node> nodes; // nodes[0] boş düğüm
+    std::vector<uint32_t> free_nodes;
+    uint32_t root;
+    uint32_t seed;
+
+    uint32_t allocate(size_t gap, size_t length);
+    void release(uint32_t node);
+    void pull(uint32_t node);
+    uint32_t merge(uint32_t left, uint32_t right);
+    // base: alt ağacın başladığı mutlak konum; başı offset'ten küçük olanlar left'e gider
+    void split(uint32_t node, size_t base, size_t offset, uint32_t &left, uint32_t &right);
+    void addGap(uint32_t node, size_t delta);
+    uint32_t build(const std::vector<SearchMatch> &matches, size_t base);
+    void collect(uint32_t node, size_t base, size_t from, size_t to, std::vector<SearchMatch> &out) const;
+
+    // offset'i içine alan (başı önce, sonu sonra) eşleşme
+    bool covering(size_t offset, SearchMatch &match) const;
+    // [from, to) içinde başlayanları siler, sonrakileri delta kadar kaydırır (taşmalı toplama)
+    void erase(size_t from, size_t to, size_t delta);
+    void rescan(const TextDocument &document, SearchQuery &query, size_t from, size_t to);
+};
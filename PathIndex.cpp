@@ -0,0 +1,569 @@
+#include "PathIndex.h"
+
+#include <algorithm>
+#include "LineScanner.h"
+#include "WorkspaceWalk.h"
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define GLITCH_X86 1
+#include <immintrin.h>
+#endif
+
+namespace
+{
+    // Bundan uzun yollar listeye alınmaz (konumlar 16 bit)
+    const size_t MAX_PATH_LENGTH = 4096;
+    // Buffer sonunda 16 byte'lık SIMD okuması taşmasın
+    const size_t BLOB_PADDING = 16;
+    // Bundan az aday tek thread'de taranır (thread başlatma maliyeti kazancı yemesin)
+    const size_t PARALLEL_THRESHOLD = 64 * 1024;
+    // Dosya adındaki eşleşmesi henüz aranmamış yol (sadece puanlanacak yollarda aranır)
+    const uint16_t UNKNOWN_END = 0xFFFF;
+
+    // Puanlama (fzf benzeri): eşleşen karakter, kelime başı, ardışıklık ve boşluk cezası
+    const int SCORE_MATCH = 16;
+    const int BONUS_SEPARATOR = 10; // '/' sonrası
+    const int BONUS_BOUNDARY = 8;   // '_', '-', '.', ' ' sonrası ya da yol başı
+    const int BONUS_CAMEL = 7;      // küçük harften sonra büyük harf
+    const int BONUS_CONSECUTIVE = 6;
+    const int BONUS_NAME = 2; // dosya adı içinde
+    const int PENALTY_GAP_START = 3;
+    const int PENALTY_GAP_EXTENSION = 1;
+
+    const size_t npos = static_cast<size_t>(-1);
+
+    struct FoldTable
+    {
+        unsigned char map[256];
+        FoldTable()
+        {
+            for (int i = 0; i < 256; i++)
+                map[i] = static_cast<unsigned char>(i >= 'A' && i <= 'Z' ? i + 32 : i);
+        }
+    };
+    const FoldTable FOLD;
+
+    inline unsigned char lower(unsigned char ch)
+    {
+        return FOLD.map[ch];
+    }
+
+    // Harf ve rakamların kendi biti var, diğer byte'lar kalan 28 bite dağıtılır
+    inline uint64_t charBit(unsigned char ch)
+    {
+        ch = lower(ch);
+        if (ch >= 'a' && ch <= 'z')
+            return 1ULL << (ch - 'a');
+        if (ch >= '0' && ch <= '9')
+            return 1ULL << (26 + ch - '0');
+        return 1ULL << (36 + ch % 28);
+    }
+
+    inline unsigned countTrailingZeros(uint32_t mask)
+    {
+#ifdef _MSC_VER
+        unsigned long index;
+        _BitScanForward(&index, mask);
+        return index;
+#else
+        return __builtin_ctz(mask);
+#endif
+    }
+
+    // path[pos, length) içinde katlanmış ch'nin (küçük harf) ilk konumu
+    inline size_t findFolded(bool simd, const char *path, size_t pos, size_t length, unsigned char ch)
+    {
+#ifdef GLITCH_X86
+        if (simd)
+        {
+            // Harflerde 0x20 biti zorlanır: ('A' | 0x20) == 'a'; harf olmayan hiçbir byte böyle harfe dönüşmez
+            const __m128i needle = _mm_set1_epi8(static_cast<char>(ch));
+            const __m128i case_bit = _mm_set1_epi8(ch >= 'a' && ch <= 'z' ? 0x20 : 0);
+            for (; pos < length; pos += 16)
+            {
+                __m128i block = _mm_or_si128(_mm_loadu_si128(reinterpret_cast<const __m128i *>(path + pos)), case_bit);
+                uint32_t mask = static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(block, needle)));
+                if (length - pos < 16)
+                    mask &= (1u << (length - pos)) - 1; // yolun sonrası (sonraki yol ya da dolgu)
+                if (mask)
+                    return pos + countTrailingZeros(mask);
+            }
+            return npos;
+        }
+#else
+        (void)simd;
+#endif
+        for (; pos < length; pos++)
+        {
+            if (lower(static_cast<unsigned char>(path[pos])) == ch)
+                return pos;
+        }
+        return npos;
+    }
+
+    // Desen path[from, length) içinde alt dizi mi; öyleyse son eşleşmenin sonrası end'e yazılır
+    inline bool matchForward(bool simd, const char *path, size_t from, size_t length, const std::string &pattern,
+                             size_t &end)
+    {
+        size_t pos = from;
+        for (unsigned char ch : pattern)
+        {
+            pos = findFolded(simd, path, pos, length, ch);
+            if (pos == npos)
+                return false;
+            pos++;
+        }
+        end = pos;
+        return true;
+    }
+
+    int boundaryBonus(const char *path, size_t i)
+    {
+        if (i == 0)
+            return BONUS_BOUNDARY;
+        unsigned char prev = static_cast<unsigned char>(path[i - 1]);
+        unsigned char cur = static_cast<unsigned char>(path[i]);
+        if (prev == '/')
+            return BONUS_SEPARATOR;
+        if (prev == '_' || prev == '-' || prev == '.' || prev == ' ')
+            return BONUS_BOUNDARY;
+        if (prev >= 'a' && prev <= 'z' && cur >= 'A' && cur <= 'Z')
+            return BONUS_CAMEL;
+        return 0;
+    }
+
+    // Eşleşmenin bittiği yerden geriye en kısa pencereyi bulur, pencerede açgözlü eşleyip puanlar
+    int scoreMatch(const char *path, size_t end, size_t name_start, const std::string &pattern,
+                   std::vector<uint16_t> *positions, size_t &start)
+    {
+        start = end;
+        for (size_t j = pattern.size(); j-- > 0;)
+        {
+            while (lower(static_cast<unsigned char>(path[--start])) != static_cast<unsigned char>(pattern[j]))
+            {
+            }
+        }
+
+        int score = 0;
+        size_t pos = start, prev = npos;
+        for (unsigned char ch : pattern)
+        {
+            while (lower(static_cast<unsigned char>(path[pos])) != ch)
+                pos++;
+            score += SCORE_MATCH + boundaryBonus(path, pos);
+            if (prev != npos)
+            {
+                if (pos == prev + 1)
+                    score += BONUS_CONSECUTIVE;
+                else
+                    score -= PENALTY_GAP_START + PENALTY_GAP_EXTENSION * static_cast<int>(pos - prev - 2);
+            }
+            if (pos >= name_start)
+                score += BONUS_NAME;
+            if (positions)
+                positions->push_back(static_cast<uint16_t>(pos));
+            prev = pos++;
+        }
+        return score;
+    }
+
+    struct Candidate
+    {
+        int score;
+        uint32_t length;
+        uint32_t id;
+    };
+
+    // Yüksek puan, eşitse kısa yol, eşitse alfabetik önce
+    inline bool better(const Candidate &a, const Candidate &b)
+    {
+        if (a.score != b.score)
+            return a.score > b.score;
+        if (a.length != b.length)
+            return a.length < b.length;
+        return a.id < b.id;
+    }
+
+    struct Matcher
+    {
+        bool simd;
+        const char *blob;
+        const uint32_t *offsets;
+        const uint16_t *names;
+        const std::string &pattern;
+
+        // Desenin yolda açgözlü eşleşmesinin bittiği yer. Açgözlü eşleşme önekten bağımsızdır:
+        // uzayan desen önceki eşleşmenin bittiği from'dan sadece tail ile devam eder.
+        bool locate(uint32_t id, size_t from, const std::string &tail, size_t &end) const
+        {
+            return matchForward(simd, blob + offsets[id], from, offsets[id + 1] - offsets[id], tail, end);
+        }
+
+        // Aynısı dosya adında (from adın başı ya da önceki eşleşmenin sonu); eşleşmiyorsa 0
+        size_t locateName(uint32_t id, size_t from, const std::string &tail) const
+        {
+            size_t end = 0;
+            if (names[id] == 0 || from == 0 || pattern.empty() ||
+                !matchForward(simd, blob + offsets[id], from, offsets[id + 1] - offsets[id], tail, end))
+                return 0;
+            return end;
+        }
+
+        // locate ve locateName'in bulduğu eşleşmenin puanı; positions verilirse puanlanan pencerenin konumları yazılır
+        int rank(uint32_t id, size_t end, size_t name_end, std::vector<uint16_t> *positions) const
+        {
+            if (pattern.empty())
+                return 0;
+            const char *path = blob + offsets[id];
+            size_t name = names[id];
+            size_t start = 0, name_start = 0;
+            int score = scoreMatch(path, end, name, pattern, nullptr, start);
+
+            // Pencere dosya adından önce başlıyorsa sadece adın içindeki eşleşme de puanlanır
+            // (src/main/x/main.cpp'de "main" gibi); pencere adın içindeyse ikisi aynıdır
+            int name_score = 0;
+            bool in_name = start < name && name_end > 0 &&
+                           (name_score = scoreMatch(path, name_end, name, pattern, nullptr, name_start)) > score;
+            if (in_name)
+                score = name_score;
+            if (positions)
+                scoreMatch(path, in_name ? name_end : end, name, pattern, positions, start);
+            return score;
+        }
+    };
+
+    struct Partial
+    {
+        std::vector<uint32_t> matched;   // id sırasında
+        std::vector<uint16_t> ends;      // açgözlü eşleşmenin yolda bittiği yer
+        std::vector<uint16_t> name_ends; // dosya adında bittiği yer (eşleşmiyorsa 0, aranmadıysa UNKNOWN_END)
+        std::vector<Candidate> heap;     // parçanın en iyi sonuçları, tepe en kötü sonuç
+    };
+
+    void offer(std::vector<Candidate> &heap, size_t limit, const Candidate &candidate)
+    {
+        if (heap.size() < limit)
+        {
+            heap.push_back(candidate);
+            std::push_heap(heap.begin(), heap.end(), better);
+        }
+        else if (better(candidate, heap.front()))
+        {
+            std::pop_heap(heap.begin(), heap.end(), better);
+            heap.back() = candidate;
+            std::push_heap(heap.begin(), heap.end(), better);
+        }
+    }
+}
+
+PathIndex::PathIndex(const std::string &root) : refresh_running(false), cancelled(false)
+{
+    root_path = workspaceRoot(root);
+}
+
+PathIndex::~PathIndex()
+{
+    cancelled = true;
+    if (refresher.joinable())
+        refresher.join();
+}
+
+size_t PathIndex::size()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return current ? current->names.size() : 0;
+}
+
+void PathIndex::assign(std::vector<std::string> paths)
+{
+    std::sort(paths.begin(), paths.end());
+
+    std::shared_ptr<Snapshot> snapshot = std::make_shared<Snapshot>();
+    size_t total = 0;
+    for (const std::string &path : paths)
+        total += path.size();
+    snapshot->blob.reserve(total + BLOB_PADDING);
+    snapshot->offsets.reserve(paths.size() + 1);
+    snapshot->names.reserve(paths.size());
+    snapshot->charsets.reserve(paths.size());
+    snapshot->bonus_sets.reserve(paths.size());
+
+    for (const std::string &path : paths)
+    {
+        if (path.empty() || path.size() > MAX_PATH_LENGTH)
+            continue;
+        // Puan üst sınırı için: kelime başında, camelCase tümseğinde ve dosya adında geçen karakterler
+        size_t slash = path.rfind('/');
+        size_t name = slash == std::string::npos ? 0 : slash + 1;
+        uint64_t charset = 0, boundary = 0, hump = 0, name_chars = 0, name_bonus = 0;
+        for (size_t i = 0; i < path.size(); i++)
+        {
+            uint64_t bit = charBit(static_cast<unsigned char>(path[i]));
+            charset |= bit;
+            int bonus = boundaryBonus(path.data(), i);
+            if (bonus == BONUS_CAMEL)
+                hump |= bit;
+            else if (bonus > 0)
+                boundary |= bit;
+            if (i >= name)
+                name_chars |= bit;
+            if (i >= name && bonus > 0)
+                name_bonus |= bit;
+        }
+        snapshot->offsets.push_back(static_cast<uint32_t>(snapshot->blob.size()));
+        snapshot->names.push_back(static_cast<uint16_t>(name));
+        snapshot->charsets.push_back(charset);
+        snapshot->bonus_sets.push_back({boundary, hump, name_chars, name_bonus});
+        snapshot->blob += path;
+    }
+    snapshot->offsets.push_back(static_cast<uint32_t>(snapshot->blob.size()));
+    snapshot->blob.append(BLOB_PADDING, '\0');
+
+    std::lock_guard<std::mutex> lock(mutex);
+    current = std::move(snapshot);
+}
+
+void PathIndex::startRefresh(std::function<void()> on_done)
+{
+    if (refresh_running)
+        return;
+    if (refresher.joinable())
+        refresher.join();
+    cancelled = false;
+    refresh_running = true;
+    refresher = std::thread(&PathIndex::refresh, this, std::move(on_done));
+}
+
+void PathIndex::refresh(std::function<void()> on_done)
+{
+    std::vector<std::string> paths;
+    // Sürücü ya da dosya sistemi kökü (C:\, /) zaten ayırıcıyla biter
+    size_t prefix = root_path.size();
+    if (prefix > 0 && root_path.back() != '/' && root_path.back() != '\\')
+        prefix++;
+    walkWorkspace(root_path, cancelled, [&paths, prefix](const std::filesystem::directory_entry &entry)
+                  {
+                      std::string path = entry.path().string();
+                      if (path.size() <= prefix)
+                          return;
+                      path.erase(0, prefix);
+#ifdef _WIN32
+                      std::replace(path.begin(), path.end(), '\\', '/');
+#endif
+                      paths.push_back(std::move(path)); });
+
+    if (!cancelled)
+        assign(std::move(paths));
+    refresh_running = false;
+    if (on_done && !cancelled)
+        on_done();
+}
+
+size_t PathIndex::query(const std::string &text, size_t limit, std::vector<PathMatch> &out)
+{
+    std::shared_ptr<const Snapshot> snapshot;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        snapshot = current;
+    }
+    if (!snapshot || limit == 0)
+        return 0;
+
+    std::string pattern;
+    uint64_t wanted = 0;
+    for (char ch : text)
+    {
+        if (ch == ' ')
+            continue; // boşluk parçaları ayırmak için yazılır, yollarda aranmaz
+        pattern += static_cast<char>(lower(static_cast<unsigned char>(ch)));
+        wanted |= charBit(static_cast<unsigned char>(ch));
+    }
+
+    static const bool simd = detectScanner() != SCANNER_SCALAR;
+    Matcher matcher{simd, snapshot->blob.data(), snapshot->offsets.data(), snapshot->names.data(), pattern};
+    const uint64_t *charsets = snapshot->charsets.data();
+    const Snapshot::BonusSets *bonus_sets = snapshot->bonus_sets.data();
+
+    // Önceki desenin uzantısıysa sadece onun eşleşmeleri aday olabilir; açgözlü eşleşme önekten
+    // bağımsız olduğu için her yolda önceki eşleşmenin bittiği yerden sadece yeni karakterler aranır
+    bool narrowing = snapshot == cached_snapshot && !cached_pattern.empty() &&
+                     pattern.compare(0, cached_pattern.size(), cached_pattern) == 0;
+    size_t items = narrowing ? cached_ids.size() : snapshot->names.size();
+    std::string tail = narrowing ? pattern.substr(cached_pattern.size()) : pattern;
+
+    // Puan üst sınırı: desen karakterinin katkısı, yolda o karakterin kelime başında (10), camelCase
+    // tümseğinde (7) ya da dosya adında (+2) geçip geçmediğine bağlıdır. Ardışık karakter +6 alır ama
+    // bonusu önceki desen karakterine bağlıdır ('/' ve '_' gibi sonrası kelime başı, küçük harf sonrası
+    // tümsek); ardışık olmayan en iyi konumdaki bonustan boşluk cezasını kaybeder.
+    // contribution[j * 8 + üyelik] (üyelik: 1 kelime başı, 2 tümsek, 4 dosya adı)
+    std::vector<uint64_t> bits(pattern.size());
+    std::vector<int> contribution(pattern.size() * 8);
+    for (size_t j = 0; j < pattern.size(); j++)
+    {
+        unsigned char ch = static_cast<unsigned char>(pattern[j]);
+        unsigned char prev = j > 0 ? static_cast<unsigned char>(pattern[j - 1]) : 0;
+        bits[j] = charBit(ch);
+        bool after_boundary = prev == '/' || prev == '_' || prev == '-' || prev == '.' || prev == ' ';
+        bool after_letter = prev >= 'a' && prev <= 'z' && ch >= 'a' && ch <= 'z';
+        for (int membership = 0; membership < 8; membership++)
+        {
+            bool boundary = membership & 1, hump = membership & 2, name = membership & 4;
+            int bonus = boundary ? BONUS_SEPARATOR : hump ? BONUS_CAMEL : 0;
+            int value = SCORE_MATCH + bonus;
+            if (j > 0)
+            {
+                int consecutive_bonus = after_boundary && boundary ? BONUS_SEPARATOR
+                                                                   : after_letter && hump ? BONUS_CAMEL : 0;
+                value = std::max(value - PENALTY_GAP_START, SCORE_MATCH + BONUS_CONSECUTIVE + consecutive_bonus);
+            }
+            contribution[j * 8 + membership] = value + (name ? BONUS_NAME : 0);
+        }
+    }
+    int best_possible = 0;
+    for (size_t j = 0; j < pattern.size(); j++)
+        best_possible += contribution[j * 8 + 7];
+
+    auto setBound = [&](uint32_t id, size_t count, bool in_name)
+    {
+        const Snapshot::BonusSets &sets = bonus_sets[id];
+        uint64_t name_chars = in_name ? sets.name : 0;
+        int bound = 0;
+        for (size_t j = 0; j < count; j++)
+        {
+            int membership = ((sets.boundary & bits[j]) ? 1 : 0) | ((sets.hump & bits[j]) ? 2 : 0) |
+                             ((name_chars & bits[j]) ? 4 : 0);
+            bound += contribution[j * 8 + membership];
+        }
+        return bound;
+    };
+
+    // Daha sıkı sınır: puanlanan pencerenin son karakteri açgözlü eşleşmenin son karakteridir (pos), onun
+    // katkısı yoldan doğrudan okunur. Diğer karakterler pos dosya adının içindeyse adda olabilir.
+    auto alignmentBound = [&](uint32_t id, size_t pos, bool in_name)
+    {
+        const char *path = matcher.blob + matcher.offsets[id];
+        size_t last = pattern.size() - 1;
+        int value = SCORE_MATCH + boundaryBonus(path, pos);
+        if (last > 0)
+        {
+            bool consecutive = lower(static_cast<unsigned char>(path[pos - 1])) ==
+                               static_cast<unsigned char>(pattern[last - 1]);
+            value += consecutive ? BONUS_CONSECUTIVE : -PENALTY_GAP_START;
+        }
+        return setBound(id, last, in_name) + value + (pos >= matcher.names[id] ? BONUS_NAME : 0);
+    };
+
+    // Dosya adındaki pencerenin sınırı, eşleşmesi aranmadan: son karakter adda kelime başında ya da
+    // tümsekte geçmiyorsa bonus alamaz
+    auto nameBound = [&](uint32_t id)
+    {
+        if (matcher.names[id] == 0)
+            return 0;
+        size_t last = pattern.size() - 1;
+        int value = SCORE_MATCH + ((bonus_sets[id].name_bonus & bits[last]) ? BONUS_SEPARATOR : 0) +
+                    (last > 0 ? BONUS_CONSECUTIVE : 0) + BONUS_NAME;
+        return setBound(id, last, true) + value;
+    };
+
+    // Eşleme SIMD ile yapılır; puanlama tembeldir: heap dolduktan sonra bir yol önce karakter kümelerinden,
+    // sonra yoldan okunan sınırla heap'in en kötüsünü geçebilir mi diye bakılır, sadece geçebilenler puanlanır.
+    // Dosya adındaki eşleşme de sadece bu yollarda aranır.
+    auto scan = [&](size_t begin, size_t end, Partial &partial)
+    {
+        for (size_t i = begin; i < end; i++)
+        {
+            uint32_t id = narrowing ? cached_ids[i] : static_cast<uint32_t>(i);
+            if ((charsets[id] & wanted) != wanted)
+                continue;
+            size_t match_end = 0;
+            if (!matcher.locate(id, narrowing ? cached_ends[i] : 0, tail, match_end))
+                continue;
+            uint16_t name_end = UNKNOWN_END;
+            if (narrowing && cached_name_ends[i] != UNKNOWN_END)
+                name_end = static_cast<uint16_t>(matcher.locateName(id, cached_name_ends[i], tail));
+            partial.matched.push_back(id);
+            partial.ends.push_back(static_cast<uint16_t>(match_end));
+            partial.name_ends.push_back(name_end);
+
+            uint32_t length = matcher.offsets[id + 1] - matcher.offsets[id];
+            bool full = partial.heap.size() == limit;
+            if (full && (!better(Candidate{best_possible, length, id}, partial.heap.front()) ||
+                         !better(Candidate{setBound(id, pattern.size(), true), length, id}, partial.heap.front())))
+                continue;
+            int bound = 0;
+            if (full && !pattern.empty())
+            {
+                bound = alignmentBound(id, match_end - 1, match_end - 1 > matcher.names[id]);
+                if (!better(Candidate{std::max(bound, nameBound(id)), length, id}, partial.heap.front()))
+                    continue;
+            }
+            if (name_end == UNKNOWN_END)
+                partial.name_ends.back() = name_end =
+                    static_cast<uint16_t>(matcher.locateName(id, matcher.names[id], pattern));
+            if (full && !pattern.empty() && name_end > 0)
+            {
+                bound = std::max(bound, alignmentBound(id, name_end - 1, true));
+                if (!better(Candidate{bound, length, id}, partial.heap.front()))
+                    continue;
+            }
+            offer(partial.heap, limit, Candidate{matcher.rank(id, match_end, name_end, nullptr), length, id});
+        }
+    };
+
+    // Büyük listeler parçalara bölünüp paralel taranır; parçalar sırayla birleştirilir, en iyi sonuçlar
+    // parçaların heap'lerinden seçilir
+    unsigned threads = std::max(1u, std::thread::hardware_concurrency());
+    size_t chunk_count = items < PARALLEL_THRESHOLD ? 1 : std::min<size_t>(threads, items / (PARALLEL_THRESHOLD / 2));
+    std::vector<Partial> partials(chunk_count);
+    std::vector<std::thread> pool;
+    for (size_t k = 1; k < chunk_count; k++)
+        pool.push_back(std::thread(scan, items * k / chunk_count, items * (k + 1) / chunk_count, std::ref(partials[k])));
+    scan(0, items / chunk_count, partials[0]);
+    for (std::thread &worker : pool)
+        worker.join();
+
+    Partial all;
+    if (chunk_count == 1)
+    {
+        all = std::move(partials[0]);
+    }
+    else
+    {
+        size_t total = 0;
+        for (const Partial &partial : partials)
+            total += partial.matched.size();
+        all.matched.reserve(total);
+        all.ends.reserve(total);
+        all.name_ends.reserve(total);
+        for (const Partial &partial : partials)
+        {
+            all.matched.insert(all.matched.end(), partial.matched.begin(), partial.matched.end());
+            all.ends.insert(all.ends.end(), partial.ends.begin(), partial.ends.end());
+            all.name_ends.insert(all.name_ends.end(), partial.name_ends.begin(), partial.name_ends.end());
+            for (const Candidate &candidate : partial.heap)
+                offer(all.heap, limit, candidate);
+        }
+    }
+    std::vector<Candidate> &heap = all.heap;
+
+    // Vurgulanacak konumlar sadece gösterilen sonuçlar için hesaplanır
+    std::sort_heap(heap.begin(), heap.end(), better);
+    for (const Candidate &candidate : heap)
+    {
+        PathMatch match{std::string(matcher.blob + matcher.offsets[candidate.id], candidate.length), candidate.score,
+                        std::vector<uint16_t>()};
+        size_t end = 0;
+        matcher.locate(candidate.id, 0, pattern, end);
+        matcher.rank(candidate.id, end, matcher.locateName(candidate.id, matcher.names[candidate.id], pattern),
+                     &match.positions);
+        out.push_back(std::move(match));
+    }
+
+    size_t total = all.matched.size();
+    cached_snapshot = snapshot;
+    cached_pattern = pattern;
+    cached_ids.swap(all.matched);
+    cached_ends.swap(all.ends);
+    cached_name_ends.swap(all.name_ends);
+    return total;
+}
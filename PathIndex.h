@@ -0,0 +1,85 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+struct PathMatch
+{
+    std::string path; // kökten göreli, '/' ayırıcılı
+    int score;
+    std::vector<uint16_t> positions; // eşleşen byte'lar (vurgulama için)
+};
+
+// Hızlı dosya açma (Ctrl+P) için çalışma alanındaki yolların düz indeksi
+// - Tüm göreli yollar tek bir buffer'da art arda durur; yol başına sadece offset, dosya adı başlangıcı
+//   ve puan üst sınırı için beş 64 bitlik karakter kümesi tutulur (500k yol ~50 MB)
+// - Sorgu önce karakter kümesiyle eler (sorgunun her karakteri yolda var mı), kalanlar SIMD ile
+//   alt dizi (subsequence) olarak eşlenir; en iyi K sonuç küçük bir heap'te tutulur. Heap dolunca
+//   sadece üst sınırı heap'in en kötüsünü geçebilen yollar puanlanır
+// - Sorgu bir öncekinin uzantısıysa sadece önceki eşleşenlere, her yolda da önceki eşleşmenin
+//   bittiği yerden sonrasına bakılır (yazdıkça daralır)
+// - Liste arka planda yeniden kurulup atomik olarak değiştirilir; eski liste sorgulanmaya devam eder
+class PathIndex
+{
+public:
+    explicit PathIndex(const std::string &root);
+    ~PathIndex();
+    PathIndex(const PathIndex &) = delete;
+    PathIndex &operator=(const PathIndex &) = delete;
+
+    const std::string &root() const { return root_path; }
+
+    // Ağacı arka planda gezer, bitince listeyi değiştirir; on_done worker thread'inden çağrılır
+    void startRefresh(std::function<void()> on_done);
+    bool refreshing() const { return refresh_running; }
+
+    // Listeyi verilen göreli yollarla değiştirir (tarama ve benchmark'lar kullanır)
+    void assign(std::vector<std::string> paths);
+    size_t size();
+
+    // Büyük/küçük harf duyarsız bulanık eşleme; en iyi limit sonuç puana göre sıralı döner.
+    // Toplam eşleşen yol sayısını döndürür. Tek thread'den (UI) çağrılmalıdır.
+    size_t query(const std::string &pattern, size_t limit, std::vector<PathMatch> &out);
+
+private:
+    struct Snapshot
+    {
+        std::string blob;               // yollar art arda, sonunda SIMD okuması için dolgu
+        std::vector<uint32_t> offsets;  // yol i: [offsets[i], offsets[i + 1])
+        std::vector<uint16_t> names;    // dosya adının yol içindeki başlangıcı
+        std::vector<uint64_t> charsets; // yolda geçen karakterlerin kümesi
+        struct BonusSets // puan üst sınırı için karakter kümeleri
+        {
+            uint64_t boundary;   // yol başında, '/' ya da '_', '-', '.', ' ' sonrasında geçenler
+            uint64_t hump;       // küçük harften sonra büyük harf olarak geçenler
+            uint64_t name;       // dosya adında geçenler
+            uint64_t name_bonus; // dosya adında kelime başında ya da tümsekte geçenler
+        };
+        std::vector<BonusSets> bonus_sets;
+    };
+
+    std::string root_path;
+
+    std::mutex mutex; // current'ı korur
+    std::shared_ptr<const Snapshot> current;
+
+    // Daralma önbelleği (sadece sorgu thread'i)
+    std::shared_ptr<const Snapshot> cached_snapshot;
+    std::string cached_pattern;
+    std::vector<uint32_t> cached_ids;
+    std::vector<uint16_t> cached_ends;      // cached_ids'deki yollarda açgözlü eşleşmenin bittiği yer
+    std::vector<uint16_t> cached_name_ends; // aynısı dosya adında (eşleşmiyorsa 0)
+
+    std::atomic<bool> refresh_running;
+    std::atomic<bool> cancelled;
+    std::thread refresher;
+
+    void refresh(std::function<void()> on_done);
+};
@@ -0,0 +1,877 @@
+#include "Regex.h"
+
+#include <algorithm>
+#include <cstring>
+#include <map>
+
+namespace
+{
+    // Derlenmiş program ve DFA önbelleği sınırları
+    const size_t MAX_INSTS = 20000;
+    const int MAX_REPEAT = 1000;
+    const size_t MAX_CACHE_BYTES = 2 * 1024 * 1024;
+    // Önbellek temizlikleri arasında durum başına bundan az byte taranıyorsa DFA işe yaramıyor demektir
+    const size_t MIN_BYTES_PER_STATE = 16;
+    const size_t REVERSE_WINDOW = 4096;
+
+    const int DEAD = 0;
+
+    // Sonraki byte türü (lookahead): $ için satır sonu, \b için kelime karakteri
+    const int LOOKAHEAD_EOL = 1;
+    const int LOOKAHEAD_WORD = 2;
+
+    enum NodeType
+    {
+        NODE_EMPTY,
+        NODE_SET,
+        NODE_CONCAT,
+        NODE_ALT,
+        NODE_REPEAT,
+        NODE_ASSERT
+    };
+
+    // UTF-8 devam/başlangıç byte'ları da kelime sayılır, böylece \b ve \w ASCII dışı harflerde bölünmez
+    inline bool isWordByte(int byte)
+    {
+        return (byte >= 'a' && byte <= 'z') || (byte >= 'A' && byte <= 'Z') || (byte >= '0' && byte <= '9') ||
+               byte == '_' || byte >= 0x80;
+    }
+
+    inline bool isSpaceByte(int byte)
+    {
+        return byte == ' ' || byte == '\t' || byte == '\n' || byte == '\r' || byte == '\f' || byte == '\v';
+    }
+
+    int hexValue(char ch)
+    {
+        if (ch >= '0' && ch <= '9')
+            return ch - '0';
+        if (ch >= 'a' && ch <= 'f')
+            return ch - 'a' + 10;
+        if (ch >= 'A' && ch <= 'F')
+            return ch - 'A' + 10;
+        return -1;
+    }
+}
+
+struct Regex::Node
+{
+    int type;
+    std::vector<bool> set;
+    std::vector<Node *> children;
+    int min;
+    int max; // -1: sınırsız
+    bool greedy;
+    Opcode assertion;
+
+    Node() : type(NODE_EMPTY), min(0), max(0), greedy(true), assertion(OP_MATCH) {}
+};
+
+Regex::Regex(const std::string &pattern, bool ignore_case) : source(pattern), ignore_case(ignore_case), parse_pos(0)
+{
+    NodePool pool;
+    Node *root = parseAlternation(pool);
+    if (error_message.empty() && parse_pos < source.size())
+        error_message = "unmatched )";
+    if (!error_message.empty())
+        return;
+
+    build(forward, root, false);
+    if (error_message.empty())
+        build(reverse, root, true);
+}
+
+// ---------------------------------------------------------------------------
+// Ayrıştırma
+
+Regex::Node *Regex::makeNode(NodePool &pool, int type)
+{
+    pool.push_back(std::unique_ptr<Node>(new Node()));
+    pool.back()->type = type;
+    return pool.back().get();
+}
+
+void Regex::addByte(std::vector<bool> &set, unsigned char byte) const
+{
+    set[byte] = true;
+    if (ignore_case && byte >= 'a' && byte <= 'z')
+        set[byte - 32] = true;
+    else if (ignore_case && byte >= 'A' && byte <= 'Z')
+        set[byte + 32] = true;
+}
+
+Regex::Node *Regex::parseAlternation(NodePool &pool)
+{
+    Node *first = parseConcat(pool);
+    if (parse_pos >= source.size() || source[parse_pos] != '|')
+        return first;
+
+    Node *alt = makeNode(pool, NODE_ALT);
+    alt->children.push_back(first);
+    while (error_message.empty() && parse_pos < source.size() && source[parse_pos] == '|')
+    {
+        parse_pos++;
+        alt->children.push_back(parseConcat(pool));
+    }
+    return alt;
+}
+
+Regex::Node *Regex::parseConcat(NodePool &pool)
+{
+    Node *concat = makeNode(pool, NODE_CONCAT);
+    while (error_message.empty() && parse_pos < source.size() && source[parse_pos] != '|' && source[parse_pos] != ')')
+        concat->children.push_back(parseRepeat(pool));
+    return concat;
+}
+
+Regex::Node *Regex::parseRepeat(NodePool &pool)
+{
+    Node *atom = parseAtom(pool);
+    while (error_message.empty() && parse_pos < source.size())
+    {
+        char ch = source[parse_pos];
+        int min = 0;
+        int max = -1;
+        if (ch == '*')
+        {
+            parse_pos++;
+        }
+        else if (ch == '+')
+        {
+            min = 1;
+            parse_pos++;
+        }
+        else if (ch == '?')
+        {
+            max = 1;
+            parse_pos++;
+        }
+        else if (ch == '{')
+        {
+            // {m} {m,} {m,n} - biçim tutmazsa '{' düz karakterdir
+            size_t pos = parse_pos + 1;
+            auto number = [this, &pos](int &value)
+            {
+                size_t begin = pos;
+                value = 0;
+                while (pos < source.size() && source[pos] >= '0' && source[pos] <= '9' && value <= MAX_REPEAT)
+                    value = value * 10 + (source[pos++] - '0');
+                return pos > begin;
+            };
+            if (!number(min))
+                break;
+            max = min;
+            if (pos < source.size() && source[pos] == ',')
+            {
+                pos++;
+                if (!number(max))
+                    max = -1;
+            }
+            if (pos >= source.size() || source[pos] != '}')
+                break;
+            if (min > MAX_REPEAT || max > MAX_REPEAT || (max >= 0 && max < min))
+            {
+                error_message = "invalid repetition count";
+                return atom;
+            }
+            parse_pos = pos + 1;
+        }
+        else
+        {
+            break;
+        }
+
+        Node *repeat = makeNode(pool, NODE_REPEAT);
+        repeat->children.push_back(atom);
+        repeat->min = min;
+        repeat->max = max;
+        if (parse_pos < source.size() && source[parse_pos] == '?')
+        {
+            repeat->greedy = false;
+            parse_pos++;
+        }
+        atom = repeat;
+    }
+    return atom;
+}
+
+Regex::Node *Regex::parseAtom(NodePool &pool)
+{
+    char ch = source[parse_pos++];
+    switch (ch)
+    {
+    case '(':
+    {
+        if (source.compare(parse_pos, 2, "?:") == 0)
+            parse_pos += 2;
+        Node *inner = parseAlternation(pool);
+        if (error_message.empty() && (parse_pos >= source.size() || source[parse_pos] != ')'))
+            error_message = "missing )";
+        parse_pos++;
+        return inner;
+    }
+    case '*':
+    case '+':
+    case '?':
+        error_message = "nothing to repeat";
+        return makeNode(pool, NODE_EMPTY);
+    case '^':
+    case '$':
+    {
+        Node *node = makeNode(pool, NODE_ASSERT);
+        node->assertion = ch == '^' ? OP_BOL : OP_EOL;
+        return node;
+    }
+    case '.':
+    {
+        Node *node = makeNode(pool, NODE_SET);
+        node->set.assign(256, true);
+        node->set['\n'] = false;
+        return node;
+    }
+    case '[':
+    {
+        Node *node = makeNode(pool, NODE_SET);
+        node->set.assign(256, false);
+        parseClass(node->set);
+        return node;
+    }
+    case '\\':
+    {
+        Node *node = makeNode(pool, NODE_SET);
+        node->set.assign(256, false);
+        Node *assertion = nullptr;
+        parseEscape(node->set, assertion, pool, false);
+        return assertion ? assertion : node;
+    }
+    default:
+    {
+        Node *node = makeNode(pool, NODE_SET);
+        node->set.assign(256, false);
+        addByte(node->set, static_cast<unsigned char>(ch));
+        return node;
+    }
+    }
+}
+
+bool Regex::parseClass(std::vector<bool> &set)
+{
+    bool negate = parse_pos < source.size() && source[parse_pos] == '^';
+    if (negate)
+        parse_pos++;
+
+    bool first = true;
+    while (parse_pos < source.size() && (source[parse_pos] != ']' || first))
+    {
+        first = false;
+        if (source[parse_pos] == '\\')
+        {
+            parse_pos++;
+            Node *unused = nullptr;
+            NodePool none;
+            if (!parseEscape(set, unused, none, true))
+                return false;
+            continue;
+        }
+
+        unsigned char low = static_cast<unsigned char>(source[parse_pos++]);
+        unsigned char high = low;
+        if (parse_pos + 1 < source.size() && source[parse_pos] == '-' && source[parse_pos + 1] != ']')
+        {
+            high = static_cast<unsigned char>(source[parse_pos + 1]);
+            parse_pos += 2;
+            if (high < low)
+            {
+                error_message = "invalid range in []";
+                return false;
+            }
+        }
+        for (int byte = low; byte <= high; byte++)
+            addByte(set, static_cast<unsigned char>(byte));
+    }
+
+    if (parse_pos >= source.size())
+    {
+        error_message = "missing ]";
+        return false;
+    }
+    parse_pos++;
+
+    // Satır odaklı arama: olumsuz küme satır sonunu kapsamaz
+    if (negate)
+    {
+        set.flip();
+        set['\n'] = false;
+    }
+    return true;
+}
+
+bool Regex::parseEscape(std::vector<bool> &set, Node *&assertion, NodePool &pool, bool in_class)
+{
+    if (parse_pos >= source.size())
+    {
+        error_message = "trailing \\";
+        return false;
+    }
+
+    char ch = source[parse_pos++];
+    auto addIf = [&set](bool (*test)(int), bool negate)
+    {
+        for (int byte = 0; byte < 256; byte++)
+        {
+            if (test(byte) != negate && !(negate && byte == '\n'))
+                set[byte] = true;
+        }
+    };
+
+    switch (ch)
+    {
+    case 'd':
+    case 'D':
+        addIf([](int byte)
+              { return byte >= '0' && byte <= '9'; },
+              ch == 'D');
+        return true;
+    case 'w':
+    case 'W':
+        addIf(isWordByte, ch == 'W');
+        return true;
+    case 's':
+    case 'S':
+        addIf(isSpaceByte, ch == 'S');
+        return true;
+    case 'n':
+        set['\n'] = true;
+        return true;
+    case 't':
+        set['\t'] = true;
+        return true;
+    case 'r':
+        set['\r'] = true;
+        return true;
+    case 'x':
+    {
+        int high = parse_pos < source.size() ? hexValue(source[parse_pos]) : -1;
+        int low = parse_pos + 1 < source.size() ? hexValue(source[parse_pos + 1]) : -1;
+        if (high < 0 || low < 0)
+        {
+            error_message = "invalid \\x escape";
+            return false;
+        }
+        parse_pos += 2;
+        addByte(set, static_cast<unsigned char>(high * 16 + low));
+        return true;
+    }
+    case 'b':
+    case 'B':
+        if (in_class)
+        {
+            error_message = "\\b is not allowed in []";
+            return false;
+        }
+        assertion = makeNode(pool, NODE_ASSERT);
+        assertion->assertion = ch == 'b' ? OP_WORD_BOUNDARY : OP_NOT_WORD_BOUNDARY;
+        return true;
+    default:
+        if ((ch >= '0' && ch <= '9') || (ch >= 'a' && ch <= 'z') || (ch >= 'A' && ch <= 'Z'))
+        {
+            error_message = std::string("unsupported escape \\") + ch;
+            return false;
+        }
+        addByte(set, static_cast<unsigned char>(ch));
+        return true;
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Derleme: düğüm, devamı (next) bilinerek sondan başa derlenir
+
+int Regex::compile(Engine &engine, const Node *node, int next, bool reversed)
+{
+    if (!error_message.empty())
+        return next;
+    if (engine.insts.size() > MAX_INSTS)
+    {
+        error_message = "pattern too large";
+        return next;
+    }
+
+    auto emit = [&engine](Opcode op, int out, int out1, int set)
+    {
+        engine.insts.push_back({op, out, out1, set});
+        return static_cast<int>(engine.insts.size() - 1);
+    };
+
+    switch (node->type)
+    {
+    case NODE_SET:
+        engine.sets.push_back(node->set);
+        return emit(OP_BYTES, next, -1, static_cast<int>(engine.sets.size() - 1));
+
+    case NODE_ASSERT:
+    {
+        // Ters taramada satır başı/sonu yer değiştirir; \b simetriktir
+        Opcode op = node->assertion;
+        if (reversed && op == OP_BOL)
+            op = OP_EOL;
+        else if (reversed && op == OP_EOL)
+            op = OP_BOL;
+        return emit(op, next, -1, -1);
+    }
+
+    case NODE_CONCAT:
+        if (reversed)
+        {
+            for (const Node *child : node->children)
+                next = compile(engine, child, next, reversed);
+        }
+        else
+        {
+            for (size_t i = node->children.size(); i-- > 0;)
+                next = compile(engine, node->children[i], next, reversed);
+        }
+        return next;
+
+    case NODE_ALT:
+    {
+        std::vector<int> entries;
+        for (const Node *child : node->children)
+            entries.push_back(compile(engine, child, next, reversed));
+        int target = entries.back();
+        for (size_t i = entries.size() - 1; i-- > 0;)
+            target = emit(OP_SPLIT, entries[i], target, -1);
+        return target;
+    }
+
+    case NODE_REPEAT:
+    {
+        const Node *child = node->children[0];
+        int result = next;
+        if (node->max < 0)
+        {
+            // Döngü: split -> gövde -> split
+            int loop = emit(OP_SPLIT, -1, -1, -1);
+            int body = compile(engine, child, loop, reversed);
+            engine.insts[loop].out = node->greedy ? body : next;
+            engine.insts[loop].out1 = node->greedy ? next : body;
+            result = loop;
+        }
+        else
+        {
+            // x{0,k}: (x(x(x)?)?)? - her atlama doğrudan devama gider
+            for (int i = node->min; i < node->max; i++)
+            {
+                int body = compile(engine, child, result, reversed);
+                result = node->greedy ? emit(OP_SPLIT, body, next, -1) : emit(OP_SPLIT, next, body, -1);
+            }
+        }
+        for (int i = 0; i < node->min; i++)
+            result = compile(engine, child, result, reversed);
+        return result;
+    }
+
+    default:
+        return next;
+    }
+}
+
+void Regex::build(Engine &engine, const Node *root, bool reversed)
+{
+    engine.insts.clear();
+    engine.sets.clear();
+    int match = static_cast<int>(engine.insts.size());
+    engine.insts.push_back({OP_MATCH, -1, -1, -1});
+    int entry = compile(engine, root, match, reversed);
+    if (!error_message.empty())
+        return;
+
+    if (reversed)
+    {
+        // Eşleşmenin sonundan geriye, en uzun (en soldaki başlangıç)
+        engine.start = entry;
+    }
+    else
+    {
+        // Başsız arama: önce desen, olmazsa bir byte atla (.*? öneki, en düşük öncelik)
+        int loop = static_cast<int>(engine.insts.size());
+        engine.insts.push_back({OP_SPLIT, entry, loop + 1, -1});
+        engine.sets.push_back(std::vector<bool>(256, true));
+        engine.insts.push_back({OP_BYTES, loop, -1, static_cast<int>(engine.sets.size() - 1)});
+        engine.start = loop;
+    }
+    engine.prepare(reversed);
+}
+
+// ---------------------------------------------------------------------------
+// Lazy DFA
+
+void Regex::Engine::prepare(bool reverse_scan)
+{
+    // İleri: ^ önceki byte '\n' ise, $ sonraki byte '\n' ya da '\r' ise (CRLF) tutar.
+    // Ters programda ikisi yer değiştirdiği için tanımlar da aynalanır.
+    reversed = reverse_scan;
+    for (int byte = -1; byte < 256; byte++)
+    {
+        bool edge = byte < 0 || byte == '\n';
+        bool line_end = edge || byte == '\r';
+        bool word = byte >= 0 && isWordByte(byte);
+        lookahead_of[byte + 1] = static_cast<uint8_t>(((reversed ? edge : line_end) ? LOOKAHEAD_EOL : 0) | (word ? LOOKAHEAD_WORD : 0));
+        context_of[byte + 1] = static_cast<uint8_t>(((reversed ? line_end : edge) ? CONTEXT_LINE_START : 0) | (word ? CONTEXT_WORD : 0));
+    }
+
+    // Aynı kümelere düşen ve aynı bağlamı üreten byte'lar tek sınıftır
+    std::map<std::vector<bool>, int> signatures;
+    for (int byte = 0; byte < 256; byte++)
+    {
+        std::vector<bool> signature;
+        signature.reserve(sets.size() + 2);
+        for (const std::vector<bool> &set : sets)
+            signature.push_back(set[byte]);
+        signature.push_back(lookahead_of[byte + 1] & LOOKAHEAD_EOL);
+        signature.push_back(context_of[byte + 1] & CONTEXT_LINE_START);
+        signature.push_back(isWordByte(byte));
+
+        auto found = signatures.find(signature);
+        if (found == signatures.end())
+            found = signatures.insert(std::make_pair(signature, static_cast<int>(signatures.size()))).first;
+        classes[byte] = static_cast<uint8_t>(found->second);
+    }
+    class_count = static_cast<int>(signatures.size());
+    stride_shift = 0;
+    while ((1 << stride_shift) < class_count)
+        stride_shift++;
+
+    marks.assign(insts.size(), 0);
+    generation = 0;
+    resets = 0;
+    resetCache();
+    resets = 0;
+}
+
+void Regex::Engine::beginSearch()
+{
+    nfa_mode = false;
+    reset_scanned = 0;
+}
+
+void Regex::Engine::resetCache()
+{
+    states.clear();
+    match_masks.clear();
+    lookup.clear();
+    cache_bytes = 0;
+    std::fill(start_states, start_states + 4, -1);
+    resets++;
+
+    // 0: ölü durum, her byte'ta kendisine gider
+    states.push_back(DState());
+    states.back().context = 0;
+    match_masks.push_back(0);
+    transitions.assign(size_t(1) << stride_shift, DEAD);
+}
+
+void Regex::Engine::closure(int inst, int context, int lookahead, std::vector<int> &out)
+{
+    // Öncelik sırasında DFS: split'in out dalı out1'den önce gelir
+    stack.clear();
+    stack.push_back(inst);
+    while (!stack.empty())
+    {
+        int index = stack.back();
+        stack.pop_back();
+        if (marks[index] == generation)
+            continue;
+        marks[index] = generation;
+
+        const Inst &current = insts[index];
+        switch (current.op)
+        {
+        case OP_SPLIT:
+            stack.push_back(current.out1);
+            stack.push_back(current.out);
+            break;
+        case OP_BOL:
+            if (context & CONTEXT_LINE_START)
+                stack.push_back(current.out);
+            break;
+        case OP_EOL:
+            // Sonraki byte henüz bilinmiyorsa durumda bekler, geçişte çözülür
+            if (lookahead < 0)
+                out.push_back(index);
+            else if (lookahead & LOOKAHEAD_EOL)
+                stack.push_back(current.out);
+            break;
+        case OP_WORD_BOUNDARY:
+        case OP_NOT_WORD_BOUNDARY:
+            if (lookahead < 0)
+            {
+                out.push_back(index);
+            }
+            else
+            {
+                bool boundary = ((context & CONTEXT_WORD) != 0) != ((lookahead & LOOKAHEAD_WORD) != 0);
+                if (boundary == (current.op == OP_WORD_BOUNDARY))
+                    stack.push_back(current.out);
+            }
+            break;
+        default:
+            out.push_back(index);
+            break;
+        }
+    }
+}
+
+uint8_t Regex::Engine::computeMatchMask(const std::vector<int> &list, int context)
+{
+    uint8_t mask = 0;
+    for (int lookahead = 0; lookahead < 4; lookahead++)
+    {
+        generation++;
+        probe.clear();
+        for (int inst : list)
+            closure(inst, context, lookahead, probe);
+        for (int inst : probe)
+        {
+            if (insts[inst].op == OP_MATCH)
+            {
+                mask |= static_cast<uint8_t>(1 << lookahead);
+                break;
+            }
+        }
+    }
+    return mask;
+}
+
+int Regex::Engine::intern(const std::vector<int> &list, int context, size_t scanned)
+{
+    if (list.empty())
+        return DEAD;
+
+    std::string key(1 + list.size() * sizeof(int), '\0');
+    key[0] = static_cast<char>(context);
+    memcpy(&key[1], list.data(), list.size() * sizeof(int));
+
+    auto found = lookup.find(key);
+    if (found != lookup.end())
+        return found->second;
+
+    if (nfa_mode || cache_bytes > MAX_CACHE_BYTES)
+    {
+        // Önbellek dolmadan önce durumlar yeterince tekrar kullanılmadıysa önbelleği bırak
+        if (!nfa_mode && scanned - reset_scanned < MIN_BYTES_PER_STATE * states.size())
+            nfa_mode = true;
+        reset_scanned = scanned;
+        resetCache();
+    }
+
+    int id = static_cast<int>(states.size());
+    DState state;
+    state.insts = list;
+    state.context = context;
+    states.push_back(std::move(state));
+    match_masks.push_back(computeMatchMask(list, context));
+    transitions.resize(transitions.size() + (size_t(1) << stride_shift), -1);
+    lookup.emplace(key, id);
+    cache_bytes += sizeof(DState) + 2 * key.size() + (sizeof(int) << stride_shift) + 64;
+    return id;
+}
+
+int Regex::Engine::startState(int context)
+{
+    if (start_states[context] >= 0 && !nfa_mode)
+        return start_states[context];
+
+    generation++;
+    scratch.clear();
+    closure(start, context, -1, scratch);
+    int id = intern(scratch, context, reset_scanned);
+    start_states[context] = id;
+    return id;
+}
+
+bool Regex::Engine::idle(int state)
+{
+    // Eşleşmeden ilerleyen durum, önekin döngüsünden tekrar üretilen başlangıç kapanışıdır
+    const DState &current = states[state];
+    generation++;
+    probe.clear();
+    closure(start, current.context, -1, probe);
+    return current.insts == probe;
+}
+
+int Regex::Engine::next(int state, unsigned char byte, size_t scanned)
+{
+    // Önce sonraki byte'a bağlı bekleyen koşulları çöz, sonra byte'ı tüket
+    int lookahead = lookahead_of[byte + 1];
+    const DState &from = states[state];
+    generation++;
+    expanded.clear();
+    for (int inst : from.insts)
+        closure(inst, from.context, lookahead, expanded);
+
+    int context = context_of[byte + 1];
+    generation++;
+    scratch.clear();
+    for (int inst : expanded)
+    {
+        const Inst &current = insts[inst];
+        if (current.op == OP_MATCH)
+        {
+            // İleri taramada eşleşmeden sonraki (düşük öncelikli) yollar bırakılır
+            if (!reversed)
+                break;
+            continue;
+        }
+        if (current.op == OP_BYTES && sets[current.set][byte])
+            closure(current.out, context, -1, scratch);
+    }
+
+    size_t resets_before = resets;
+    int target = intern(scratch, context, scanned);
+    if (resets == resets_before)
+        transitions[(static_cast<size_t>(state) << stride_shift) + classes[byte]] = target;
+    return target;
+}
+
+// ---------------------------------------------------------------------------
+// Arama
+
+bool Regex::scanForward(const TextDocument *document, const char *data, size_t from, size_t to, int before, int after,
+                        size_t &match_end, bool *open)
+{
+    Engine &engine = forward;
+    engine.beginSearch();
+    int state = engine.startState(engine.context_of[before + 1]);
+    size_t found = static_cast<size_t>(-1);
+    bool dead = false;
+
+    auto run = [&](const char *chunk, size_t size, size_t base)
+    {
+        // Sıcak döngü: tablolar yerel işaretçilerde, sadece önbellek kaçırılınca yenilenir
+        const unsigned char *bytes = reinterpret_cast<const unsigned char *>(chunk);
+        const int *table = engine.transitions.data();
+        const uint8_t *masks = engine.match_masks.data();
+        const uint8_t *classes = engine.classes;
+        const uint8_t *lookahead = engine.lookahead_of + 1;
+        int shift = engine.stride_shift;
+        for (size_t i = 0; i < size; i++)
+        {
+            unsigned char byte = bytes[i];
+            if (masks[state] && ((masks[state] >> lookahead[byte]) & 1))
+                found = base + i;
+            int target = table[(static_cast<size_t>(state) << shift) + classes[byte]];
+            if (target < 0)
+            {
+                target = engine.next(state, byte, base + i - from);
+                table = engine.transitions.data();
+                masks = engine.match_masks.data();
+            }
+            state = target;
+            if (state == DEAD)
+                return false;
+        }
+        return true;
+    };
+
+    if (document)
+    {
+        size_t pos = from;
+        document->forEachChunkUntil(from, to - from, [&](const char *chunk, size_t size)
+                                    {
+            dead = !run(chunk, size, pos);
+            pos += size;
+            return !dead; });
+    }
+    else
+    {
+        dead = !run(data + from, to - from, from);
+    }
+
+    if (!dead && engine.matchesBefore(state, engine.lookahead_of[after + 1]))
+        found = to;
+    // Eşleşmeden sonra düşük öncelikli yollar bırakıldığı için durum ancak eşleşme uzayabiliyorsa yaşar
+    if (open)
+        *open = !dead && (found != static_cast<size_t>(-1) || !engine.idle(state));
+    match_end = found;
+    return found != static_cast<size_t>(-1);
+}
+
+bool Regex::scanReverse(const TextDocument *document, const char *data, size_t from, size_t end, int before, int after,
+                        size_t &match_start)
+{
+    // Ters program: bağlam eşleşmenin sonundaki byte, bakılan byte ise soldaki
+    Engine &engine = reverse;
+    engine.beginSearch();
+    int state = engine.startState(engine.context_of[after + 1]);
+    size_t found = static_cast<size_t>(-1);
+    bool dead = false;
+
+    std::string window;
+    size_t window_size = REVERSE_WINDOW;
+    size_t pos = end;
+    while (pos > from && !dead)
+    {
+        size_t low = pos - std::min(window_size, pos - from);
+        const unsigned char *bytes;
+        if (document)
+        {
+            window = document->getText(low, pos - low);
+            bytes = reinterpret_cast<const unsigned char *>(window.data()) - low;
+        }
+        else
+        {
+            bytes = reinterpret_cast<const unsigned char *>(data);
+        }
+
+        for (size_t i = pos; i-- > low;)
+        {
+            unsigned char byte = bytes[i];
+            if (engine.match_masks[state] && engine.matchesBefore(state, engine.lookahead_of[byte + 1]))
+                found = i + 1;
+            int target = engine.transitions[(static_cast<size_t>(state) << engine.stride_shift) + engine.classes[byte]];
+            state = target >= 0 ? target : engine.next(state, byte, end - i);
+            if (state == DEAD)
+            {
+                dead = true;
+                break;
+            }
+        }
+        pos = low;
+        window_size *= 2;
+    }
+
+    if (!dead && engine.matchesBefore(state, engine.lookahead_of[before + 1]))
+        found = from;
+    match_start = found;
+    return found != static_cast<size_t>(-1);
+}
+
+bool Regex::find(const char *data, size_t size, size_t from, size_t &match_start, size_t &match_end)
+{
+    if (!valid() || from > size)
+        return false;
+
+    int before = from > 0 ? static_cast<unsigned char>(data[from - 1]) : -1;
+    if (!scanForward(nullptr, data, from, size, before, -1, match_end, nullptr))
+        return false;
+    int at_end = match_end < size ? static_cast<unsigned char>(data[match_end]) : -1;
+    return scanReverse(nullptr, data, from, match_end, before, at_end, match_start);
+}
+
+bool Regex::find(const TextDocument &document, size_t from, size_t to, size_t &match_start, size_t &match_end,
+                 bool *open)
+{
+    size_t length = document.length();
+    to = std::min(to, length);
+    if (open)
+        *open = false;
+    if (!valid() || from > to)
+        return false;
+
+    int before = from > 0 ? static_cast<unsigned char>(document.charAt(from - 1)) : -1;
+    int after = to < length ? static_cast<unsigned char>(document.charAt(to)) : -1;
+    if (!scanForward(&document, nullptr, from, to, before, after, match_end, open))
+        return false;
+    int at_end = match_end < length ? static_cast<unsigned char>(document.charAt(match_end)) : -1;
+    return scanReverse(&document, nullptr, from, match_end, before, at_end, match_start);
+}
@@ -0,0 +1,149 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "TextDocument.h"
+
+// Geri izlemesiz düzenli ifade motoru
+// - Desen bir kez NFA'ya derlenir; arama sırasında DFA durumları ihtiyaç oldukça üretilir (lazy DFA)
+// - Durum önbelleği sınırlıdır; dolunca temizlenir, çok sık dolarsa önbelleksiz NFA simülasyonuna geçilir
+// - İleri tarama en soldaki eşleşmenin sonunu, ters (anchored) tarama başlangıcını bulur
+// - ^ $ \b \B sanal bağlam byte'larıyla çözülür: önceki byte durumda, sonraki byte geçişte bilinir
+// Sözdizimi: . [] [^] | () (?:) * + ? {m,n} tembel niceleyiciler (*? +? ?? {m,n}?) ^ $ \b \B \d \w \s \D \W \S
+// Eşleşme byte tabanlıdır ('.' '\n' dışındaki tek byte'a uyar), büyük/küçük harf duyarsızlık ASCII içindir.
+class Regex
+{
+public:
+    explicit Regex(const std::string &pattern, bool ignore_case = false);
+
+    bool valid() const { return error_message.empty(); }
+    const std::string &error() const { return error_message; }
+    const std::string &pattern() const { return source; }
+    bool ignoreCase() const { return ignore_case; }
+
+    // [from, to) içinde tamamen kalan en soldaki eşleşme (eşitlikte önceliğe göre, Perl gibi)
+    bool find(const char *data, size_t size, size_t from, size_t &match_start, size_t &match_end);
+    // open: tarama to'ya yarım kalmış bir eşleşmeyle ulaştı (eşleşme to'dan sonra uzayabilir ya da bitebilir)
+    bool find(const TextDocument &document, size_t from, size_t to, size_t &match_start, size_t &match_end,
+              bool *open = nullptr);
+
+    // Son aramalarda üretilen DFA durumu ve önbellek temizliği sayısı (ölçüm için)
+    size_t dfaStates() const { return forward.states.size() + reverse.states.size(); }
+    size_t cacheResets() const { return forward.resets + reverse.resets; }
+
+private:
+    enum Opcode
+    {
+        OP_BYTES, // byte kümesi
+        OP_SPLIT, // out önce, out1 sonra denenir
+        OP_BOL,
+        OP_EOL,
+        OP_WORD_BOUNDARY,
+        OP_NOT_WORD_BOUNDARY,
+        OP_MATCH
+    };
+
+    struct Inst
+    {
+        Opcode op;
+        int out;
+        int out1;
+        int set; // OP_BYTES: byte kümesi indeksi
+    };
+
+    struct Node;
+
+    // Önceki byte bağlamı: durumun parçası
+    enum Context
+    {
+        CONTEXT_LINE_START = 1, // önceki byte '\n' ya da metin başı
+        CONTEXT_WORD = 2        // önceki byte kelime karakteri
+    };
+
+    struct DState
+    {
+        std::vector<int> insts; // öncelik sırasında NFA komutları
+        int context;
+    };
+
+    // Tek yönlü derlenmiş program ve DFA önbelleği
+    struct Engine
+    {
+        std::vector<Inst> insts;
+        std::vector<std::vector<bool>> sets;
+        int start;
+        bool reversed; // ters tarama: en uzun eşleşme, bağlam sağdaki byte
+        // byte + 1 -> sonraki byte türü / önceki byte bağlamı (0: metin kenarı)
+        uint8_t lookahead_of[257];
+        uint8_t context_of[257];
+
+        uint8_t classes[256]; // byte -> denklik sınıfı
+        int class_count;
+        int stride_shift; // satır genişliği 1 << stride_shift >= class_count (çarpma yerine kaydırma)
+
+        std::vector<DState> states;
+        std::vector<uint8_t> match_masks; // durum başına: sonraki byte türüne göre eşleşme var mı
+        std::vector<int> transitions; // (state << stride_shift) + class, -1: henüz hesaplanmadı
+        std::unordered_map<std::string, int> lookup;
+        size_t cache_bytes;
+        int start_states[4];
+        size_t resets;
+        size_t reset_scanned; // son temizlikte taranmış byte sayısı
+        bool nfa_mode;
+
+        // closure için geçici alanlar
+        std::vector<uint32_t> marks;
+        uint32_t generation;
+        std::vector<int> stack;
+        std::vector<int> scratch;
+        std::vector<int> expanded;
+        std::vector<int> probe;
+
+        Engine() : start(0), reversed(false), class_count(1), stride_shift(0), cache_bytes(0), resets(0), reset_scanned(0),
+                   nfa_mode(false), generation(0) {}
+
+        void prepare(bool reverse_scan);
+        void beginSearch();
+        void resetCache();
+        int startState(int context);
+        // Önbellekte yoksa geçişi hesaplar; scanned önbelleğin ne kadar işe yaradığını ölçmek için
+        int next(int state, unsigned char byte, size_t scanned);
+        bool matchesBefore(int state, int lookahead) const { return (match_masks[state] >> lookahead) & 1; }
+        // Durumda sadece .*? önekinin başlattığı yollar var (hiçbir eşleşme byte tüketmemiş)
+        bool idle(int state);
+
+        int intern(const std::vector<int> &list, int context, size_t scanned);
+        void closure(int inst, int context, int lookahead, std::vector<int> &out);
+        uint8_t computeMatchMask(const std::vector<int> &list, int context);
+    };
+
+    std::string source;
+    bool ignore_case;
+    std::string error_message;
+    Engine forward; // .*? önekli, en soldaki eşleşmenin sonunu bulur
+    Engine reverse; // ters desen, sondan başlangıca
+
+    // Ayrıştırıcı (AST düğümleri derleme bitene kadar pool'da yaşar)
+    typedef std::vector<std::unique_ptr<Node>> NodePool;
+    size_t parse_pos;
+    Node *parseAlternation(NodePool &pool);
+    Node *parseConcat(NodePool &pool);
+    Node *parseRepeat(NodePool &pool);
+    Node *parseAtom(NodePool &pool);
+    bool parseClass(std::vector<bool> &set);
+    bool parseEscape(std::vector<bool> &set, Node *&assertion, NodePool &pool, bool in_class);
+    void addByte(std::vector<bool> &set, unsigned char byte) const;
+    Node *makeNode(NodePool &pool, int type);
+
+    int compile(Engine &engine, const Node *node, int next, bool reversed);
+    void build(Engine &engine, const Node *root, bool reversed);
+
+    bool scanForward(const TextDocument *document, const char *data, size_t from, size_t to, int before, int after,
+                     size_t &match_end, bool *open);
+    bool scanReverse(const TextDocument *document, const char *data, size_t from, size_t end, int before, int after,
+                     size_t &match_start);
+};
@@ -0,0 +1,88 @@
+#include "RenderResources.h"
+#include "GdiRenderer.h"
+
+RenderResources::RenderResources()
+    : buffer_dc(NULL), buffer_bitmap(NULL), buffer_original(NULL), buffer_width(0), buffer_height(0), created(0)
+{
+}
+
+RenderResources::~RenderResources()
+{
+    releaseBackBuffer();
+    for (auto &entry : fonts)
+        DeleteObject(entry.second.handle);
+}
+
+const RenderResources::Font &RenderResources::font(int size)
+{
+    auto found = fonts.find(size);
+    if (found != fonts.end())
+        return found->second;
+
+    Font &font = fonts[size];
+    font.handle = CreateFont(size, 0, 0, 0, FW_BOLD, FALSE, FALSE, FALSE,
+                             ANSI_CHARSET, OUT_DEFAULT_PRECIS, CLIP_DEFAULT_PRECIS,
+                             CLEARTYPE_QUALITY, FIXED_PITCH | FF_MODERN, TEXT("0xNerd Proto"));
+
+    HDC hdc = GetDC(NULL);
+    HGDIOBJ old_font = SelectObject(hdc, font.handle);
+    TEXTMETRIC tm;
+    GetTextMetrics(hdc, &tm);
+    font.char_width = tm.tmAveCharWidth;
+    font.char_height = tm.tmHeight;
+    SelectObject(hdc, old_font);
+    ReleaseDC(NULL, hdc);
+
+    font.atlas.reset(new GlyphAtlas(font.char_width, font.char_height));
+    GdiRenderer::rasterizeFont(font.handle, *font.atlas);
+    created += 2;
+    return font;
+}
+
+HDC RenderResources::backBuffer(HDC window_dc, int width, int height)
+{
+    if (buffer_dc && width == buffer_width && height == buffer_height)
+        return buffer_dc;
+
+    releaseBackBuffer();
+
+    // Yukarıdan aşağı 32 bit: editör piksellere doğrudan yazar
+    BITMAPINFO info = {};
+    info.bmiHeader.biSize = sizeof(BITMAPINFOHEADER);
+    info.bmiHeader.biWidth = width > 0 ? width : 1;
+    info.bmiHeader.biHeight = -(height > 0 ? height : 1);
+    info.bmiHeader.biPlanes = 1;
+    info.bmiHeader.biBitCount = 32;
+    info.bmiHeader.biCompression = BI_RGB;
+
+    void *bits = nullptr;
+    buffer_dc = CreateCompatibleDC(window_dc);
+    buffer_bitmap = CreateDIBSection(window_dc, &info, DIB_RGB_COLORS, &bits, NULL, 0);
+    buffer_original = SelectObject(buffer_dc, buffer_bitmap);
+    buffer_width = width;
+    buffer_height = height;
+    created += 2;
+    return buffer_dc;
+}
+
+void RenderResources::releaseBackBuffer()
+{
+    if (buffer_dc)
+    {
+        SelectObject(buffer_dc, buffer_original);
+        DeleteDC(buffer_dc);
+    }
+    if (buffer_bitmap)
+        DeleteObject(buffer_bitmap);
+    buffer_dc = NULL;
+    buffer_bitmap = NULL;
+    buffer_original = NULL;
+}
+
+unsigned long long RenderResources::allocations() const
+{
+    unsigned long long total = created;
+    for (const auto &entry : fonts)
+        total += entry.second.atlas->tableBuilds();
+    return total;
+}
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <windows.h>
+#include <map>
+#include <memory>
+#include "GlyphAtlas.h"
+
+// Çizimler arasında yeniden kullanılan GDI kaynakları: arka tampon ve boyut başına yazı tipi + glyph atlası
+// Arka tampon sadece pencere boyutu değişince, yazı tipi sadece o boyut ilk kez istenince oluşturulur.
+// Ayırma sayacı kararlı durumda kare başına sıfır olmalı
+class RenderResources
+{
+public:
+    struct Font
+    {
+        HFONT handle;
+        int char_width;
+        int char_height;
+        std::unique_ptr<GlyphAtlas> atlas; // handle'ın rasterize edilmiş glyph'leri
+    };
+
+    RenderResources();
+    ~RenderResources();
+
+    // Verilen boyutta kalın 0xNerd Proto; ilk istekte oluşturulup rasterize edilir
+    const Font &font(int size);
+    // width x height'lık 32 bit DIB section'ın seçili olduğu DC; boyut değişmedikçe aynısı döner
+    HDC backBuffer(HDC window_dc, int width, int height);
+    // Son çizimin arka tamponu; boyut farklıysa ya da hiç yoksa NULL (kaydırmada pikseller yeniden kullanılır)
+    HDC existingBackBuffer(int width, int height) const
+    {
+        return width == buffer_width && height == buffer_height ? buffer_dc : NULL;
+    }
+
+    // GDI nesneleri, yazı tipi rasterizasyonları ve renkli glyph tabloları
+    unsigned long long allocations() const;
+
+private:
+    std::map<int, Font> fonts;
+    HDC buffer_dc;
+    HBITMAP buffer_bitmap;
+    HGDIOBJ buffer_original; // DC'nin ilk bitmap'i, silmeden önce geri seçilir
+    int buffer_width;
+    int buffer_height;
+    unsigned long long created;
+
+    void releaseBackBuffer();
+
+    RenderResources(const RenderResources &) = delete;
+    RenderResources &operator=(const RenderResources &) = delete;
+};
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+// 0x00BBGGRR - Win32 COLORREF ile aynı düzen, GDI'a dönüştürmeden geçer
+typedef uint32_t RenderColor;
+
+inline RenderColor renderColor(int red, int green, int blue)
+{
+    return static_cast<RenderColor>(red) | (static_cast<RenderColor>(green) << 8) | (static_cast<RenderColor>(blue) << 16);
+}
+
+// Metin arka planı çizilmez
+const RenderColor TRANSPARENT_COLOR = 0xFFFFFFFF;
+
+struct RenderRect
+{
+    int left;
+    int top;
+    int right;
+    int bottom;
+};
+
+// Editörün çizdiği her şeyin geçtiği arayüz
+// - GdiRenderer: Windows'ta pencereye (HDC) çizer
+// - HeadlessRenderer: bellekteki framebuffer'a çizer; Linux'ta benchmark ve çerçeve süresi ölçümü için
+// Metin sabit genişlikli yazı tipiyle, ASCII olarak çizilir. Koordinatlar piksel.
+class Renderer
+{
+public:
+    virtual ~Renderer() {}
+
+    // Sonraki çizimler bu alanla sınırlanır
+    virtual void setClip(const RenderRect &rect) = 0;
+    virtual RenderRect clipRect() const = 0;
+    virtual void fillRect(const RenderRect &rect, RenderColor color) = 0;
+    // background TRANSPARENT_COLOR ise sadece yazı pikselleri çizilir
+    virtual void drawText(int x, int y, const char *text, size_t length, RenderColor color,
+                          RenderColor background) = 0;
+    virtual int textWidth(const char *text, size_t length) = 0;
+    // rect içindeki pikseller dy kadar kaydırılır (pozitif aşağı); açılan şerit eski haliyle kalır, çağıran çizer
+    virtual void scroll(const RenderRect &rect, int dy) = 0;
+};
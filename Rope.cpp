@@ -0,0 +1,302 @@
+#include "Rope.h"
+
+Rope::Rope() : root(std::make_shared<Node>(true))
+{
+}
+
+int Rope::depth() const
+{
+    int result = 1;
+    for (const Node *node = root.get(); !node->leaf; node = node->children.front().get())
+        result++;
+    return result;
+}
+
+void Rope::makeUnique(NodePtr &node)
+{
+    // Başka bir kopya (undo snapshot, split pane) bu node'u paylaşıyorsa önce klonla
+    if (node.use_count() > 1)
+        node = std::make_shared<Node>(*node);
+}
+
+void Rope::recompute(Node &node)
+{
+    node.count = 0;
+    node.bytes = 0;
+    node.newlines = 0;
+
+    if (node.leaf)
+    {
+        node.count = node.pieces.size();
+        for (const TextPiece &piece : node.pieces)
+        {
+            node.bytes += piece.length;
+            node.newlines += piece.newlines;
+        }
+    }
+    else
+    {
+        for (const NodePtr &child : node.children)
+        {
+            node.count += child->count;
+            node.bytes += child->bytes;
+            node.newlines += child->newlines;
+        }
+    }
+}
+
+Rope::NodePtr Rope::split(Node &node)
+{
+    // Taşan node'un ikinci yarısını yeni kardeş node'a taşı
+    NodePtr sibling = std::make_shared<Node>(node.leaf);
+    size_t half = node.entries() / 2;
+
+    if (node.leaf)
+    {
+        sibling->pieces.assign(node.pieces.begin() + half, node.pieces.end());
+        node.pieces.resize(half);
+    }
+    else
+    {
+        sibling->children.assign(node.children.begin() + half, node.children.end());
+        node.children.resize(half);
+    }
+
+    recompute(node);
+    recompute(*sibling);
+    return sibling;
+}
+
+Rope::Location Rope::findByOffset(size_t offset) const
+{
+    if (offset >= root->bytes)
+        return {root->count, root->bytes, root->newlines, nullptr};
+
+    Location loc = {0, 0, 0, nullptr};
+    const Node *node = root.get();
+    while (!node->leaf)
+    {
+        for (const NodePtr &child : node->children)
+        {
+            if (offset < loc.offset + child->bytes)
+            {
+                node = child.get();
+                break;
+            }
+            loc.index += child->count;
+            loc.offset += child->bytes;
+            loc.newlines += child->newlines;
+        }
+    }
+
+    for (const TextPiece &piece : node->pieces)
+    {
+        if (offset < loc.offset + piece.length)
+        {
+            loc.piece = &piece;
+            break;
+        }
+        loc.index++;
+        loc.offset += piece.length;
+        loc.newlines += piece.newlines;
+    }
+    return loc;
+}
+
+Rope::Location Rope::findByNewline(size_t k) const
+{
+    if (k == 0 || k > root->newlines)
+        return {root->count, root->bytes, root->newlines, nullptr};
+
+    Location loc = {0, 0, 0, nullptr};
+    const Node *node = root.get();
+    while (!node->leaf)
+    {
+        for (const NodePtr &child : node->children)
+        {
+            if (loc.newlines + child->newlines >= k)
+            {
+                node = child.get();
+                break;
+            }
+            loc.index += child->count;
+            loc.offset += child->bytes;
+            loc.newlines += child->newlines;
+        }
+    }
+
+    for (const TextPiece &piece : node->pieces)
+    {
+        if (loc.newlines + piece.newlines >= k)
+        {
+            loc.piece = &piece;
+            break;
+        }
+        loc.index++;
+        loc.offset += piece.length;
+        loc.newlines += piece.newlines;
+    }
+    return loc;
+}
+
+const TextPiece &Rope::at(size_t index) const
+{
+    const Node *node = root.get();
+    while (!node->leaf)
+    {
+        for (const NodePtr &child : node->children)
+        {
+            if (index < child->count)
+            {
+                node = child.get();
+                break;
+            }
+            index -= child->count;
+        }
+    }
+    return node->pieces[index];
+}
+
+Rope::NodePtr Rope::insertAt(NodePtr &node, size_t index, const TextPiece &piece)
+{
+    makeUnique(node);
+
+    if (node->leaf)
+    {
+        node->pieces.insert(node->pieces.begin() + index, piece);
+    }
+    else
+    {
+        size_t i = 0;
+        while (i + 1 < node->children.size() && index > node->children[i]->count)
+        {
+            index -= node->children[i]->count;
+            i++;
+        }
+
+        NodePtr sibling = insertAt(node->children[i], index, piece);
+        if (sibling)
+            node->children.insert(node->children.begin() + i + 1, sibling);
+    }
+
+    recompute(*node);
+    return node->entries() > MAX_ENTRIES ? split(*node) : nullptr;
+}
+
+void Rope::insert(size_t index, const TextPiece &piece)
+{
+    NodePtr sibling = insertAt(root, index, piece);
+    if (sibling)
+    {
+        // Kök bölündü - ağaç bir seviye büyür
+        NodePtr new_root = std::make_shared<Node>(false);
+        new_root->children.push_back(root);
+        new_root->children.push_back(sibling);
+        recompute(*new_root);
+        root = new_root;
+    }
+}
+
+void Rope::replaceAt(NodePtr &node, size_t index, const TextPiece &piece)
+{
+    makeUnique(node);
+
+    if (node->leaf)
+    {
+        node->pieces[index] = piece;
+    }
+    else
+    {
+        size_t i = 0;
+        while (index >= node->children[i]->count)
+        {
+            index -= node->children[i]->count;
+            i++;
+        }
+        replaceAt(node->children[i], index, piece);
+    }
+
+    recompute(*node);
+}
+
+void Rope::replace(size_t index, const TextPiece &piece)
+{
+    replaceAt(root, index, piece);
+}
+
+void Rope::rebalance(Node &parent, size_t child)
+{
+    if (parent.children[child]->entries() >= MIN_ENTRIES || parent.children.size() < 2)
+        return;
+
+    // Az dolu node'u komşusuyla birleştir ya da girdileri eşit paylaştır
+    size_t left_index = child + 1 < parent.children.size() ? child : child - 1;
+    makeUnique(parent.children[left_index]);
+    makeUnique(parent.children[left_index + 1]);
+    Node &left = *parent.children[left_index];
+    Node &right = *parent.children[left_index + 1];
+
+    if (left.leaf)
+    {
+        left.pieces.insert(left.pieces.end(), right.pieces.begin(), right.pieces.end());
+        right.pieces.clear();
+    }
+    else
+    {
+        left.children.insert(left.children.end(), right.children.begin(), right.children.end());
+        right.children.clear();
+    }
+
+    if (left.entries() <= MAX_ENTRIES)
+    {
+        recompute(left);
+        parent.children.erase(parent.children.begin() + left_index + 1);
+    }
+    else
+    {
+        parent.children[left_index + 1] = split(left);
+    }
+}
+
+void Rope::eraseAt(NodePtr &node, size_t index)
+{
+    makeUnique(node);
+
+    if (node->leaf)
+    {
+        node->pieces.erase(node->pieces.begin() + index);
+    }
+    else
+    {
+        size_t i = 0;
+        while (index >= node->children[i]->count)
+        {
+            index -= node->children[i]->count;
+            i++;
+        }
+
+        eraseAt(node->children[i], index);
+        if (node->children[i]->entries() == 0)
+            node->children.erase(node->children.begin() + i);
+        else
+            rebalance(*node, i);
+    }
+
+    recompute(*node);
+}
+
+void Rope::erase(size_t index)
+{
+    eraseAt(root, index);
+
+    // Tek çocuklu kökü düşür - ağaç bir seviye küçülür
+    while (!root->leaf && root->children.size() == 1)
+        root = root->children.front();
+    if (!root->leaf && root->children.empty())
+        root = std::make_shared<Node>(true);
+}
+
+void Rope::clear()
+{
+    root = std::make_shared<Node>(true);
+}
@@ -0,0 +1,120 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+// Bir buffer'daki bitişik metin dilimi
+struct TextPiece
+{
+    int buffer; // 0: original, n > 0: n. append bloğu
+    size_t start;
+    size_t length;
+    size_t newlines;
+};
+
+// Piece'leri tutan B-tree rope
+// Her node alt ağacındaki piece sayısını, byte sayısını ve '\n' sayısını saklar;
+// böylece offset -> piece, satır -> piece ve index -> piece aramaları O(log n) olur.
+// Node'lar copy-on-write paylaşılır: Rope kopyalamak O(1), düzenleme sadece yolu kopyalar.
+class Rope
+{
+public:
+    struct Location
+    {
+        size_t index;           // piece sırası (bulunamazsa size())
+        size_t offset;          // piece'in belgedeki başlangıç offset'i
+        size_t newlines;        // piece'ten önceki '\n' sayısı
+        const TextPiece *piece; // bulunan piece (bir sonraki düzenlemeye kadar geçerli)
+    };
+
+    Rope();
+
+    size_t size() const { return root->count; }
+    size_t bytes() const { return root->bytes; }
+    size_t newlines() const { return root->newlines; }
+    int depth() const;
+
+    // offset'i içeren piece (offset >= bytes() ise index = size())
+    Location findByOffset(size_t offset) const;
+    // k. '\n' karakterini (1'den başlar) içeren piece
+    Location findByNewline(size_t k) const;
+    const TextPiece &at(size_t index) const;
+
+    void insert(size_t index, const TextPiece &piece);
+    void replace(size_t index, const TextPiece &piece);
+    void erase(size_t index);
+    void clear();
+
+    // index'ten itibaren piece'leri sırayla ziyaret eder, fn false dönerse durur
+    template <typename Fn>
+    void forEachFrom(size_t index, Fn fn) const;
+
+private:
+    static const size_t MAX_ENTRIES = 32;
+    static const size_t MIN_ENTRIES = MAX_ENTRIES / 4;
+
+    struct Node;
+    typedef std::shared_ptr<Node> NodePtr;
+
+    struct Node
+    {
+        bool leaf;
+        std::vector<TextPiece> pieces; // leaf
+        std::vector<NodePtr> children; // internal
+        size_t count;
+        size_t bytes;
+        size_t newlines;
+
+        explicit Node(bool is_leaf) : leaf(is_leaf), count(0), bytes(0), newlines(0) {}
+        size_t entries() const { return leaf ? pieces.size() : children.size(); }
+    };
+
+    NodePtr root;
+
+    static void makeUnique(NodePtr &node);
+    static void recompute(Node &node);
+    static NodePtr split(Node &node);
+    static NodePtr insertAt(NodePtr &node, size_t index, const TextPiece &piece);
+    static void replaceAt(NodePtr &node, size_t index, const TextPiece &piece);
+    static void eraseAt(NodePtr &node, size_t index);
+    static void rebalance(Node &parent, size_t child);
+
+    template <typename Fn>
+    static bool visit(const Node &node, size_t &skip, Fn &fn);
+};
+
+template <typename Fn>
+bool Rope::visit(const Node &node, size_t &skip, Fn &fn)
+{
+    if (skip >= node.count)
+    {
+        skip -= node.count;
+        return true;
+    }
+
+    if (node.leaf)
+    {
+        for (size_t i = skip; i < node.pieces.size(); i++)
+        {
+            if (!fn(node.pieces[i]))
+                return false;
+        }
+        skip = 0;
+        return true;
+    }
+
+    for (const NodePtr &child : node.children)
+    {
+        if (!visit(*child, skip, fn))
+            return false;
+    }
+    return true;
+}
+
+template <typename Fn>
+void Rope::forEachFrom(size_t index, Fn fn) const
+{
+    size_t skip = index;
+    visit(*root, skip, fn);
+}
@@ -0,0 +1,155 @@
+#include "SearchWorker.h"
+
+#include <algorithm>
+
+namespace
+{
+    // findAll belgeyi bloklar halinde tarar; blokta başlayan eşleşme bloğu aşabilir
+    const size_t FIND_BLOCK = 1024 * 1024;
+    // Düzenli ifadede blok sonundan sonra bakılan ilk pencere; eşleşme daha uzunsa pencere büyütülür
+    const size_t REGEX_OVERLAP = 64 * 1024;
+    // Worker her parçadan sonra ilerleme bildirir ve iptali kontrol eder
+    const size_t WORKER_SLICE = 4 * 1024 * 1024;
+}
+
+SearchQuery::SearchQuery(const std::string &search_text, bool fold_case, bool use_regex)
+    : text(search_text), ignore_case(fold_case), literal(use_regex ? std::string() : search_text, fold_case)
+{
+    if (use_regex)
+        regex.reset(new Regex(search_text, fold_case));
+}
+
+size_t SearchQuery::reach() const
+{
+    return regex ? REGEX_OVERLAP : literal.size() - 1;
+}
+
+bool SearchQuery::find(const TextDocument &document, size_t from, size_t to, size_t &match_start,
+                       size_t &match_end)
+{
+    if (!valid())
+        return false;
+    if (regex)
+        return regex->find(document, from, to, match_start, match_end);
+
+    match_start = literal.find(document, from, to);
+    match_end = match_start + literal.size();
+    return match_start != TextSearcher::npos;
+}
+
+bool SearchQuery::find(const char *data, size_t size, size_t from, size_t &match_start, size_t &match_end)
+{
+    if (!valid())
+        return false;
+    if (regex)
+        return regex->find(data, size, from, match_start, match_end);
+
+    match_start = literal.find(data, size, from);
+    match_end = match_start + literal.size();
+    return match_start != TextSearcher::npos;
+}
+
+bool SearchQuery::findInWindow(const TextDocument &document, size_t from, size_t &window_end, size_t &match_start,
+                               size_t &match_end)
+{
+    if (!regex)
+        return find(document, from, window_end, match_start, match_end);
+
+    // Açık kalan eşleşme (a.*b gibi) pencere sonunda kesilmesin ya da kısalmasın
+    size_t length = document.length();
+    bool open = false;
+    bool found = regex->find(document, from, window_end, match_start, match_end, &open);
+    while (open && window_end < length)
+    {
+        window_end = from + std::min(length - from, 2 * (window_end - from));
+        found = regex->find(document, from, window_end, match_start, match_end, &open);
+    }
+    return found;
+}
+
+size_t SearchQuery::findAll(const TextDocument &document, size_t from, size_t to, std::vector<SearchMatch> &out,
+                            size_t max_bytes, bool keep_empty)
+{
+    size_t length = document.length();
+    to = std::min(to, length);
+    if (!valid())
+        return to;
+
+    size_t overlap = reach();
+    size_t limit = max_bytes < to - std::min(from, to) ? from + max_bytes : to;
+    size_t pos = from;
+    while (pos < limit && out.size() < MAX_MATCHES)
+    {
+        size_t block_end = std::min(limit, pos + FIND_BLOCK);
+        size_t window_end = std::min(length, block_end + overlap);
+        size_t match_start = 0, match_end = 0;
+        bool found = findInWindow(document, pos, window_end, match_start, match_end);
+        if (!found || match_start >= block_end)
+        {
+            // İlk eşleşme bloktan sonraysa oraya atlanır. Düzenli ifadede eşleşme yoksa pencere sonunda açık
+            // eşleşme de kalmamıştır: büyütülmüş pencere blok blok yeniden taranmaz
+            size_t next = found ? match_start : (regex || window_end == length ? window_end : block_end);
+            pos = std::max(block_end, std::min(next, to));
+            continue;
+        }
+
+        if (match_end > match_start || keep_empty)
+            out.push_back(SearchMatch{match_start, match_end});
+        pos = match_end > match_start ? match_end : match_start + 1;
+    }
+    return out.size() < MAX_MATCHES ? std::max(pos, limit) : to;
+}
+
+SearchWorker::SearchWorker(TextDocument snapshot, const std::string &text, bool ignore_case, bool use_regex,
+                           std::function<void()> progress)
+    : document(std::move(snapshot)), query(text, ignore_case, use_regex), on_progress(std::move(progress)),
+      scanned(0), done(false), cancelled(false)
+{
+    worker = std::thread(&SearchWorker::run, this);
+}
+
+SearchWorker::~SearchWorker()
+{
+    cancelled = true;
+    if (worker.joinable())
+        worker.join();
+}
+
+size_t SearchWorker::takeMatches(std::vector<SearchMatch> &out)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    out.insert(out.end(), pending.begin(), pending.end());
+    pending.clear();
+    return scanned;
+}
+
+void SearchWorker::run()
+{
+    size_t length = document.length();
+    size_t pos = 0;
+    size_t found = 0;
+    std::vector<SearchMatch> batch;
+
+    while (!cancelled && pos < length && found < SearchQuery::MAX_MATCHES)
+    {
+        batch.clear();
+        pos = query.findAll(document, pos, length, batch, WORKER_SLICE);
+        found += batch.size();
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            pending.insert(pending.end(), batch.begin(), batch.end());
+            scanned = found < SearchQuery::MAX_MATCHES ? pos : length;
+        }
+        if (on_progress && !cancelled)
+            on_progress();
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        scanned = length;
+    }
+    done = true;
+    if (on_progress && !cancelled)
+        on_progress();
+}
@@ -0,0 +1,93 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "Regex.h"
+#include "TextDocument.h"
+#include "TextSearch.h"
+
+struct SearchMatch
+{
+    size_t start;
+    size_t end;
+};
+
+// Düz metin ya da düzenli ifade araması için ortak arayüz
+class SearchQuery
+{
+public:
+    // Bellek sınırı: bu kadar eşleşmeden sonra liste kesilir
+    static constexpr size_t MAX_MATCHES = 4 * 1024 * 1024;
+
+    SearchQuery(const std::string &text, bool ignore_case, bool use_regex);
+
+    bool valid() const { return !text.empty() && (!regex || regex->valid()); }
+    std::string error() const { return regex ? regex->error() : std::string(); }
+    bool matches(const std::string &other_text, bool other_ignore_case, bool other_use_regex) const
+    {
+        return text == other_text && ignore_case == other_ignore_case && (regex != nullptr) == other_use_regex;
+    }
+
+    // Bir eşleşmenin başından itibaren en fazla bu kadar byte'a bakılır (düzenleme sonrası yeniden tarama)
+    size_t reach() const;
+
+    // Tamamen [from, to) içinde kalan ilk eşleşme
+    bool find(const TextDocument &document, size_t from, size_t to, size_t &match_start, size_t &match_end);
+    // Bitişik buffer'da from'dan sonraki ilk eşleşme (eşlenmiş dosyalar için)
+    bool find(const char *data, size_t size, size_t from, size_t &match_start, size_t &match_end);
+
+    // from'dan itibaren [from, to) içinde başlayan çakışmayan eşleşmeleri out'a ekler.
+    // Eşleşmeler to'yu aşabilir. En fazla max_bytes tarar, kalınan yeri döndürür (to: bitti).
+    // Boş eşleşmeler (^, a*) vurgulamada işe yaramaz, keep_empty verilmezse atlanır.
+    size_t findAll(const TextDocument &document, size_t from, size_t to, std::vector<SearchMatch> &out,
+                   size_t max_bytes = static_cast<size_t>(-1), bool keep_empty = false);
+
+private:
+    std::string text;
+    bool ignore_case;
+    TextSearcher literal;
+    std::unique_ptr<Regex> regex;
+
+    // find gibi; düzenli ifade eşleşmesi window_end'de yarım kalırsa pencere iki katına çıkarılır
+    bool findInWindow(const TextDocument &document, size_t from, size_t &window_end, size_t &match_start,
+                      size_t &match_end);
+};
+
+// Belgenin anlık görüntüsündeki tüm eşleşmeleri arka plan thread'inde bulur.
+// Eşleşmeler belge sırasıyla parça parça gelir, UI thread'i takeMatches ile alır.
+// Sorgu değişince nesne yok edilir; yıkıcı taramayı iptal edip thread'i bekler.
+class SearchWorker
+{
+public:
+    // on_progress her parça hazır olduğunda worker thread'inden çağrılır
+    SearchWorker(TextDocument snapshot, const std::string &text, bool ignore_case, bool use_regex,
+                 std::function<void()> on_progress);
+    ~SearchWorker();
+    SearchWorker(const SearchWorker &) = delete;
+    SearchWorker &operator=(const SearchWorker &) = delete;
+
+    // Bekleyen eşleşmeleri out'un sonuna taşır, o ana kadar taranmış offset'i döndürür
+    size_t takeMatches(std::vector<SearchMatch> &out);
+    bool finished() const { return done; }
+    size_t totalBytes() const { return document.length(); }
+
+private:
+    TextDocument document;
+    SearchQuery query;
+    std::function<void()> on_progress;
+
+    std::mutex mutex;
+    std::vector<SearchMatch> pending;
+    size_t scanned; // mutex ile korunur
+    std::atomic<bool> done;
+    std::atomic<bool> cancelled;
+    std::thread worker;
+
+    void run();
+};
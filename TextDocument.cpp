@@ -0,0 +1,391 @@
+#include "TextDocument.h"
+
+#include <cstdio>
+#include "LineScanner.h"
+
+namespace
+{
+#ifdef _WIN32
+    const char *DEFAULT_EOL = "\r\n";
+#else
+    const char *DEFAULT_EOL = "\n";
+#endif
+}
+
+TextDocument::TextDocument() : original(std::make_shared<Buffer>()), added(std::make_shared<Blocks>()),
+                               line_ending(DEFAULT_EOL), loaded_bytes(0), edits(0)
+{
+}
+
+TextDocument::TextDocument(const std::string &text) : TextDocument()
+{
+    setText(text);
+}
+
+void TextDocument::setText(const std::string &text)
+{
+    original = std::make_shared<Buffer>();
+    original->text = text;
+
+    ScanStats stats;
+    indexLines(original->data(), 0, original->size(), original->newlines, stats);
+    resetPieces(stats, original->size());
+}
+
+size_t TextDocument::indexMemory() const
+{
+    size_t bytes = original->newlines.memoryUsage();
+    for (const std::shared_ptr<Buffer> &block : *added)
+        bytes += block->newlines.memoryUsage();
+    return bytes;
+}
+
+void TextDocument::restore(const TextDocument &saved)
+{
+    size_t revision = std::max(edits, saved.edits) + 1;
+    *this = saved;
+    edits = revision;
+}
+
+void TextDocument::resetPieces(const ScanStats &stats, size_t visible_length)
+{
+    added = std::make_shared<Blocks>();
+    pieces.clear();
+    edits++;
+    loaded_bytes = visible_length;
+    if (visible_length > 0)
+        pieces.insert(0, makePiece(0, 0, visible_length));
+
+    // Satır sonu stili tarayıcının saydığı CRLF çiftlerinden belirlenir
+    line_ending = stats.newlines == 0 ? DEFAULT_EOL : (stats.isCrlf() ? "\r\n" : "\n");
+}
+
+bool TextDocument::loadFile(const std::string &path)
+{
+    std::shared_ptr<MappedFile> mapping = MappedFile::open(path);
+    if (!mapping)
+        return false;
+
+    original = std::make_shared<Buffer>();
+    original->mapping = mapping;
+
+    // SIMD tarayıcı + çekirdekler arası paralel indeksleme
+    ScanStats stats;
+    indexLines(original->data(), 0, original->size(), original->newlines, stats);
+    resetPieces(stats, original->size());
+    return true;
+}
+
+void TextDocument::beginLoad(std::shared_ptr<MappedFile> mapping)
+{
+    original = std::make_shared<Buffer>();
+    original->mapping = mapping;
+    load_stats = ScanStats();
+    resetPieces(load_stats, 0);
+}
+
+void TextDocument::appendLoaded(const LineIndex &newlines, const ScanStats &stats, bool finished)
+{
+    original->newlines.append(newlines);
+    load_stats.newlines += stats.newlines;
+    load_stats.crlf += stats.crlf;
+    line_ending = load_stats.newlines == 0 ? DEFAULT_EOL : (load_stats.isCrlf() ? "\r\n" : "\n");
+
+    // Son tam satıra kadar olan kısmı belgeye ekle (yükleme bittiyse dosyanın tamamını)
+    size_t new_end = loaded_bytes;
+    if (finished)
+        new_end = original->size();
+    else if (!original->newlines.empty())
+        new_end = original->newlines[original->newlines.size() - 1] + 1;
+    if (new_end <= loaded_bytes)
+        return;
+
+    TextPiece extra = makePiece(0, loaded_bytes, new_end - loaded_bytes);
+    size_t count = pieces.size();
+    TextPiece last = count > 0 ? pieces.at(count - 1) : TextPiece{-1, 0, 0, 0};
+    if (last.buffer == 0 && last.start + last.length == loaded_bytes)
+    {
+        last.length += extra.length;
+        last.newlines += extra.newlines;
+        pieces.replace(count - 1, last);
+    }
+    else
+    {
+        pieces.insert(count, extra);
+    }
+    loaded_bytes = new_end;
+}
+
+bool TextDocument::saveFile(const std::string &path) const
+{
+    // Eşli dosyanın üzerine doğrudan yazılamaz: önce geçici dosyaya yaz, sonra yerine koy
+    std::string tmp_path = path + ".glitch-tmp";
+    FILE *file = fopen(tmp_path.c_str(), "wb");
+    if (!file)
+        return false;
+
+    bool ok = true;
+    forEachChunk(0, length(), [file, &ok](const char *data, size_t size)
+                 { ok = ok && fwrite(data, 1, size, file) == size; });
+    ok = (fflush(file) == 0) && ok;
+    ok = (fclose(file) == 0) && ok;
+
+    if (!ok || !MappedFile::replaceFile(tmp_path, path))
+    {
+        std::remove(tmp_path.c_str());
+        return false;
+    }
+    return true;
+}
+
+TextPiece TextDocument::makePiece(int buffer, size_t start, size_t length) const
+{
+    return {buffer, start, length, bufferOf(buffer).newlines.countInRange(start, length)};
+}
+
+size_t TextDocument::lineStart(int row) const
+{
+    if (row <= 0)
+        return 0;
+    if (static_cast<size_t>(row) > pieces.newlines())
+        return length();
+
+    // Aranan '\n' karakterini içeren piece'i bul, piece içinde buffer indeksinden ara
+    size_t target = static_cast<size_t>(row);
+    Rope::Location loc = pieces.findByNewline(target);
+    const TextPiece &piece = *loc.piece;
+    const LineIndex &newlines = bufferOf(piece).newlines;
+    size_t first = newlines.lowerBound(piece.start);
+    size_t newline_pos = newlines[first + (target - loc.newlines) - 1];
+    return loc.offset + (newline_pos - piece.start) + 1;
+}
+
+void TextDocument::lineBounds(int row, size_t &start, size_t &end) const
+{
+    start = lineStart(row);
+    if (row < 0 || static_cast<size_t>(row) >= pieces.newlines())
+    {
+        end = row < 0 ? 0 : length();
+        return;
+    }
+
+    // CRLF dosyalarda '\r' satır içeriğine dahil değil
+    end = lineStart(row + 1) - 1;
+    if (end > start && charAt(end - 1) == '\r')
+        end--;
+}
+
+size_t TextDocument::lineEnd(int row) const
+{
+    size_t start = 0;
+    size_t end = 0;
+    lineBounds(row, start, end);
+    return end;
+}
+
+int TextDocument::lineLength(int row) const
+{
+    size_t start = 0;
+    size_t end = 0;
+    lineBounds(row, start, end);
+    return static_cast<int>(end - start);
+}
+
+size_t TextDocument::offsetAt(int row, int col) const
+{
+    row = std::max(0, std::min(row, lineCount() - 1));
+    size_t start = 0;
+    size_t end = 0;
+    lineBounds(row, start, end);
+    if (col <= 0)
+        return start;
+    return std::min(start + static_cast<size_t>(col), end);
+}
+
+void TextDocument::positionAt(size_t offset, int &row, int &col) const
+{
+    offset = std::min(offset, length());
+
+    Rope::Location loc = pieces.findByOffset(offset);
+    size_t seen = loc.newlines;
+    if (loc.piece)
+        seen += makePiece(loc.piece->buffer, loc.piece->start, offset - loc.offset).newlines;
+
+    row = static_cast<int>(seen);
+    col = static_cast<int>(offset - lineStart(row));
+}
+
+void TextDocument::getLine(int row, std::string &out) const
+{
+    out.clear();
+    size_t start = 0;
+    size_t end = 0;
+    lineBounds(row, start, end);
+    out.reserve(end - start);
+    forEachChunk(start, end - start, [&out](const char *data, size_t size)
+                 { out.append(data, size); });
+}
+
+std::string TextDocument::getLine(int row) const
+{
+    std::string line;
+    getLine(row, line);
+    return line;
+}
+
+std::string TextDocument::getText(size_t offset, size_t count) const
+{
+    std::string result;
+    forEachChunk(offset, count, [&result](const char *data, size_t size)
+                 { result.append(data, size); });
+    return result;
+}
+
+char TextDocument::charAt(size_t offset) const
+{
+    Rope::Location loc = pieces.findByOffset(offset);
+    if (!loc.piece)
+        return '\0';
+    return bufferOf(*loc.piece).data()[loc.piece->start + (offset - loc.offset)];
+}
+
+std::string_view TextDocument::lineView(int row, std::string &scratch) const
+{
+    return lineView(row, 0, std::string::npos, scratch);
+}
+
+std::string_view TextDocument::lineView(int row, size_t column, size_t count, std::string &scratch) const
+{
+    size_t start = 0;
+    size_t end = 0;
+    lineBounds(row, start, end);
+    start += std::min(column, end - start);
+    end = start + std::min(count, end - start);
+
+    Rope::Location loc = pieces.findByOffset(start);
+    if (loc.piece && end <= loc.offset + loc.piece->length)
+        return std::string_view(bufferOf(*loc.piece).data() + loc.piece->start + (start - loc.offset), end - start);
+
+    scratch.clear();
+    scratch.reserve(end - start);
+    forEachChunk(start, end - start, [&scratch](const char *data, size_t size)
+                 { scratch.append(data, size); });
+    return scratch;
+}
+
+std::string TextDocument::getText() const
+{
+    return getText(0, length());
+}
+
+void TextDocument::insert(size_t offset, const std::string &text)
+{
+    if (text.empty())
+        return;
+    offset = std::min(offset, length());
+    edits++;
+
+    // Metni son append bloğunun sonuna ekle
+    int block = appendBlock();
+    Buffer &tail = *added->back();
+    size_t add_start = tail.text.size();
+    tail.text += text;
+    ScanStats stats;
+    indexLines(tail.data(), add_start, tail.size(), tail.newlines, stats);
+    TextPiece new_piece = makePiece(block, add_start, text.size());
+
+    Rope::Location loc = pieces.findByOffset(offset);
+
+    if (offset == loc.offset)
+    {
+        // Ardışık yazma: önceki piece append buffer'ın sonunda bitiyorsa uzat
+        if (loc.index > 0)
+        {
+            TextPiece prev = pieces.at(loc.index - 1);
+            if (prev.buffer == block && prev.start + prev.length == add_start)
+            {
+                prev.length += new_piece.length;
+                prev.newlines += new_piece.newlines;
+                pieces.replace(loc.index - 1, prev);
+                return;
+            }
+        }
+        pieces.insert(loc.index, new_piece);
+    }
+    else
+    {
+        // Piece'i ikiye böl ve araya yeni piece'i koy
+        TextPiece old_piece = *loc.piece;
+        size_t split = offset - loc.offset;
+        pieces.replace(loc.index, makePiece(old_piece.buffer, old_piece.start, split));
+        pieces.insert(loc.index + 1, new_piece);
+        pieces.insert(loc.index + 2, makePiece(old_piece.buffer, old_piece.start + split, old_piece.length - split));
+    }
+}
+
+int TextDocument::appendBlock()
+{
+    // Kopyalar (anlık görüntü, checkpoint, bölünmüş panel) listeyi ve blokları paylaşır. Sadece bu belgenin
+    // tuttuğu son blok yerinde büyür; değilse liste kopyalanır (blok işaretçileri) ve yeni blok açılır
+    if (added.use_count() == 1 && !added->empty() && added->back().use_count() == 1)
+        return static_cast<int>(added->size());
+    if (added.use_count() != 1)
+        added = std::make_shared<Blocks>(*added);
+    added->push_back(std::make_shared<Buffer>());
+    return static_cast<int>(added->size());
+}
+
+void TextDocument::erase(size_t offset, size_t count)
+{
+    if (offset >= length() || count == 0)
+        return;
+    count = std::min(count, length() - offset);
+    size_t end = offset + count;
+    edits++;
+
+    Rope::Location loc = pieces.findByOffset(offset);
+    size_t index = loc.index;
+    size_t pos = loc.offset;
+
+    // Etkilenen piece'lerden sadece silinen aralığın dışında kalan kısımları bırak
+    while (pos < end && index < pieces.size())
+    {
+        TextPiece piece = pieces.at(index);
+        size_t piece_end = pos + piece.length;
+        bool keep_left = offset > pos;
+        bool keep_right = end < piece_end;
+
+        if (keep_left)
+        {
+            pieces.replace(index, makePiece(piece.buffer, piece.start, offset - pos));
+            index++;
+        }
+        if (keep_right)
+        {
+            TextPiece right = makePiece(piece.buffer, piece.start + (end - pos), piece_end - end);
+            if (keep_left)
+                pieces.insert(index, right);
+            else
+                pieces.replace(index, right);
+            index++;
+        }
+        if (!keep_left && !keep_right)
+            pieces.erase(index);
+
+        pos = piece_end;
+    }
+}
+
+void TextDocument::insertAt(int row, int col, const std::string &text)
+{
+    insert(offsetAt(row, col), text);
+}
+
+void TextDocument::eraseRange(int start_row, int start_col, int end_row, int end_col)
+{
+    size_t start = offsetAt(start_row, start_col);
+    size_t end = offsetAt(end_row, end_col);
+    if (end < start)
+        std::swap(start, end);
+    erase(start, end - start);
+}
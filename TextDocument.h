@@ -0,0 +1,164 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "LineIndex.h"
+#include "LineScanner.h"
+#include "MappedFile.h"
+#include "Rope.h"
+
+// Belgede tek değişiklik: offset'teki removed byte'ın yerine inserted byte geldi
+// (offset'leri belgeye bağlı yapıların kaydırılması için)
+struct TextChange
+{
+    size_t offset;
+    size_t removed;
+    size_t inserted;
+};
+
+// Piece table tabanlı metin belgesi
+// - original buffer: yüklenen içerik, hiç değişmez (dosyadan açıldıysa bellek eşlemeli)
+// - append blokları: sonradan eklenen metin, sadece sona eklenir; başka kopyanın da tuttuğu blok
+//   bir daha değişmez, ekleme yeni bloğa yapılır
+// - piece listesi: belgeyi bu iki buffer'daki aralıklarla tarif eder (B-tree Rope)
+// Buffer'lar ve rope node'ları kopyalar arasında paylaşılır, kopyalama O(1)'dir.
+// Satır <-> offset dönüşümleri ve düzenlemeler O(log n) çalışır.
+class TextDocument
+{
+public:
+    TextDocument();
+    explicit TextDocument(const std::string &text);
+
+    void setText(const std::string &text);
+
+    // Dosya işlemleri - dosya kopyalanmadan eşlenir, sadece satır indeksi oluşturulur
+    bool loadFile(const std::string &path);
+    bool saveFile(const std::string &path) const;
+
+    // Arka planda yükleme (FileLoader): belge boş başlar, indekslenen parçalar sırayla eklenir
+    void beginLoad(std::shared_ptr<MappedFile> mapping);
+    void appendLoaded(const LineIndex &newlines, const ScanStats &stats, bool finished);
+
+    // Başka bir thread'de okunacak kopya, O(1): paylaşılan bloklara bu belge bir daha yazmaz
+    TextDocument snapshot() const { return *this; }
+
+    // Satır sonu stili ("\n" ya da "\r\n"), yüklenen dosyadan algılanır
+    const std::string &eol() const { return line_ending; }
+
+    // Boyut bilgileri
+    size_t length() const { return pieces.bytes(); }
+    int lineCount() const { return static_cast<int>(pieces.newlines()) + 1; }
+    int lineLength(int row) const;
+    size_t pieceCount() const { return pieces.size(); }
+    int treeDepth() const { return pieces.depth(); }
+    // Her düzenlemede artar (yükleme sırasında sona eklenen parçalar hariç); offset'lerin geçerliliğini izlemek için
+    size_t revision() const { return edits; }
+    size_t indexMemory() const;
+
+    // Okuma
+    std::string getLine(int row) const;
+    void getLine(int row, std::string &out) const;
+    std::string getText() const;
+    std::string getText(size_t offset, size_t count) const;
+    char charAt(size_t offset) const;
+
+    // Satır tek bir piece içindeyse kopyalamadan buffer'ı gösterir, değilse scratch'e kopyalar
+    std::string_view lineView(int row, std::string &scratch) const;
+    // Satırın [column, column + count) sütunları; maliyet satırın uzunluğuna değil count'a bağlıdır
+    std::string_view lineView(int row, size_t column, size_t count, std::string &scratch) const;
+
+    // Satır/sütun <-> offset dönüşümleri
+    size_t lineStart(int row) const;
+    size_t lineEnd(int row) const;
+    size_t offsetAt(int row, int col) const;
+    void positionAt(size_t offset, int &row, int &col) const;
+
+    // Düzenleme
+    void insert(size_t offset, const std::string &text);
+    void erase(size_t offset, size_t count);
+    void insertAt(int row, int col, const std::string &text);
+    void eraseRange(int start_row, int start_col, int end_row, int end_col);
+    // Kaydedilmiş bir kopyaya (undo checkpoint'i) döner; revizyon geri gitmez, bir düzenleme gibi artar
+    void restore(const TextDocument &saved);
+
+    // [offset, offset + count) aralığını bitişik parçalar halinde ziyaret eder
+    template <typename Fn>
+    void forEachChunk(size_t offset, size_t count, Fn fn) const;
+    // Aynısı, fn false döndürünce durur
+    template <typename Fn>
+    void forEachChunkUntil(size_t offset, size_t count, Fn fn) const;
+
+private:
+    struct Buffer
+    {
+        std::string text;                    // heap içeriği (append bloğu, setText)
+        std::shared_ptr<MappedFile> mapping; // dosyadan açıldıysa eşlenmiş içerik
+        LineIndex newlines;                  // '\n' karakterlerinin buffer içindeki konumları
+
+        const char *data() const { return mapping ? mapping->data() : text.data(); }
+        size_t size() const { return mapping ? mapping->size() : text.size(); }
+    };
+
+    // piece.buffer: 0 original, n > 0 ise added'ın n - 1. bloğu
+    using Blocks = std::vector<std::shared_ptr<Buffer>>;
+
+    std::shared_ptr<Buffer> original;
+    std::shared_ptr<Blocks> added;
+    Rope pieces;
+    std::string line_ending;
+    ScanStats load_stats;
+    size_t loaded_bytes; // arka plan yüklemesinde belgeye eklenmiş original byte sayısı
+    size_t edits;
+
+    void resetPieces(const ScanStats &stats, size_t visible_length);
+    void lineBounds(int row, size_t &start, size_t &end) const;
+    int appendBlock();
+
+    const Buffer &bufferOf(int buffer) const { return buffer == 0 ? *original : *(*added)[buffer - 1]; }
+    const Buffer &bufferOf(const TextPiece &piece) const { return bufferOf(piece.buffer); }
+    TextPiece makePiece(int buffer, size_t start, size_t length) const;
+};
+
+template <typename Fn>
+void TextDocument::forEachChunk(size_t offset, size_t count, Fn fn) const
+{
+    size_t end = std::min(length(), offset + count);
+    if (offset >= end)
+        return;
+
+    Rope::Location loc = pieces.findByOffset(offset);
+    size_t pos = loc.offset;
+
+    pieces.forEachFrom(loc.index, [&](const TextPiece &piece)
+                       {
+        size_t piece_end = pos + piece.length;
+        size_t from = std::max(offset, pos);
+        size_t to = std::min(end, piece_end);
+        fn(bufferOf(piece).data() + piece.start + (from - pos), to - from);
+        pos = piece_end;
+        return pos < end; });
+}
+
+template <typename Fn>
+void TextDocument::forEachChunkUntil(size_t offset, size_t count, Fn fn) const
+{
+    size_t end = std::min(length(), offset + count);
+    if (offset >= end)
+        return;
+
+    Rope::Location loc = pieces.findByOffset(offset);
+    size_t pos = loc.offset;
+
+    pieces.forEachFrom(loc.index, [&](const TextPiece &piece)
+                       {
+        size_t piece_end = pos + piece.length;
+        size_t from = std::max(offset, pos);
+        size_t to = std::min(end, piece_end);
+        bool more = fn(bufferOf(piece).data() + piece.start + (from - pos), to - from);
+        pos = piece_end;
+        return more && pos < end; });
+}
@@ -1,11 +1,48 @@
 #include "TextEditor.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
 #include <cstring> // strcmp için
+#include <iomanip>
 #include <iostream>
 #include <sstream>
+#include "GdiRenderer.h"
+#include "TextView.h"
+#include "WorkspaceWalk.h"
+
+namespace
+{
+    // :find bu süreden eski indeksi arka planda tazeler (ms)
+    const DWORD INDEX_REFRESH_INTERVAL = 60 * 1000;
+    // Ctrl+P bu süreden eski yol listesini arka planda tazeler (ms)
+    const DWORD PATHS_REFRESH_INTERVAL = 30 * 1000;
+    // Hızlı dosya açma listesinde gösterilen en fazla sonuç
+    const int QUICK_OPEN_ROWS = 12;
+    // Undo/redo bundan fazla düzenleme uyguladıysa eşleşmeler güncellenmez, yeniden taranır
+    const size_t MAX_TRACKED_CHANGES = 256;
+    // Tekerlekle yumuşak kaydırma zamanlayıcısı (ms, ekran tazeleme hızına yakın)
+    const UINT_PTR SCROLL_TIMER_ID = 1;
+    const UINT SCROLL_TIMER_INTERVAL = 16;
+
+    // Renkler
+    const RenderColor BACKGROUND_COLOR = renderColor(0, 0, 0);      // Tam siyah arka plan
+    const RenderColor STATUS_COLOR = renderColor(0, 122, 204);      // Mavi status bar
+    const RenderColor CURSOR_COLOR = renderColor(255, 165, 0);      // Turuncu cursor
+    const RenderColor SELECTION_COLOR = renderColor(40, 62, 86);    // Seçim rengi
+    const RenderColor EXPLORER_COLOR = renderColor(30, 30, 30);     // Koyu gri file explorer
+    const RenderColor TERMINAL_COLOR = renderColor(20, 20, 20);     // Daha koyu terminal
+    const RenderColor QUICK_OPEN_COLOR = renderColor(37, 37, 38);   // Hızlı dosya açma kutusu
+    const RenderColor HIGHLIGHT_COLOR = renderColor(50, 100, 150);  // Seçili liste öğesi
+    const RenderColor LIST_TEXT_COLOR = renderColor(200, 200, 200); // Gri liste metni
+}
 
 ModernTextEditor::ModernTextEditor() : mode(INSERT_MODE), active_pane(0), split_direction(VERTICAL_SPLIT), shift_pressed(false), ctrl_pressed(false),
                                        showFileExplorer(true), showTerminal(true), fileExplorerWidth(200), terminalHeight(150),
-                                       search_mode(false), replace_mode(false), current_search_result(-1), max_undo_levels(10),
+                                       search_mode(false), replace_mode(false), search_ignore_case(false), search_use_regex(false),
+                                       replace_field(false), search_taken(0), search_scanned(0), search_visible_from(0), search_origin(0), search_revision(0),
+                                       search_pane(-1), search_jump_pending(false), search_generation(0), find_indexed(false), find_started(0), index_refreshed(0), paths_refreshed(0),
+                                       quick_open_mode(false), quick_open_previous(INSERT_MODE), quick_open_total(0), quick_open_selected(0), undo_budget(64 * 1024 * 1024), painted_valid(false),
+                                       wheel_pane(-1), wheel_remaining(0), wrap_lines(false),
                                        current_font_size(16)
 {
     // İlk pane'i oluştur
@@ -14,27 +51,12 @@ ModernTextEditor::ModernTextEditor() : mode(INSERT_MODE), active_pane(0), split_
 
     // Vector'lar için memory reserve et - Çok konservatif limitler
     panes.reserve(5);                // Maksimum 5 pane (daha az)
-    undo_stack.reserve(10);          // Undo stack için (daha az)
-    redo_stack.reserve(10);          // Redo stack için (daha az)
     terminal.output.reserve(50);     // Terminal output için (daha az)
     fileExplorer.items.reserve(100); // File explorer için (daha az)
 
     status_message = "INSERT MODE - Ctrl+C: Copy, Ctrl+V: Paste, Ctrl+A: Select All";
 
-    // Font oluştur - 0xNerd Proto kalın
-    hFont = CreateFont(current_font_size, 0, 0, 0, FW_BOLD, FALSE, FALSE, FALSE,
-                       ANSI_CHARSET, OUT_DEFAULT_PRECIS, CLIP_DEFAULT_PRECIS,
-                       CLEARTYPE_QUALITY, FIXED_PITCH | FF_MODERN, TEXT("0xNerd Proto"));
-
-    // Siyah arka plan ve renkler
-    bg_brush = CreateSolidBrush(RGB(0, 0, 0));           // Tam siyah arka plan
-    status_brush = CreateSolidBrush(RGB(0, 122, 204));   // Mavi status bar
-    cursor_brush = CreateSolidBrush(RGB(255, 165, 0));   // Turuncu cursor
-    selection_brush = CreateSolidBrush(RGB(40, 62, 86)); // Seçim rengi
-    explorer_brush = CreateSolidBrush(RGB(30, 30, 30));  // Koyu gri file explorer
-    terminal_brush = CreateSolidBrush(RGB(20, 20, 20));  // Daha koyu terminal
-
-    // Karakter boyutlarını hesapla
+    // Font seç (0xNerd Proto kalın) ve karakter boyutlarını hesapla
     calculateCharSize();
 
     // File explorer'ı başlat
@@ -48,13 +70,6 @@ ModernTextEditor::ModernTextEditor() : mode(INSERT_MODE), active_pane(0), split_
 
 ModernTextEditor::~ModernTextEditor()
 {
-    DeleteObject(hFont);
-    DeleteObject(bg_brush);
-    DeleteObject(status_brush);
-    DeleteObject(cursor_brush);
-    DeleteObject(selection_brush);
-    DeleteObject(explorer_brush);
-    DeleteObject(terminal_brush);
 }
 
 void ModernTextEditor::setHwnd(HWND h)
@@ -64,15 +79,10 @@ void ModernTextEditor::setHwnd(HWND h)
 
 void ModernTextEditor::calculateCharSize()
 {
-    HDC hdc = GetDC(NULL);
-    SelectObject(hdc, hFont);
-
-    TEXTMETRIC tm;
-    GetTextMetrics(hdc, &tm);
-    char_width = tm.tmAveCharWidth;
-    char_height = tm.tmHeight;
-
-    ReleaseDC(NULL, hdc);
+    // Yazı tipi ve glyph'leri boyut başına bir kez oluşturulur; boyutlar arasında geçiş yeniden rasterize etmez
+    const RenderResources::Font &font = resources.font(current_font_size);
+    char_width = font.char_width;
+    char_height = font.char_height;
 }
 
 void ModernTextEditor::updatePaneLayout()
@@ -138,6 +148,17 @@ void ModernTextEditor::updatePaneLayout()
             }
         }
     }
+
+    // Genişliği değişen (pencere, font, bölme, yan panel) ya da yeni açılan panellerde görünür satırlar hemen,
+    // kalanı arka planda yeniden kaydırılır
+    if (wrap_lines)
+    {
+        for (EditorPane &pane : panes)
+        {
+            if (pane.wrap.columns() != wrapColumns(pane))
+                startWrap(pane);
+        }
+    }
 }
 
 void ModernTextEditor::handleKeyPress(WPARAM wParam)
@@ -179,7 +200,17 @@ void ModernTextEditor::handleKeyPress(WPARAM wParam)
             performRedo();
             break;
         case 'F':
-            startSearch();
+            if (shift_pressed)
+            {
+                // Ctrl+Shift+F: dosyalarda ara
+                mode = COMMAND_MODE;
+                command_buffer = "find ";
+                status_message = ":" + command_buffer;
+            }
+            else
+            {
+                startSearch();
+            }
             break;
         case 'H':
             startReplace();
@@ -261,11 +292,9 @@ void ModernTextEditor::handleKeyPress(WPARAM wParam)
                 panes[active_pane].selection.clear();
 
             {
+                // Satır kaydırmada bir sayfa görsel satır cinsindendir (O(log n))
                 int visible_lines = (panes[active_pane].rect.bottom - panes[active_pane].rect.top - 60) / (char_height + 2);
-                panes[active_pane].cursor_row -= visible_lines;
-                if (panes[active_pane].cursor_row < 0)
-                    panes[active_pane].cursor_row = 0;
-                panes[active_pane].cursor_col = std::min(panes[active_pane].cursor_col, (int)panes[active_pane].lines[panes[active_pane].cursor_row].length());
+                moveCursorRows(panes[active_pane], -visible_lines);
                 ensureCursorVisible();
             }
             break;
@@ -277,10 +306,8 @@ void ModernTextEditor::handleKeyPress(WPARAM wParam)
 
             {
                 int visible_lines = (panes[active_pane].rect.bottom - panes[active_pane].rect.top - 60) / (char_height + 2);
-                panes[active_pane].cursor_row += visible_lines;
-                if (panes[active_pane].cursor_row >= static_cast<int>(panes[active_pane].lines.size()))
-                    panes[active_pane].cursor_row = static_cast<int>(panes[active_pane].lines.size()) - 1;
-                panes[active_pane].cursor_col = std::min(panes[active_pane].cursor_col, (int)panes[active_pane].lines[panes[active_pane].cursor_row].length());
+                waitForLines(panes[active_pane], panes[active_pane].cursor_row + 2 * visible_lines);
+                moveCursorRows(panes[active_pane], visible_lines);
                 ensureCursorVisible();
             }
             break;
@@ -299,7 +326,7 @@ void ModernTextEditor::handleKeyPress(WPARAM wParam)
             handleCommandMode(wParam);
     }
 
-    InvalidateRect(hwnd, NULL, FALSE);
+    invalidateChanges();
 }
 
 // Diğer fonksiyonlar buraya gelecek...
@@ -320,7 +347,7 @@ void ModernTextEditor::handleInsertMode(WPARAM wParam)
         else if (pane.cursor_row > 0)
         {
             pane.cursor_row--;
-            pane.cursor_col = pane.lines[pane.cursor_row].length();
+            pane.cursor_col = pane.document.lineLength(pane.cursor_row);
         }
         ensureCursorVisible();
         break;
@@ -331,11 +358,12 @@ void ModernTextEditor::handleInsertMode(WPARAM wParam)
         else
             pane.selection.clear();
 
-        if (pane.cursor_col < static_cast<int>(pane.lines[pane.cursor_row].length()))
+        waitForLines(pane, pane.cursor_row + 1);
+        if (pane.cursor_col < pane.document.lineLength(pane.cursor_row))
         {
             pane.cursor_col++;
         }
-        else if (pane.cursor_row < static_cast<int>(pane.lines.size()) - 1)
+        else if (pane.cursor_row < pane.document.lineCount() - 1)
         {
             pane.cursor_row++;
             pane.cursor_col = 0;
@@ -352,7 +380,7 @@ void ModernTextEditor::handleInsertMode(WPARAM wParam)
         if (pane.cursor_row > 0)
         {
             pane.cursor_row--;
-            pane.cursor_col = std::min(pane.cursor_col, (int)pane.lines[pane.cursor_row].length());
+            pane.cursor_col = std::min(pane.cursor_col, pane.document.lineLength(pane.cursor_row));
         }
         ensureCursorVisible();
         break;
@@ -363,10 +391,12 @@ void ModernTextEditor::handleInsertMode(WPARAM wParam)
         else
             pane.selection.clear();
 
-        if (pane.cursor_row < static_cast<int>(pane.lines.size()) - 1)
+        // Yüklenmemiş bölgeye inerken sadece o bölge hazır olana kadar bekle
+        waitForLines(pane, pane.cursor_row + 1);
+        if (pane.cursor_row < pane.document.lineCount() - 1)
         {
             pane.cursor_row++;
-            pane.cursor_col = std::min(pane.cursor_col, (int)pane.lines[pane.cursor_row].length());
+            pane.cursor_col = std::min(pane.cursor_col, pane.document.lineLength(pane.cursor_row));
         }
         ensureCursorVisible();
         break;
@@ -385,70 +415,76 @@ void ModernTextEditor::handleInsertMode(WPARAM wParam)
             updateSelection();
         else
             pane.selection.clear();
-        pane.cursor_col = pane.lines[pane.cursor_row].length();
+        pane.cursor_col = pane.document.lineLength(pane.cursor_row);
         ensureCursorVisible();
         break;
 
     case VK_BACK:
+        if (!canEdit())
+            break;
         if (pane.selection.hasSelection())
         {
             deleteSelection();
         }
         else if (pane.cursor_col > 0)
         {
-            saveUndoState("backspace");
-            pane.lines[pane.cursor_row].erase(pane.cursor_col - 1, 1);
+            saveUndoState("backspace", true);
+            size_t offset = pane.document.offsetAt(pane.cursor_row, pane.cursor_col);
+            editErase(pane, offset - 1, offset);
             pane.cursor_col--;
             pane.modified = true;
         }
         else if (pane.cursor_row > 0)
         {
-            saveUndoState("backspace line");
-            pane.cursor_col = pane.lines[pane.cursor_row - 1].length();
-            pane.lines[pane.cursor_row - 1] += pane.lines[pane.cursor_row];
-            pane.lines.erase(pane.lines.begin() + pane.cursor_row);
+            saveUndoState("backspace", true);
+            pane.cursor_col = pane.document.lineLength(pane.cursor_row - 1);
+            editErase(pane, pane.document.lineEnd(pane.cursor_row - 1), pane.document.lineStart(pane.cursor_row));
             pane.cursor_row--;
             pane.modified = true;
         }
         break;
 
     case VK_DELETE:
+        if (!canEdit())
+            break;
         if (pane.selection.hasSelection())
         {
             deleteSelection();
         }
-        else if (pane.cursor_col < static_cast<int>(pane.lines[pane.cursor_row].length()))
+        else if (pane.cursor_col < pane.document.lineLength(pane.cursor_row))
         {
-            saveUndoState("delete");
-            pane.lines[pane.cursor_row].erase(pane.cursor_col, 1);
+            saveUndoState("delete", true);
+            size_t offset = pane.document.offsetAt(pane.cursor_row, pane.cursor_col);
+            editErase(pane, offset, offset + 1);
             pane.modified = true;
         }
-        else if (pane.cursor_row < static_cast<int>(pane.lines.size()) - 1)
+        else if (pane.cursor_row < pane.document.lineCount() - 1)
         {
-            saveUndoState("delete line");
-            pane.lines[pane.cursor_row] += pane.lines[pane.cursor_row + 1];
-            pane.lines.erase(pane.lines.begin() + pane.cursor_row + 1);
+            saveUndoState("delete", true);
+            editErase(pane, pane.document.lineEnd(pane.cursor_row), pane.document.lineStart(pane.cursor_row + 1));
             pane.modified = true;
         }
         break;
 
     case VK_RETURN:
+        if (pane.find_results)
+        {
+            openFindResult();
+            break;
+        }
+        if (!canEdit())
+            break;
+
+        beginUndoGroup("new line");
         if (pane.selection.hasSelection())
             deleteSelection();
 
-        {
-            saveUndoState("new line");
-            std::string current_line = pane.lines[pane.cursor_row];
-            std::string left_part = current_line.substr(0, pane.cursor_col);
-            std::string right_part = current_line.substr(pane.cursor_col);
-
-            pane.lines[pane.cursor_row] = left_part;
-            pane.lines.insert(pane.lines.begin() + pane.cursor_row + 1, right_part);
+        editInsert(pane, pane.document.offsetAt(pane.cursor_row, pane.cursor_col), pane.document.eol());
+        endUndoGroup();
 
-            pane.cursor_row++;
-            pane.cursor_col = 0;
-            pane.modified = true;
-        }
+        pane.cursor_row++;
+        pane.cursor_col = 0;
+        pane.modified = true;
         break;
 
     case VK_TAB:
@@ -470,6 +506,70 @@ void ModernTextEditor::handleInsertMode(WPARAM wParam)
 
 void ModernTextEditor::handleCommandMode(WPARAM wParam)
 {
+    // Hızlı dosya açma: karakterler handleChar'dan gelir, burada liste gezintisi
+    if (quick_open_mode)
+    {
+        int count = static_cast<int>(quick_open_results.size());
+        if (wParam == VK_RETURN)
+        {
+            openQuickOpenResult();
+        }
+        else if (wParam == VK_ESCAPE)
+        {
+            closeQuickOpen();
+            status_message = "Quick open cancelled";
+        }
+        else if (wParam == VK_UP && count > 0)
+        {
+            quick_open_selected = (quick_open_selected + count - 1) % count;
+        }
+        else if (wParam == VK_DOWN && count > 0)
+        {
+            quick_open_selected = (quick_open_selected + 1) % count;
+        }
+        else if (wParam == VK_BACK && !quick_open_text.empty())
+        {
+            quick_open_text.pop_back();
+            updateQuickOpen();
+        }
+        return;
+    }
+
+    // Arama/değiştirme girişi: karakterler handleChar'dan gelir, burada sadece kontrol tuşları
+    if (search_mode || replace_mode)
+    {
+        if (wParam == VK_RETURN)
+        {
+            if (search_mode)
+                performSearch();
+            else
+                performReplace();
+        }
+        else if (wParam == VK_ESCAPE)
+        {
+            search_mode = false;
+            replace_mode = false;
+            clearSearchMatches();
+            status_message = "COMMAND MODE - Press ':' for commands";
+        }
+        else if (wParam == VK_BACK)
+        {
+            std::string &text = replace_field ? replace_text : search_text;
+            if (!text.empty())
+            {
+                text.pop_back();
+                if (!replace_field)
+                    updateIncrementalSearch();
+            }
+            else if (replace_field)
+            {
+                replace_field = false; // boş değiştirme alanından aranan metne dön
+            }
+            status_message = searchPrompt();
+        }
+        return;
+    }
+
     if (wParam == VK_ESCAPE)
     {
         // Sadece command buffer'ı temizle, mode değişmez
@@ -491,32 +591,7 @@ void ModernTextEditor::handleCommandMode(WPARAM wParam)
         return;
     }
 
-    // 'i' tuşuna basıldığında INSERT_MODE'a geç
-    if (wParam == 'I' && command_buffer.empty())
-    {
-        mode = INSERT_MODE;
-        status_message = "INSERT MODE - Ctrl+C: Copy, Ctrl+V: Paste, Ctrl+A: Select All";
-        return;
-    }
-
-    // Karakter girişi
-    if (wParam >= 'A' && wParam <= 'Z')
-    {
-        bool shift_pressed = (GetKeyState(VK_SHIFT) & 0x8000) != 0;
-        char ch = shift_pressed ? (char)wParam : (char)(wParam + 32);
-        command_buffer += ch;
-        status_message = ":" + command_buffer;
-    }
-    else if (wParam >= '0' && wParam <= '9')
-    {
-        command_buffer += (char)wParam;
-        status_message = ":" + command_buffer;
-    }
-    else if (wParam == VK_SPACE)
-    {
-        command_buffer += ' ';
-        status_message = ":" + command_buffer;
-    }
+    // Karakter girişi WM_CHAR ile handleChar'dan gelir ('/', '%' gibi semboller de dahil)
 }
 
 void ModernTextEditor::handleChar(WPARAM wParam)
@@ -525,27 +600,34 @@ void ModernTextEditor::handleChar(WPARAM wParam)
     if (terminal.isActive)
     {
         handleTerminalInput((char)wParam);
-        InvalidateRect(hwnd, NULL, FALSE);
+        invalidateChanges();
         return;
     }
 
-    if (search_mode && wParam != VK_RETURN && wParam != VK_ESCAPE)
+    if (quick_open_mode)
     {
-        search_text += (char)wParam;
-        status_message = "Search: " + search_text;
+        if (wParam >= 32 && wParam != 127)
+        {
+            quick_open_text += (char)wParam;
+            updateQuickOpen(); // her tuşta liste daraltılır
+        }
+        invalidateChanges();
     }
-    else if (replace_mode && wParam != VK_RETURN && wParam != VK_ESCAPE)
+    else if (search_mode || replace_mode)
     {
-        if (search_text.empty())
+        // Enter/Esc/Backspace handleCommandMode'da; Tab aranan metinden değiştirme metnine geçer
+        if (replace_mode && wParam == '\t')
         {
-            search_text += (char)wParam;
-            status_message = "Replace: " + search_text;
+            replace_field = true;
         }
-        else
+        else if (wParam >= 32 && wParam != 127)
         {
-            replace_text += (char)wParam;
-            status_message = "Replace: " + search_text + " -> " + replace_text;
+            (replace_field ? replace_text : search_text) += (char)wParam;
+            if (!replace_field)
+                updateIncrementalSearch(); // her tuşta eşleşmeler daraltılır
         }
+        status_message = searchPrompt();
+        invalidateChanges();
     }
     else if (mode == INSERT_MODE && wParam == ':')
     {
@@ -553,38 +635,51 @@ void ModernTextEditor::handleChar(WPARAM wParam)
         mode = COMMAND_MODE;
         command_buffer.clear();
         status_message = "COMMAND MODE - Type command and press Enter";
+        invalidateChanges();
+    }
+    else if (mode == COMMAND_MODE && wParam >= 32 && wParam != 127)
+    {
+        // 'i' boş komut satırında INSERT_MODE'a geçer
+        if (wParam == 'i' && command_buffer.empty())
+        {
+            mode = INSERT_MODE;
+            status_message = "INSERT MODE - Ctrl+C: Copy, Ctrl+V: Paste, Ctrl+A: Select All";
+            invalidateChanges();
+            return;
+        }
+        command_buffer += (char)wParam;
+        status_message = ":" + command_buffer;
+        invalidateChanges();
     }
     else if (mode == INSERT_MODE && wParam >= 32 && wParam <= 126)
     {
+        char ch = (char)wParam;
         if (panes[active_pane].selection.hasSelection())
+        {
+            // Seçimin üzerine yazmak tek adımda geri alınır
+            beginUndoGroup("insert text");
             deleteSelection();
-
-        char ch = (char)wParam;
-        insertText(std::string(1, ch));
-        InvalidateRect(hwnd, NULL, FALSE);
+            insertText(std::string(1, ch));
+            endUndoGroup();
+        }
+        else
+        {
+            // Ardışık yazma tek undo kaydında birleşir
+            insertText(std::string(1, ch));
+        }
+        invalidateChanges();
     }
 }
 
 void ModernTextEditor::insertText(const std::string &text)
 {
-    // Memory protection - çok büyük text insertion'ları engelley
-    if (text.length() > 500) // Daha küçük limit
-    {
-        status_message = "Text too large (max 500 chars)";
+    // Satır uzunluğu sınırı yok: çizim sadece görünür sütunları okur
+    if (!canEdit())
         return;
-    }
 
-    saveUndoState("insert text");
+    saveUndoState("insert text", true);
     EditorPane &pane = panes[active_pane];
-
-    // Line length protection
-    if (pane.lines[pane.cursor_row].length() + text.length() > 1000) // Daha kısa limit
-    {
-        status_message = "Line too long (max 1000 chars)";
-        return;
-    }
-
-    pane.lines[pane.cursor_row].insert(pane.cursor_col, text);
+    editInsert(pane, pane.document.offsetAt(pane.cursor_row, pane.cursor_col), text);
     pane.cursor_col += text.length();
     pane.modified = true;
     ensureCursorVisible();
@@ -611,8 +706,8 @@ void ModernTextEditor::selectAll()
     pane.selection.active = true;
     pane.selection.start_row = 0;
     pane.selection.start_col = 0;
-    pane.selection.end_row = pane.lines.size() - 1;
-    pane.selection.end_col = pane.lines.back().length();
+    pane.selection.end_row = pane.document.lineCount() - 1;
+    pane.selection.end_col = pane.document.lineLength(pane.selection.end_row);
 
     status_message = "All text selected";
 }
@@ -628,20 +723,14 @@ std::string ModernTextEditor::getSelectedText()
     int start_col = (pane.selection.start_row <= pane.selection.end_row) ? pane.selection.start_col : pane.selection.end_col;
     int end_col = (pane.selection.start_row <= pane.selection.end_row) ? pane.selection.end_col : pane.selection.start_col;
 
-    if (start_row == end_row)
-    {
-        return pane.lines[start_row].substr(start_col, end_col - start_col);
-    }
-
+    // Sadece seçili kısım okunur (çok uzun satırın tamamı kopyalanmaz)
     std::string result;
     for (int i = start_row; i <= end_row; i++)
     {
-        if (i == start_row)
-            result += pane.lines[i].substr(start_col);
-        else if (i == end_row)
-            result += pane.lines[i].substr(0, end_col);
-        else
-            result += pane.lines[i];
+        size_t from = pane.document.offsetAt(i, i == start_row ? start_col : 0);
+        size_t to = i == end_row ? pane.document.offsetAt(i, end_col) : pane.document.lineEnd(i);
+        if (to > from)
+            result += pane.document.getText(from, to - from);
 
         if (i < end_row)
             result += "\r\n";
@@ -662,6 +751,9 @@ void ModernTextEditor::copySelection()
 
 void ModernTextEditor::cutSelection()
 {
+    if (!canEdit())
+        return;
+
     std::string selected = getSelectedText();
     if (!selected.empty())
     {
@@ -674,7 +766,7 @@ void ModernTextEditor::cutSelection()
 void ModernTextEditor::deleteSelection()
 {
     EditorPane &pane = panes[active_pane];
-    if (!pane.selection.hasSelection())
+    if (!pane.selection.hasSelection() || !canEdit())
         return;
 
     saveUndoState("delete selection");
@@ -684,17 +776,7 @@ void ModernTextEditor::deleteSelection()
     int start_col = (pane.selection.start_row <= pane.selection.end_row) ? pane.selection.start_col : pane.selection.end_col;
     int end_col = (pane.selection.start_row <= pane.selection.end_row) ? pane.selection.end_col : pane.selection.start_col;
 
-    if (start_row == end_row)
-    {
-        pane.lines[start_row].erase(start_col, end_col - start_col);
-    }
-    else
-    {
-        pane.lines[start_row] = pane.lines[start_row].substr(0, start_col) +
-                                pane.lines[end_row].substr(end_col);
-        pane.lines.erase(pane.lines.begin() + start_row + 1,
-                         pane.lines.begin() + end_row + 1);
-    }
+    editErase(pane, pane.document.offsetAt(start_row, start_col), pane.document.offsetAt(end_row, end_col));
 
     pane.cursor_row = start_row;
     pane.cursor_col = start_col;
@@ -729,11 +811,14 @@ void ModernTextEditor::pasteFromClipboard()
             char *text = (char *)GlobalLock(hData);
             if (text)
             {
+                // Seçimi silme + yapıştırma tek undo adımı
+                beginUndoGroup("paste");
                 if (panes[active_pane].selection.hasSelection())
                     deleteSelection();
 
                 std::string paste_text = text;
                 insertMultilineText(paste_text);
+                endUndoGroup();
                 status_message = "Pasted from clipboard";
             }
             GlobalUnlock(hData);
@@ -745,28 +830,43 @@ void ModernTextEditor::pasteFromClipboard()
 void ModernTextEditor::insertMultilineText(const std::string &text)
 {
     EditorPane &pane = panes[active_pane];
-    std::istringstream iss(text);
-    std::string line;
-    bool first_line = true;
 
-    while (std::getline(iss, line))
+    if (text.empty() || !canEdit())
+        return;
+
+    // Satır sonlarını SIMD tarayıcıyla bul; clipboard CRLF getirir, belgenin stiline çevir
+    const std::string &eol = pane.document.eol();
+    std::vector<uint32_t> breaks;
+    ScanStats stats;
+    scanNewlines(detectScanner(), text.data(), 0, text.size(), breaks, stats);
+
+    bool same_style = (eol == "\r\n") ? stats.crlf == stats.newlines : stats.crlf == 0;
+    std::string normalized;
+    if (same_style)
     {
-        if (!first_line)
+        normalized = text;
+    }
+    else
+    {
+        normalized.reserve(text.size() + stats.newlines);
+        size_t line_start = 0;
+        for (uint32_t pos : breaks)
         {
-            // Yeni satır ekle
-            std::string current_line = pane.lines[pane.cursor_row];
-            std::string left_part = current_line.substr(0, pane.cursor_col);
-            std::string right_part = current_line.substr(pane.cursor_col);
-
-            pane.lines[pane.cursor_row] = left_part;
-            pane.lines.insert(pane.lines.begin() + pane.cursor_row + 1, right_part);
-            pane.cursor_row++;
-            pane.cursor_col = 0;
+            size_t line_end = (pos > line_start && text[pos - 1] == '\r') ? pos - 1 : pos;
+            normalized.append(text, line_start, line_end - line_start);
+            normalized += eol;
+            line_start = pos + 1;
         }
-
-        insertText(line);
-        first_line = false;
+        normalized.append(text, line_start, std::string::npos);
     }
+
+    // Tek seferde ekle - satır başına ayrı split yapmaya gerek yok
+    saveUndoState("paste");
+    size_t offset = pane.document.offsetAt(pane.cursor_row, pane.cursor_col);
+    editInsert(pane, offset, normalized);
+    pane.document.positionAt(offset + normalized.size(), pane.cursor_row, pane.cursor_col);
+    pane.modified = true;
+    ensureCursorVisible();
 }
 
 void ModernTextEditor::executeCommand()
@@ -796,6 +896,163 @@ void ModernTextEditor::executeCommand()
     {
         closePane();
     }
+    else if (command_buffer.substr(0, 8) == "earlier ")
+    {
+        undoTimeTravel(true, command_buffer.substr(8));
+    }
+    else if (command_buffer.substr(0, 6) == "later ")
+    {
+        undoTimeTravel(false, command_buffer.substr(6));
+    }
+    else if (command_buffer.substr(0, 9) == "undotime ")
+    {
+        // Bugünün HHMM ya da HHMMSS anındaki duruma dön
+        std::string digits = command_buffer.substr(9);
+        if ((digits.size() == 4 || digits.size() == 6) && std::all_of(digits.begin(), digits.end(),
+                        [](char c) { return isdigit(static_cast<unsigned char>(c)) != 0; }))
+        {
+            std::time_t now = std::time(nullptr);
+            std::tm target = *std::localtime(&now);
+            target.tm_hour = std::stoi(digits.substr(0, 2));
+            target.tm_min = std::stoi(digits.substr(2, 2));
+            target.tm_sec = digits.size() == 6 ? std::stoi(digits.substr(4, 2)) : 59;
+            jumpToUndoState(panes[active_pane].history.stateAt(std::mktime(&target)));
+        }
+        else
+        {
+            status_message = "Usage: undotime HHMM or HHMMSS";
+        }
+    }
+    else if (command_buffer == "undomem")
+    {
+        status_message = undoMemoryReport();
+    }
+    else if (command_buffer.substr(0, 11) == "undobudget ")
+    {
+        // Tüm belgelerin undo geçmişi için toplam bellek sınırı (MB)
+        try
+        {
+            int megabytes = std::stoi(command_buffer.substr(11));
+            if (megabytes > 0)
+            {
+                undo_budget = static_cast<size_t>(megabytes) * 1024 * 1024;
+                enforceUndoBudget();
+                status_message = undoMemoryReport();
+            }
+            else
+            {
+                status_message = "Undo budget must be positive";
+            }
+        }
+        catch (...)
+        {
+            status_message = "Invalid undo budget";
+        }
+    }
+    else if (command_buffer == "repaints")
+    {
+        status_message = repaintReport();
+    }
+    else if (command_buffer == "ignorecase" || command_buffer == "ic")
+    {
+        search_ignore_case = !search_ignore_case;
+        clearSearchMatches(); // eşleşmeler eski ayarla bulundu
+        status_message = search_ignore_case ? "Search ignores case" : "Search is case sensitive";
+    }
+    else if (command_buffer == "wrap")
+    {
+        // Kaydırma konumu görsel satırla belge satırı arasında dönüşür; imleç yerinde kalır
+        wrap_lines = !wrap_lines;
+        for (EditorPane &pane : panes)
+        {
+            pane.scroll_row = 0;
+            pane.scroll_left = 0;
+            pane.wrap_worker.reset();
+            if (wrap_lines)
+                startWrap(pane);
+        }
+        ensureCursorVisible();
+        InvalidateRect(hwnd, NULL, FALSE);
+        status_message = wrap_lines ? "Line wrapping on" : "Line wrapping off";
+    }
+    else if (command_buffer == "regex")
+    {
+        search_use_regex = !search_use_regex;
+        clearSearchMatches();
+        status_message = search_use_regex ? "Search uses regular expressions" : "Search uses literal text";
+    }
+    else if (command_buffer.substr(0, 5) == "find ")
+    {
+        startFindInFiles(command_buffer.substr(5));
+    }
+    else if (command_buffer == "reindex")
+    {
+        // Diskteki indeks atılır, ağaç baştan taranır
+        std::string root = trigram_index ? trigram_index->root() : fileExplorer.currentPath;
+        trigram_index.reset();
+        std::remove(TrigramIndex::indexPath(TrigramIndex::normalize(root)).c_str());
+        workspaceIndex(root);
+        refreshWorkspaceIndex();
+        status_message = "Rebuilding workspace index: " + root;
+    }
+    else if (command_buffer == "findstop")
+    {
+        if (find_search)
+        {
+            find_search->cancel(); // bitiş mesajı özeti yazar
+            status_message = "Find in files cancelled";
+        }
+    }
+    else if (command_buffer.substr(0, 3) == "%s/")
+    {
+        // :%s/eski/yeni/[i] - '/' ve '\\' ters bölüyle kaçırılır, yeni metinde \n satır sonudur
+        std::vector<std::string> fields(1);
+        for (size_t i = 3; i < command_buffer.size(); i++)
+        {
+            char ch = command_buffer[i];
+            if (ch == '\\' && i + 1 < command_buffer.size())
+            {
+                char escaped = command_buffer[++i];
+                if (escaped == '/' || (fields.size() == 2 && escaped == '\\'))
+                    fields.back() += escaped;
+                else if (fields.size() == 2 && escaped == 'n')
+                    fields.back() += panes[active_pane].document.eol();
+                else
+                    fields.back() += std::string(1, ch) + escaped; // düzenli ifade kaçışı olduğu gibi kalır
+            }
+            else if (ch == '/')
+            {
+                fields.push_back("");
+            }
+            else
+            {
+                fields.back() += ch;
+            }
+        }
+
+        bool flags_valid = fields.size() == 2 || (fields.size() == 3 && fields[2].find_first_not_of("iI") == std::string::npos);
+        if (fields[0].empty() || !flags_valid)
+        {
+            status_message = "Usage: %s/old/new/[i]";
+        }
+        else
+        {
+            bool ignore_case = search_ignore_case;
+            if (fields.size() == 3 && !fields[2].empty())
+                ignore_case = fields[2].back() == 'i'; // son bayrak geçerli
+            replaceAll(fields[0], fields[1], ignore_case);
+        }
+    }
+    else if (command_buffer.size() > 1 && command_buffer[0] == '/')
+    {
+        // :/desen - :regex ayarından bağımsız, düzenli ifadeyle ara
+        bool use_regex = search_use_regex;
+        search_use_regex = true;
+        search_text = command_buffer.substr(1);
+        clearSearchMatches();
+        performSearch();
+        search_use_regex = use_regex;
+    }
     else if (command_buffer.substr(0, 5) == "goto ")
     {
         // Go to line command
@@ -804,7 +1061,8 @@ void ModernTextEditor::executeCommand()
         {
             int lineNum = std::stoi(lineNumStr) - 1; // 1-based to 0-based
             EditorPane &pane = panes[active_pane];
-            if (lineNum >= 0 && lineNum < static_cast<int>(pane.lines.size()))
+            waitForLines(pane, lineNum);
+            if (lineNum >= 0 && lineNum < pane.document.lineCount())
             {
                 pane.cursor_row = lineNum;
                 pane.cursor_col = 0;
@@ -813,7 +1071,7 @@ void ModernTextEditor::executeCommand()
             }
             else
             {
-                status_message = "Line number out of range (1-" + std::to_string(pane.lines.size()) + ")";
+                status_message = "Line number out of range (1-" + std::to_string(pane.document.lineCount()) + ")";
             }
         }
         catch (...)
@@ -832,10 +1090,16 @@ void ModernTextEditor::executeCommand()
 
 void ModernTextEditor::verticalSplit()
 {
+    if (!canEdit())
+        return;
+
     EditorPane new_pane;
-    new_pane.lines = panes[active_pane].lines;
+    new_pane.document = panes[active_pane].document;
+    new_pane.history = panes[active_pane].history;
+    new_pane.history.attachJournal(nullptr); // günlük asıl panele ait, bu panel kaydederse devralır
     new_pane.filename = panes[active_pane].filename;
     panes.push_back(new_pane);
+    enforceUndoBudget();
     split_direction = VERTICAL_SPLIT;
     updatePaneLayout();
     status_message = "Vertical split created";
@@ -843,10 +1107,16 @@ void ModernTextEditor::verticalSplit()
 
 void ModernTextEditor::horizontalSplit()
 {
+    if (!canEdit())
+        return;
+
     EditorPane new_pane;
-    new_pane.lines = panes[active_pane].lines;
+    new_pane.document = panes[active_pane].document;
+    new_pane.history = panes[active_pane].history;
+    new_pane.history.attachJournal(nullptr); // günlük asıl panele ait, bu panel kaydederse devralır
     new_pane.filename = panes[active_pane].filename;
     panes.push_back(new_pane);
+    enforceUndoBudget();
     split_direction = HORIZONTAL_SPLIT;
     updatePaneLayout();
     status_message = "Horizontal split created";
@@ -856,6 +1126,12 @@ void ModernTextEditor::closePane()
 {
     if (panes.size() > 1)
     {
+        clearSearchMatches(); // panel indeksleri kayar
+        if (panes[active_pane].find_results)
+        {
+            find_search.reset(); // sonuç paneli kapanınca arama iptal
+            find_results.clear();
+        }
         panes.erase(panes.begin() + active_pane);
         if (static_cast<size_t>(active_pane) >= panes.size())
             active_pane = static_cast<int>(panes.size()) - 1;
@@ -925,61 +1201,141 @@ void ModernTextEditor::openFile()
 
 void ModernTextEditor::loadFile(const std::string &filename)
 {
-    FILE *file = fopen(filename.c_str(), "r");
-    if (file)
+    EditorPane &pane = panes[active_pane];
+
+    // Dosya belleğe eşlenir, satır indeksi arka planda parça parça oluşturulur
+    std::shared_ptr<MappedFile> mapping = MappedFile::open(filename);
+    if (!mapping)
     {
-        EditorPane &pane = panes[active_pane];
-        pane.lines.clear();
+        status_message = "Error opening file: " + filename;
+        return;
+    }
 
-        char line[2048]; // Buffer boyutunu sınırla
-        int lineCount = 0;
+    pane.loader.reset();
+    pane.document.beginLoad(mapping);
+    pane.history.clear();
+    pane.journal.reset();
+    pane.filename = filename;
+    pane.cursor_row = 0;
+    pane.cursor_col = 0;
+    pane.scroll_top = 0;
+    pane.scroll_row = 0;
+    pane.scroll_pixel = 0;
+    pane.scroll_left = 0;
+    pane.selection.clear();
+    pane.modified = false;
+    pane.find_results = false;
+
+    HWND target = hwnd;
+    pane.loader = std::make_shared<FileLoader>(mapping, [target]()
+                                               { PostMessage(target, WM_LOAD_PROGRESS, 0, 0); });
+    if (wrap_lines)
+        startWrap(pane); // yükleme sürerken ölçüm yapılmaz, eski belgenin ölçümü durur
+    status_message = "Loading: " + filename;
+
+    // İlk parça küçüktür - ilk ekran beklemeden çizilsin diye onu hemen al
+    pane.loader->waitForBatch();
+    drainLoader(pane);
+}
 
-        while (fgets(line, sizeof(line), file) && lineCount < 5000) // Maksimum 5000 satır
-        {
-            std::string str_line = line;
-            if (!str_line.empty() && str_line.back() == '\n')
-                str_line.pop_back();
-            if (!str_line.empty() && str_line.back() == '\r')
-                str_line.pop_back();
+void ModernTextEditor::handleLoadProgress()
+{
+    for (EditorPane &pane : panes)
+    {
+        if (pane.loader)
+            drainLoader(pane);
+    }
+    invalidateChanges();
+}
 
-            // Line length protection
-            if (str_line.length() > 1000) // Daha kısa satır limiti
-            {
-                str_line = str_line.substr(0, 1000) + "... [line truncated]";
-            }
+void ModernTextEditor::drainLoader(EditorPane &pane)
+{
+    std::vector<FileLoader::Batch> batches;
+    pane.loader->takeBatches(batches);
 
-            pane.lines.push_back(str_line);
-            lineCount++;
+    for (const FileLoader::Batch &batch : batches)
+    {
+        pane.document.appendLoaded(batch.newlines, batch.stats, batch.last);
+        if (batch.last)
+        {
+            pane.loader.reset();
+            status_message = "File loaded: " + pane.filename + " (" + std::to_string(pane.document.lineCount()) + " lines)";
+            openJournal(pane);
+            if (wrap_lines)
+                startWrap(pane); // yükleme sırasında eklenen satırlar şimdi arka planda ölçülür
         }
+    }
+}
 
-        if (pane.lines.empty())
-            pane.lines.push_back("");
-
-        pane.filename = filename;
-        pane.cursor_row = 0;
-        pane.cursor_col = 0;
-        pane.modified = false;
-
-        fclose(file);
-
-        if (lineCount >= 5000)
+void ModernTextEditor::openJournal(EditorPane &pane)
+{
+    // Dosya başka panelde açıksa onun günlüğü devralınır ve bu panelin geçmişiyle baştan yazılır.
+    // Değilse ve dosya son kaydedildiği haldeyse önceki oturumun geçmişi (ve çökme öncesi düzenlemeler) geri gelir
+    pane.journal = claimJournal(pane);
+    if (!pane.journal)
+    {
+        pane.journal = std::make_shared<UndoJournal>(pane.filename);
+        if (pane.journal->restore(pane.history, pane.document))
         {
-            status_message = "File loaded (truncated at 5000 lines): " + filename;
+            size_t redo = pane.history.redoCount();
+            status_message += " - " + std::to_string(pane.history.stateCount() - 1) + " undo states restored";
+            if (redo > 0)
+                status_message += ", " + std::to_string(redo) + " unsaved edits (Ctrl+Y)";
+            pane.history.attachJournal(pane.journal);
+            return;
         }
-        else
+    }
+    pane.journal->rewrite(pane.history, pane.document);
+    pane.history.attachJournal(pane.journal);
+}
+
+std::shared_ptr<UndoJournal> ModernTextEditor::claimJournal(EditorPane &pane)
+{
+    // Bir dosyanın tek günlüğü vardır ve tek panelin ağacını yazar; bölünmüş paneller ayrı dallanır,
+    // iki yazıcı aynı dosyaya karışık kayıt yazardı. Günlük başka paneldeyse o panelin geçmişi ondan ayrılır
+    std::string path = UndoJournal::journalPath(pane.filename);
+    if (pane.journal && pane.journal->path() == path)
+        return pane.journal;
+    for (EditorPane &other : panes)
+    {
+        if (&other != &pane && other.journal && other.journal->path() == path)
         {
-            status_message = "File loaded: " + filename;
+            other.history.attachJournal(nullptr);
+            return std::move(other.journal);
         }
     }
-    else
+    return nullptr;
+}
+
+void ModernTextEditor::waitForLines(EditorPane &pane, int row)
+{
+    // Yükleme sürerken son satır henüz tamamlanmamıştır; row tamamlanana ya da dosya bitene kadar bekle
+    while (pane.loader && row >= pane.document.lineCount() - 1)
     {
-        status_message = "Error opening file: " + filename;
+        pane.loader->waitForBatch();
+        drainLoader(pane);
     }
 }
 
+bool ModernTextEditor::canEdit()
+{
+    if (panes[active_pane].find_results)
+    {
+        status_message = "Find results are read-only (Enter opens a result)";
+        return false;
+    }
+    if (!panes[active_pane].loader)
+        return true;
+
+    status_message = "File is still loading (read-only)";
+    return false;
+}
+
 void ModernTextEditor::saveFile()
 {
     EditorPane &pane = panes[active_pane];
+    if (!canEdit())
+        return;
 
     if (pane.filename == "Untitled")
     {
@@ -1008,16 +1364,21 @@ void ModernTextEditor::saveFile()
         }
     }
 
-    FILE *file = fopen(pane.filename.c_str(), "w");
-    if (file)
+    if (pane.document.saveFile(pane.filename))
     {
-        for (const auto &line : pane.lines)
-        {
-            fprintf(file, "%s\n", line.c_str());
-        }
-        fclose(file);
         pane.modified = false;
         status_message = "File saved: " + pane.filename;
+
+        // Günlük artık kaydedilen içeriğe göre, kaydeden panelin geçmişiyle baştan yazılır
+        pane.journal = claimJournal(pane);
+        if (!pane.journal)
+            pane.journal = std::make_shared<UndoJournal>(pane.filename);
+        pane.history.attachJournal(pane.journal);
+        pane.journal->rewrite(pane.history, pane.document);
+
+        // İndeks kaydedilen dosyayı arka planda yeniden indeksler (arama değişikliği zaman damgasından zaten görür)
+        if (trigram_index)
+            trigram_index->updateFile(pane.filename);
     }
     else
     {
@@ -1025,99 +1386,91 @@ void ModernTextEditor::saveFile()
     }
 }
 
-void ModernTextEditor::paint(HDC hdc)
+void ModernTextEditor::paint(HDC hdc, const RECT &area)
 {
     RECT client_rect;
     GetClientRect(hwnd, &client_rect);
+    unsigned long long allocations = resources.allocations();
 
-    // TAMAMEN SİYAH YAP - ZORLA!
-    HBRUSH pure_black = CreateSolidBrush(RGB(0, 0, 0));
-    FillRect(hdc, &client_rect, pure_black);
-
-    // Tüm HDC'yi siyah yap
-    SetBkMode(hdc, OPAQUE);
-    SetBkColor(hdc, RGB(0, 0, 0));
-
-    // Font seç
-    SelectObject(hdc, hFont);
+    // Kalıcı arka tampona çizilip pencereye kopyalanır (boyut değişmedikçe yeniden oluşturulmaz).
+    // Sadece geçersiz kılınan alan çizilir; dışında kalan bölümler ve satırlar atlanır
+    HDC back_buffer = resources.backBuffer(hdc, client_rect.right, client_rect.bottom);
+    GdiRenderer renderer(back_buffer, *resources.font(current_font_size).atlas);
+    renderer.setClip(renderRect(area));
+    renderer.fillRect(renderRect(area), BACKGROUND_COLOR);
+    RECT overlap;
 
     // File Explorer çiz (sol taraf)
-    if (showFileExplorer)
+    if (showFileExplorer && IntersectRect(&overlap, &fileExplorer.rect, &area))
     {
-        drawFileExplorer(hdc);
+        drawFileExplorer(renderer);
     }
 
     // Editor panes çiz (orta alan)
+    int lines = 0;
     for (size_t i = 0; i < panes.size(); i++)
     {
-        // Pane alanını da zorla siyah yap
-        FillRect(hdc, &panes[i].rect, pure_black);
-        drawPane(hdc, panes[i], static_cast<int>(i));
+        syncWrap(panes[i]); // ölçüm başlatmaz, yalnız yükleme sırasında satır sayısını eşitler
+        wrapVisibleLines(panes[i]);
+        if (IntersectRect(&overlap, &panes[i].rect, &area))
+            lines += drawPane(renderer, panes[i], static_cast<int>(i), overlap);
     }
 
     // Terminal çiz (alt kısım)
-    if (showTerminal)
+    if (showTerminal && IntersectRect(&overlap, &terminal.rect, &area))
     {
-        drawTerminal(hdc);
+        drawTerminal(renderer);
     }
 
-    // Status bar çiz
-    drawStatusBar(hdc);
-
-    DeleteObject(pure_black);
-}
-
-void ModernTextEditor::drawPane(HDC hdc, const EditorPane &pane, int pane_index)
-{
-    // PANE'İ TAMAMEN SİYAH YAP
-    HBRUSH total_black = CreateSolidBrush(RGB(0, 0, 0));
-    FillRect(hdc, &pane.rect, total_black);
-
-    // HDC ayarları - HER ŞEY SİYAH ARKA PLAN
-    SetBkMode(hdc, OPAQUE);
-    SetBkColor(hdc, RGB(0, 0, 0));
-
-    // Metin içeriğini çiz
-    int line_y = pane.rect.top + 30;
-    int line_height = char_height + 2;
-
-    for (size_t i = static_cast<size_t>(pane.scroll_top);
-         i < pane.lines.size() && line_y < pane.rect.bottom - line_height;
-         i++)
+    // Hızlı dosya açma listesi panellerin üstünde
+    RECT quick_open_rect = quickOpenRect(quick_open_results.size());
+    if (quick_open_mode && IntersectRect(&overlap, &quick_open_rect, &area))
     {
-        const std::string &line = pane.lines[i];
-
-        // TAMAMEN SİYAH SATIR ARKA PLANI
-        RECT full_line = {pane.rect.left, line_y, pane.rect.right, line_y + line_height};
-        FillRect(hdc, &full_line, total_black);
-
-        // Turuncu satır numarası
-        SetTextColor(hdc, RGB(255, 165, 0));
-        std::string line_num = std::to_string(i + 1);
-        while (line_num.length() < 4)
-            line_num = " " + line_num;
-        TextOutA(hdc, pane.rect.left + 5, line_y, line_num.c_str(), line_num.length());
+        drawQuickOpen(renderer);
+    }
 
-        // Linux terminal yeşili metin
-        SetTextColor(hdc, RGB(0, 255, 0));
-        int text_x = pane.rect.left + 50;
-        TextOutA(hdc, text_x, line_y, line.c_str(), line.length());
+    // Status bar çiz
+    RECT status_rect = statusBarRect();
+    if (IntersectRect(&overlap, &status_rect, &area))
+    {
+        drawStatusBar(renderer);
+    }
 
-        // Cursor çiz
-        if (pane.is_active && static_cast<int>(i) == pane.cursor_row)
-        {
-            int cursor_x = text_x + (pane.cursor_col * char_width);
-            RECT cursor_rect = {cursor_x, line_y, cursor_x + 2, line_y + line_height};
-            FillRect(hdc, &cursor_rect, cursor_brush);
-        }
+    BitBlt(hdc, area.left, area.top, area.right - area.left, area.bottom - area.top, back_buffer, area.left, area.top,
+           SRCCOPY);
 
-        line_y += line_height;
+    // Ekrandaki durum artık bu; sonraki değişiklikler buna göre geçersiz kılınır
+    painted = captureView();
+    painted_valid = true;
+    for (EditorPane &pane : panes)
+    {
+        pane.dirty_first = INT_MAX;
+        pane.dirty_last = -1;
     }
 
-    DeleteObject(total_black);
+    repaint_stats.frames++;
+    repaint_stats.last_lines = lines;
+    repaint_stats.last_pixels = static_cast<long long>(area.right - area.left) * (area.bottom - area.top);
+    repaint_stats.window_pixels = static_cast<long long>(client_rect.right) * client_rect.bottom;
+    repaint_stats.lines += lines;
+    repaint_stats.pixels += repaint_stats.last_pixels;
+    repaint_stats.last_allocations = resources.allocations() - allocations;
+    repaint_stats.allocations += repaint_stats.last_allocations;
+}
+
+int ModernTextEditor::drawPane(Renderer &renderer, const EditorPane &pane, int pane_index, const RECT &area)
+{
+    // Yükleme sürerken son satır yarımdır, tamamlanınca çizilir.
+    // Eşleşmeler sadece belgenin taranan haline aitse vurgulanır
+    bool highlight = pane_index == search_pane && pane.document.revision() == search_revision;
+    TextView view = {renderRect(pane.rect), pane.scroll_top, pane.scroll_row, pane.scroll_pixel, pane.scroll_left,
+                     pane.cursor_row, pane.cursor_col, pane.is_active, pane.loader != nullptr,
+                     highlight ? &search_matches : nullptr, char_width, char_height,
+                     wrap_lines ? &pane.wrap : nullptr};
+    return drawTextView(renderer, pane.document, view, renderRect(area));
 }
 
-void ModernTextEditor::drawSelection(HDC hdc, const EditorPane &pane, int current_line, int line_y)
+void ModernTextEditor::drawSelection(Renderer &renderer, const EditorPane &pane, int current_line, int line_y)
 {
     if (!pane.selection.hasSelection())
         return;
@@ -1130,33 +1483,29 @@ void ModernTextEditor::drawSelection(HDC hdc, const EditorPane &pane, int curren
     if (current_line < start_row || current_line > end_row)
         return;
 
-    int text_x = pane.rect.left + 50;
+    int text_x = pane.rect.left + 50 - pane.scroll_left * char_width;
     int sel_start = text_x;
-    int sel_end = text_x + pane.lines[current_line].length() * char_width;
+    int sel_end = text_x + pane.document.lineLength(current_line) * char_width;
 
     if (current_line == start_row)
         sel_start = text_x + (start_col * char_width);
     if (current_line == end_row)
         sel_end = text_x + (end_col * char_width);
+    sel_start = std::max(sel_start, static_cast<int>(pane.rect.left) + 50);
 
-    RECT sel_rect = {sel_start, line_y, sel_end, line_y + char_height + 2};
-    FillRect(hdc, &sel_rect, selection_brush);
+    renderer.fillRect(RenderRect{sel_start, line_y, sel_end, line_y + char_height + 2}, SELECTION_COLOR);
 }
 
-void ModernTextEditor::drawStatusBar(HDC hdc)
+RECT ModernTextEditor::statusBarRect()
 {
-    RECT client_rect;
-    GetClientRect(hwnd, &client_rect);
-
-    RECT status_rect = client_rect;
-    status_rect.top = client_rect.bottom - (char_height + 10);
-
-    FillRect(hdc, &status_rect, status_brush);
-
-    SetBkMode(hdc, OPAQUE);
-    SetTextColor(hdc, RGB(255, 255, 255));
-    SetBkColor(hdc, RGB(0, 122, 204)); // Status bar arka planı mavi
+    RECT status_rect;
+    GetClientRect(hwnd, &status_rect);
+    status_rect.top = status_rect.bottom - (char_height + 10);
+    return status_rect;
+}
 
+std::string ModernTextEditor::statusText(std::string &mode_info)
+{
     EditorPane &current_pane = panes[active_pane];
     std::string left_status = "Ln " + std::to_string(current_pane.cursor_row + 1) +
                               ", Col " + std::to_string(current_pane.cursor_col + 1);
@@ -1165,27 +1514,221 @@ void ModernTextEditor::drawStatusBar(HDC hdc)
     {
         left_status = ":" + command_buffer;
     }
-    else if (mode == INSERT_MODE)
+    else
     {
         left_status += " | " + status_message;
+        std::string counter = searchCounter();
+        if (!counter.empty())
+            left_status += " | " + counter;
     }
 
-    TextOutA(hdc, 10, status_rect.top + 5, left_status.c_str(), left_status.length());
+    if (current_pane.loader)
+    {
+        left_status += " | Loading " + std::to_string(current_pane.loader->progressPercent()) + "% (" +
+                       std::to_string(current_pane.document.lineCount() - 1) + " lines)";
+    }
 
-    std::string mode_info = (mode == INSERT_MODE) ? "-- INSERT --" : "-- COMMAND --";
+    mode_info = (mode == INSERT_MODE) ? "-- INSERT --" : "-- COMMAND --";
     if (mode == COMMAND_MODE && !command_buffer.empty())
     {
         mode_info = "-- COMMAND: " + command_buffer + " --";
     }
-    SIZE text_size;
-    GetTextExtentPoint32A(hdc, mode_info.c_str(), mode_info.length(), &text_size);
-    TextOutA(hdc, client_rect.right - text_size.cx - 10, status_rect.top + 5,
-             mode_info.c_str(), mode_info.length());
+    return left_status;
+}
+
+void ModernTextEditor::drawStatusBar(Renderer &renderer)
+{
+    RECT status_rect = statusBarRect();
+    renderer.fillRect(renderRect(status_rect), STATUS_COLOR);
+
+    // Beyaz yazı, status bar arka planı mavi
+    const RenderColor text_color = renderColor(255, 255, 255);
+    std::string mode_info;
+    std::string left_status = statusText(mode_info);
+    renderer.drawText(10, status_rect.top + 5, left_status.c_str(), left_status.length(), text_color, STATUS_COLOR);
+
+    int mode_width = renderer.textWidth(mode_info.c_str(), mode_info.length());
+    renderer.drawText(status_rect.right - mode_width - 10, status_rect.top + 5, mode_info.c_str(), mode_info.length(),
+                      text_color, STATUS_COLOR);
+}
+
+ViewState ModernTextEditor::captureView()
+{
+    ViewState view;
+    for (const EditorPane &pane : panes)
+    {
+        view.panes.push_back({pane.rect, pane.scroll_top, pane.scroll_row, pane.scroll_pixel, pane.scroll_left, pane.cursor_row, pane.cursor_col, pane.document.lineCount(),
+                              pane.document.revision(), pane.is_active});
+    }
+    view.show_explorer = showFileExplorer;
+    view.show_terminal = showTerminal;
+    view.font_size = current_font_size;
+    view.quick_open = quick_open_mode;
+    view.quick_open_text = quick_open_text;
+    view.quick_open_rows = quick_open_results.size();
+    view.quick_open_selected = quick_open_selected;
+    view.search_pane = search_pane;
+    view.search_generation = search_generation;
+    std::string mode_info;
+    view.status = statusText(mode_info) + mode_info;
+    view.explorer_selected = fileExplorer.selectedIndex;
+    view.explorer_scroll = fileExplorer.scrollTop;
+    view.explorer_items = fileExplorer.items.size();
+    view.explorer_path = fileExplorer.currentPath;
+    view.terminal_lines = terminal.output.size();
+    view.terminal_scroll = terminal.scrollTop;
+    view.terminal_active = terminal.isActive;
+    view.terminal_input = terminal.currentInput;
+    return view;
+}
+
+void ModernTextEditor::markDirtyRows(EditorPane &pane, int first, int last)
+{
+    pane.dirty_first = std::min(pane.dirty_first, first);
+    pane.dirty_last = std::max(pane.dirty_last, last);
+}
+
+void ModernTextEditor::invalidateRows(const EditorPane &pane, int first, int last)
+{
+    // Satırlar panelin satır alanına kırpılır (last INT_MAX olabilir: panelin sonuna kadar)
+    int line_height = char_height + 2;
+    RenderRect viewport = textViewport(renderRect(pane.rect), char_height);
+    int visible_lines = (viewport.bottom - viewport.top) / line_height + 1;
+    first = std::max(first, pane.scroll_top);
+    last = std::min(last, pane.scroll_top + visible_lines);
+    if (last < first)
+        return;
+
+    // Satır kaydırmada satır birden çok görsel satır tutar; son satırdan sonrası (silinen satırlar) da çizilir
+    long long top = static_cast<long long>(visualRow(pane, pane.scroll_top, 0)) + pane.scroll_row;
+    long long from = static_cast<long long>(visualRow(pane, first, 0)) - top;
+    int line_y = viewport.top - pane.scroll_pixel;
+    RECT rows = pane.rect;
+    rows.top = static_cast<LONG>(std::max<long long>(viewport.top, line_y + from * line_height));
+    rows.bottom = viewport.bottom;
+    if (last < pane.document.lineCount() - 1)
+    {
+        long long to = static_cast<long long>(visualRow(pane, last + 1, 0)) - top;
+        rows.bottom = static_cast<LONG>(std::min<long long>(viewport.bottom, line_y + to * line_height));
+    }
+    if (rows.top < rows.bottom)
+        InvalidateRect(hwnd, &rows, FALSE);
+}
+
+void ModernTextEditor::invalidateChanges()
+{
+    ViewState view = captureView();
+
+    // İlk çizim ya da yerleşim değişti: tüm pencere
+    if (!painted_valid || view.panes.size() != painted.panes.size() || view.show_explorer != painted.show_explorer ||
+        view.show_terminal != painted.show_terminal || view.font_size != painted.font_size)
+    {
+        InvalidateRect(hwnd, NULL, FALSE);
+        return;
+    }
+
+    for (size_t i = 0; i < panes.size(); i++)
+    {
+        const PaneView &before = painted.panes[i];
+        const PaneView &now = view.panes[i];
+        EditorPane &pane = panes[i];
+
+        // Boyutu değişen, yatay kayan, aktifliği değişen ya da eşleşmeleri yeniden hesaplanan panel tamamen çizilir
+        bool search_changed = view.search_generation != painted.search_generation &&
+                              (static_cast<int>(i) == view.search_pane || static_cast<int>(i) == painted.search_pane);
+        if (!EqualRect(&before.rect, &now.rect) || before.scroll_left != now.scroll_left ||
+            before.is_active != now.is_active || search_changed)
+        {
+            InvalidateRect(hwnd, &pane.rect, FALSE);
+            continue;
+        }
+
+        // Kayan panelde ekrandaki pikseller kaydırılır, sadece açılan şerit çizilir; olmazsa panelin tamamı
+        int line_height = char_height + 2;
+        long long scrolled =
+            (static_cast<long long>(visualRow(pane, before.scroll_top, 0)) + before.scroll_row -
+             static_cast<long long>(visualRow(pane, now.scroll_top, 0)) - now.scroll_row) * line_height +
+            before.scroll_pixel - now.scroll_pixel;
+        if (scrolled != 0 && (std::llabs(scrolled) > pane.rect.bottom - pane.rect.top ||
+                              !scrollPixels(pane, static_cast<int>(scrolled))))
+        {
+            InvalidateRect(hwnd, &pane.rect, FALSE);
+            continue;
+        }
+        painted.panes[i].scroll_top = now.scroll_top; // ekran artık yeni konumda; tekrar kaydırılmaz
+        painted.panes[i].scroll_row = now.scroll_row;
+        painted.panes[i].scroll_pixel = now.scroll_pixel;
+
+        // Düzenlenen satırlar; satır sayısı değiştiyse alttakiler de kayar
+        if (before.revision != now.revision)
+        {
+            if (pane.dirty_first > pane.dirty_last)
+            {
+                InvalidateRect(hwnd, &pane.rect, FALSE); // nereden geldiği bilinmeyen değişiklik
+                continue;
+            }
+            invalidateRows(pane, pane.dirty_first, before.line_count != now.line_count ? INT_MAX : pane.dirty_last);
+        }
+        else if (before.line_count != now.line_count)
+        {
+            invalidateRows(pane, before.line_count - 2, INT_MAX); // yükleme: yarım kalan son satırdan itibaren
+        }
+
+        // İmlecin eski ve yeni satırı (imleçteki eşleşmenin rengi de değişir)
+        if (before.cursor_row != now.cursor_row || before.cursor_col != now.cursor_col)
+        {
+            invalidateRows(pane, before.cursor_row, before.cursor_row);
+            invalidateRows(pane, now.cursor_row, now.cursor_row);
+        }
+    }
+
+    if (view.status != painted.status)
+    {
+        RECT status_rect = statusBarRect();
+        InvalidateRect(hwnd, &status_rect, FALSE);
+    }
+
+    if (view.show_explorer &&
+        (view.explorer_selected != painted.explorer_selected || view.explorer_scroll != painted.explorer_scroll ||
+         view.explorer_items != painted.explorer_items || view.explorer_path != painted.explorer_path))
+        InvalidateRect(hwnd, &fileExplorer.rect, FALSE);
+
+    if (view.show_terminal &&
+        (view.terminal_lines != painted.terminal_lines || view.terminal_scroll != painted.terminal_scroll ||
+         view.terminal_active != painted.terminal_active || view.terminal_input != painted.terminal_input))
+        InvalidateRect(hwnd, &terminal.rect, FALSE);
+
+    // Hızlı dosya açma kutusu: eski ve yeni hali (kapanınca altında kalan paneller yeniden çizilir)
+    if (view.quick_open != painted.quick_open ||
+        (view.quick_open && (view.quick_open_text != painted.quick_open_text ||
+                             view.quick_open_rows != painted.quick_open_rows ||
+                             view.quick_open_selected != painted.quick_open_selected)))
+    {
+        RECT before = quickOpenRect(painted.quick_open_rows);
+        RECT now = quickOpenRect(view.quick_open_rows);
+        InvalidateRect(hwnd, &before, FALSE);
+        InvalidateRect(hwnd, &now, FALSE);
+    }
+}
+
+std::string ModernTextEditor::repaintReport()
+{
+    if (repaint_stats.frames == 0 || repaint_stats.window_pixels == 0)
+        return "No frames painted yet";
+
+    std::ostringstream report;
+    report << std::fixed << std::setprecision(1) << "Last frame: " << repaint_stats.last_lines << " lines, "
+           << repaint_stats.last_pixels << " px (" << 100.0 * repaint_stats.last_pixels / repaint_stats.window_pixels
+           << "% of window) | avg " << static_cast<double>(repaint_stats.lines) / repaint_stats.frames << " lines, "
+           << 100.0 * repaint_stats.pixels / repaint_stats.frames / repaint_stats.window_pixels << "% over "
+           << repaint_stats.frames << " frames | resource allocations: " << repaint_stats.last_allocations
+           << " last frame, " << repaint_stats.allocations << " total";
+    return report.str();
 }
 
 void ModernTextEditor::handleResize()
 {
-    updatePaneLayout();
+    updatePaneLayout(); // genişliği değişen paneller burada yeniden kaydırılır
     InvalidateRect(hwnd, NULL, FALSE);
 }
 
@@ -1228,30 +1771,145 @@ void ModernTextEditor::handleMouseClick(int x, int y)
 
             if (x >= text_x && y >= line_y)
             {
-                int clicked_line = (y - line_y) / line_height + panes[i].scroll_top;
+                // Tıklanan görsel satır; satır kaydırmada satırın kaçıncı parçası olduğu sütunu belirler
+                EditorPane &pane = panes[i];
+                syncWrap(pane);
+                size_t clicked = visualRow(pane, pane.scroll_top, 0) + pane.scroll_row +
+                                 (y - line_y + pane.scroll_pixel) / line_height;
                 int clicked_col = (x - text_x) / char_width;
 
-                if (clicked_line >= 0 && static_cast<size_t>(clicked_line) < panes[i].lines.size())
+                if (clicked < totalVisualRows(pane))
                 {
-                    panes[i].cursor_row = clicked_line;
-                    panes[i].cursor_col = std::min(clicked_col, (int)panes[i].lines[clicked_line].length());
+                    int sub_row = 0;
+                    int clicked_line = wrap_lines ? pane.wrap.lineAt(clicked, sub_row) : static_cast<int>(clicked);
+                    clicked_col += wrap_lines ? sub_row * pane.wrap.columns() : pane.scroll_left;
+                    pane.cursor_row = clicked_line;
+                    pane.cursor_col = std::min(clicked_col, pane.document.lineLength(clicked_line));
                     ensureCursorVisible();
                 }
             }
 
-            InvalidateRect(hwnd, NULL, FALSE);
+            invalidateChanges();
             break;
         }
     }
 }
 
+void ModernTextEditor::handleMouseWheel(int delta, int x, int y)
+{
+    // Tekerlek ekran koordinatı verir; altındaki panel kayar, aktif panel değişmez
+    POINT point = {x, y};
+    ScreenToClient(hwnd, &point);
+    int target = -1;
+    for (size_t i = 0; i < panes.size(); i++)
+    {
+        if (PtInRect(&panes[i].rect, point))
+            target = static_cast<int>(i);
+    }
+    if (target < 0)
+        return;
+
+    UINT wheel_lines = 3;
+    SystemParametersInfoA(SPI_GETWHEELSCROLLLINES, 0, &wheel_lines, 0);
+    if (wheel_lines == 0 || wheel_lines > 100)
+        wheel_lines = 3; // WHEEL_PAGESCROLL ve kapalı ayar
+
+    // Kaydırma anında yapılmaz; kalan mesafe zamanlayıcıyla birkaç karede azalarak uygulanır
+    if (target != wheel_pane)
+        wheel_remaining = 0;
+    wheel_pane = target;
+    wheel_remaining -= delta * static_cast<int>(wheel_lines) * (char_height + 2) / WHEEL_DELTA;
+    SetTimer(hwnd, SCROLL_TIMER_ID, SCROLL_TIMER_INTERVAL, NULL);
+}
+
+void ModernTextEditor::handleTimer(UINT_PTR id)
+{
+    if (id != SCROLL_TIMER_ID)
+        return;
+
+    if (wheel_pane < 0 || wheel_pane >= static_cast<int>(panes.size()) || wheel_remaining == 0)
+    {
+        KillTimer(hwnd, SCROLL_TIMER_ID);
+        wheel_remaining = 0;
+        return;
+    }
+
+    // Kalanın dörtte biri (en az 1 piksel): hızlı başlar, yavaşlayarak durur
+    int step = wheel_remaining / 4;
+    if (step == 0)
+        step = wheel_remaining > 0 ? 1 : -1;
+    wheel_remaining -= step;
+
+    EditorPane &pane = panes[wheel_pane];
+    int before_top = pane.scroll_top;
+    int before_pixel = pane.scroll_pixel;
+    scrollPane(pane, step);
+    if (pane.scroll_top == before_top && pane.scroll_pixel == before_pixel)
+        wheel_remaining = 0; // belgenin başı ya da sonu
+    invalidateChanges();
+}
+
+void ModernTextEditor::scrollPane(EditorPane &pane, int pixels)
+{
+    // İlk görsel satır ve piksel kayması tek piksel konumu olarak ele alınır; son sayfada durulur
+    syncWrap(pane);
+    int line_height = char_height + 2;
+    long long visible_lines = (pane.rect.bottom - pane.rect.top - 60) / line_height;
+    long long max_scroll = std::max(static_cast<long long>(totalVisualRows(pane)) - visible_lines, 0LL);
+    long long top = static_cast<long long>(visualRow(pane, pane.scroll_top, 0)) + pane.scroll_row;
+    long long position = top * line_height + pane.scroll_pixel + pixels;
+    position = std::max(0LL, std::min(position, max_scroll * line_height));
+    setTopVisualRow(pane, static_cast<size_t>(position / line_height));
+    pane.scroll_pixel = static_cast<int>(position % line_height);
+}
+
+bool ModernTextEditor::scrollPixels(const EditorPane &pane, int dy)
+{
+    // Ekrandaki ve arka tampondaki satır alanı aynı miktarda kaydırılır; açılan şerit geçersiz kılınır.
+    // Ekranla arka tamponun aynı olduğundan emin olunamıyorsa (bekleyen çizim, üstteki kutu, yeni tampon) kaydırılmaz
+    RECT client_rect;
+    GetClientRect(hwnd, &client_rect);
+    RenderRect viewport = textViewport(renderRect(pane.rect), char_height);
+    HDC back_buffer = resources.existingBackBuffer(client_rect.right, client_rect.bottom);
+    if (!back_buffer || std::abs(dy) >= viewport.bottom - viewport.top)
+        return false;
+
+    RECT overlap;
+    RECT pending;
+    if (GetUpdateRect(hwnd, &pending, FALSE) && IntersectRect(&overlap, &pending, &pane.rect))
+        return false;
+    RECT quick_open_rect = quickOpenRect(quick_open_results.size());
+    if (quick_open_mode && IntersectRect(&overlap, &quick_open_rect, &pane.rect))
+        return false;
+    // Ölçüm sürerken yeni görünen satırların görsel satır sayısı değişebilir, ekrandakiler kayabilir
+    if (wrap_lines && (pane.wrap_worker || pane.loader))
+        return false;
+
+    GdiRenderer renderer(back_buffer, *resources.font(current_font_size).atlas);
+    renderer.scroll(viewport, dy);
+
+    RECT scrolled = {viewport.left, viewport.top, viewport.right, viewport.bottom};
+    ScrollWindowEx(hwnd, 0, dy, &scrolled, &scrolled, NULL, NULL, 0);
+
+    RECT exposed = scrolled;
+    if (dy > 0)
+        exposed.bottom = exposed.top + dy;
+    else
+        exposed.top = exposed.bottom + dy;
+    InvalidateRect(hwnd, &exposed, FALSE);
+    return true;
+}
+
 // Search & Replace functions
 void ModernTextEditor::startSearch()
 {
     search_mode = true;
     replace_mode = false;
     search_text = "";
-    status_message = "Search: ";
+    clearSearchMatches();
+    EditorPane &pane = panes[active_pane];
+    search_origin = pane.document.offsetAt(pane.cursor_row, pane.cursor_col);
+    status_message = searchPrompt();
     mode = COMMAND_MODE;
 }
 
@@ -1261,48 +1919,207 @@ void ModernTextEditor::startReplace()
     search_mode = false;
     search_text = "";
     replace_text = "";
-    status_message = "Replace: ";
+    replace_field = false;
+    clearSearchMatches();
+    EditorPane &pane = panes[active_pane];
+    search_origin = pane.document.offsetAt(pane.cursor_row, pane.cursor_col);
+    status_message = searchPrompt();
     mode = COMMAND_MODE;
 }
 
+std::string ModernTextEditor::searchPrompt()
+{
+    std::string label = search_use_regex ? "Regex " : "";
+    if (search_mode)
+        return label + (label.empty() ? "Search: " : "search: ") + search_text;
+    if (!replace_field)
+        return label + (label.empty() ? "Replace: " : "replace: ") + search_text + "  (Tab: replacement)";
+    return label + (label.empty() ? "Replace: " : "replace: ") + search_text + " -> " + replace_text;
+}
+
+SearchQuery &ModernTextEditor::currentQuery()
+{
+    // Derlenmiş desen ve DFA önbelleği aramalar arasında korunur
+    if (!search_query || !search_query->matches(search_text, search_ignore_case, search_use_regex))
+        search_query.reset(new SearchQuery(search_text, search_ignore_case, search_use_regex));
+    return *search_query;
+}
+
+bool ModernTextEditor::findMatch(EditorPane &pane, size_t from, size_t to, size_t &match_start, size_t &match_end)
+{
+    return currentQuery().find(pane.document, from, to, match_start, match_end);
+}
+
+void ModernTextEditor::clearSearchMatches()
+{
+    search_worker.reset(); // tarama iptal edilir
+    search_matches.clear();
+    search_edits.clear();
+    search_generation++;
+    search_taken = 0;
+    search_scanned = 0;
+    search_pane = -1;
+    search_jump_pending = false;
+}
+
+void ModernTextEditor::updateIncrementalSearch(bool jump)
+{
+    clearSearchMatches();
+    EditorPane &pane = panes[active_pane];
+    if (jump)
+    {
+        // Her tuşta arama başladığı yerden yeniden bakılır
+        pane.document.positionAt(std::min(search_origin, pane.document.length()), pane.cursor_row, pane.cursor_col);
+        ensureCursorVisible();
+    }
+
+    SearchQuery &query = currentQuery();
+    if (!query.valid())
+        return; // boş sorgu ya da yazımı süren düzenli ifade
+
+    search_pane = active_pane;
+    search_revision = pane.document.revision();
+
+    // Görünür satırlar UI thread'inde hemen taranır
+    int visible_lines = (pane.rect.bottom - pane.rect.top - 60) / (char_height + 2);
+    int last_row = std::min(pane.scroll_top + std::max(visible_lines, 1), pane.document.lineCount()) - 1;
+    search_visible_from = pane.document.lineStart(pane.scroll_top);
+    size_t visible_to = pane.document.lineEnd(last_row);
+    std::vector<SearchMatch> visible;
+    query.findAll(pane.document, search_visible_from, visible_to, visible);
+    search_matches.replace(search_visible_from, visible_to, visible);
+    search_generation++;
+
+    // Belgenin tamamı arka planda; düzenlemeler anlık görüntüyü etkilemez
+    HWND target = hwnd;
+    search_worker.reset(new SearchWorker(pane.document.snapshot(), search_text, search_ignore_case, search_use_regex,
+                                         [target]()
+                                         { PostMessage(target, WM_SEARCH_PROGRESS, 0, 0); }));
+    search_jump_pending = jump;
+    if (jump)
+        jumpToSearchMatch();
+}
+
+void ModernTextEditor::handleSearchProgress()
+{
+    if (!search_worker)
+        return; // iptal edilmiş taramanın geç gelen mesajı
+
+    // Arka planın ulaştığı bölgede görünür bölge sonuçlarının yerini tarama sonuçları alır.
+    // Tarama sürerken yapılan düzenlemeler sonuçlara işlenir, düzenlenen bölgeler yeniden taranır
+    std::vector<SearchMatch> batch;
+    size_t previous = search_taken;
+    search_taken = search_worker->takeMatches(batch);
+    EditorPane &pane = panes[search_pane];
+    search_matches.merge(pane.document, currentQuery(), previous, search_taken, batch, search_edits);
+    search_scanned = search_edits.map(search_taken, true);
+    search_generation++;
+    if (search_worker->finished())
+    {
+        search_worker.reset();
+        search_edits.clear();
+    }
+
+    if (search_jump_pending)
+        jumpToSearchMatch();
+    invalidateChanges();
+}
+
+void ModernTextEditor::jumpToSearchMatch()
+{
+    if (search_pane != active_pane)
+        return;
+
+    // Arka planın taradığı bölgedeki eşleşme kesindir. Görünür bölge sonucu, arama başlangıcından
+    // oraya kadar her yer taranmışsa kesindir. Tarama bitince başa sarılır.
+    SearchMatch target;
+    size_t index = 0;
+    bool found = search_matches.lowerBound(search_origin, target, index);
+    if (found && search_worker && target.start >= search_scanned && search_origin < search_visible_from &&
+        search_scanned < search_visible_from)
+        found = false;
+    else if (!found && !search_worker)
+        found = search_matches.at(0, target);
+
+    if (!found)
+    {
+        if (!search_worker)
+            search_jump_pending = false; // hiç eşleşme yok
+        return;
+    }
+
+    EditorPane &pane = panes[active_pane];
+    pane.document.positionAt(target.start, pane.cursor_row, pane.cursor_col);
+    pane.selection.clear();
+    ensureCursorVisible();
+    search_jump_pending = false;
+}
+
+std::string ModernTextEditor::searchCounter()
+{
+    if (search_pane < 0 || search_pane >= static_cast<int>(panes.size()) ||
+        panes[search_pane].document.revision() != search_revision)
+        return "";
+
+    // Toplam: arka plan sonuçları + henüz taranmamış görünür bölge
+    const EditorPane &pane = panes[search_pane];
+    size_t total = search_matches.size();
+    std::string count = std::to_string(total) + (search_worker ? "+" : "");
+    size_t cursor = pane.document.offsetAt(pane.cursor_row, pane.cursor_col);
+    SearchMatch match;
+    size_t index = 0;
+    if (search_matches.lowerBound(cursor, match, index) && match.start == cursor)
+        return std::to_string(index + 1) + " of " + count;
+    return total == 0 && !search_worker ? "No matches" : count + " matches";
+}
+
 void ModernTextEditor::performSearch()
 {
     EditorPane &pane = panes[active_pane];
-    int start_row = pane.cursor_row;
-    int start_col = pane.cursor_col;
+    if (search_text.empty())
+        return;
 
-    // Mevcut satırdan arama başlat
-    for (size_t i = static_cast<size_t>(start_row); i < pane.lines.size(); i++)
+    size_t length = pane.document.length();
+    size_t cursor = pane.document.offsetAt(pane.cursor_row, pane.cursor_col);
+    size_t match_start = 0, match_end = 0;
+    bool found = false;
+    if (search_pane == active_pane && !search_worker && pane.document.revision() == search_revision &&
+        currentQuery().valid())
     {
-        size_t search_start = (static_cast<int>(i) == start_row) ? static_cast<size_t>(start_col) : 0;
-        size_t pos = pane.lines[i].find(search_text, search_start);
-        if (pos != std::string::npos)
-        {
-            pane.cursor_row = static_cast<int>(i);
-            pane.cursor_col = static_cast<int>(pos);
-            current_search_result = static_cast<int>(i);
-            ensureCursorVisible();
-            status_message = "Found: " + search_text;
-            return;
-        }
+        // Eşleşme listesi tamam ve güncel: sonraki eşleşme O(log n), yoksa başa sarılır
+        SearchMatch match;
+        size_t index = 0;
+        found = search_matches.lowerBound(cursor + 1, match, index) || search_matches.at(0, match);
+        match_start = match.start;
     }
-
-    // Baştan arama yap
-    for (size_t i = 0; i <= static_cast<size_t>(start_row); i++)
+    else
     {
-        size_t pos = pane.lines[i].find(search_text, 0);
-        if (pos != std::string::npos && (i < static_cast<size_t>(start_row) || pos < static_cast<size_t>(start_col)))
+        // Belge satır kopyası alınmadan parçalar üzerinde taranır.
+        // İmleçten sonrası, bulunamazsa baştan imlece kadar (imleçteki eşleşme en son gelir)
+        found = findMatch(pane, std::min(cursor + 1, length), length, match_start, match_end);
+        if (!currentQuery().valid())
         {
-            pane.cursor_row = static_cast<int>(i);
-            pane.cursor_col = static_cast<int>(pos);
-            current_search_result = static_cast<int>(i);
-            ensureCursorVisible();
-            status_message = "Found: " + search_text;
+            status_message = "Invalid regex: " + currentQuery().error();
             return;
         }
+        if (!found)
+        {
+            // Düzenli ifadenin uzunluğu bilinmez; sarmalı arama belge sonuna kadar bakıp imleci geçeni reddeder
+            size_t limit = search_use_regex ? length : std::min(cursor + search_text.size(), length);
+            found = findMatch(pane, 0, limit, match_start, match_end) && match_start <= cursor;
+        }
+    }
+    if (!found)
+    {
+        status_message = "Not found: " + search_text;
+        return;
     }
 
-    status_message = "Not found: " + search_text;
+    pane.document.positionAt(match_start, pane.cursor_row, pane.cursor_col);
+    pane.selection.clear();
+    search_jump_pending = false;
+    ensureCursorVisible();
+    status_message = "Found: " + search_text;
 }
 
 void ModernTextEditor::performReplace()
@@ -1311,15 +2128,25 @@ void ModernTextEditor::performReplace()
         return;
 
     EditorPane &pane = panes[active_pane];
-    std::string &current_line = pane.lines[pane.cursor_row];
+    if (!canEdit())
+        return;
 
-    size_t pos = current_line.find(search_text, static_cast<size_t>(pane.cursor_col));
-    if (pos == static_cast<size_t>(pane.cursor_col))
-    {
-        current_line.replace(pos, search_text.length(), replace_text);
-        pane.cursor_col = pos + replace_text.length();
+    // İmleç bir eşleşmenin başındaysa onu değiştir, değilse sonrakine git.
+    // Düzenli ifadede değiştirme metni olduğu gibi eklenir (grup referansı yok)
+    size_t offset = pane.document.offsetAt(pane.cursor_row, pane.cursor_col);
+    size_t limit = search_use_regex ? pane.document.length() : offset + search_text.length();
+    size_t match_start = 0, match_end = 0;
+    if (findMatch(pane, offset, limit, match_start, match_end) && match_start == offset)
+    {
+        beginUndoGroup("replace");
+        editErase(pane, match_start, match_end);
+        editInsert(pane, match_start, replace_text);
+        endUndoGroup();
+        pane.document.positionAt(offset + replace_text.length(), pane.cursor_row, pane.cursor_col);
         pane.modified = true;
         ensureCursorVisible();
+        if (search_pane != active_pane || pane.document.revision() != search_revision)
+            updateIncrementalSearch(false); // eşleşmeler düzenlemeyle güncellenmediyse baştan
         status_message = "Replaced: " + search_text + " -> " + replace_text;
     }
     else
@@ -1328,86 +2155,553 @@ void ModernTextEditor::performReplace()
     }
 }
 
-// Undo/Redo functions
-void ModernTextEditor::saveUndoState(const std::string &operation)
+void ModernTextEditor::replaceAll(const std::string &pattern, const std::string &replacement, bool ignore_case)
 {
     EditorPane &pane = panes[active_pane];
-    UndoState state;
-    state.lines = pane.lines;
-    state.cursor_row = pane.cursor_row;
-    state.cursor_col = pane.cursor_col;
-    state.operation = operation;
+    if (!canEdit())
+        return;
 
-    undo_stack.push_back(state);
+    auto started = std::chrono::steady_clock::now();
+    SearchQuery query(pattern, ignore_case, search_use_regex);
+    if (!query.valid())
+    {
+        status_message = "Invalid regex: " + query.error();
+        return;
+    }
 
-    // Undo stack boyutunu sınırla (çok küçük)
-    if (undo_stack.size() > static_cast<size_t>(10)) // Maksimum 10 undo
+    // Tek geçiş: eşleşmeler parça parça bulunur, ilk ve son eşleşme arasındaki metin yeniden kurulur.
+    // Belgeye tek bir silme + ekleme olarak uygulanır; undo kaydı sadece değişen aralığı tutar.
+    const size_t slice = 1024 * 1024; // dilim başına eşleşme sayısı MAX_MATCHES altında kalır
+    size_t length = pane.document.length();
+    std::vector<SearchMatch> batch;
+    std::string rebuilt;
+    size_t first = 0, copied = 0, count = 0;
+    size_t pos = 0;
+    while (pos <= length)
     {
-        undo_stack.erase(undo_stack.begin(), undo_stack.begin() + 5);
+        batch.clear();
+        if (pos < length)
+        {
+            pos = query.findAll(pane.document, pos, length, batch, slice, true);
+        }
+        else
+        {
+            // Belge sonundaki boş eşleşme ($ gibi) findAll aralığının dışında kalır
+            SearchMatch match;
+            if (query.find(pane.document, length, length, match.start, match.end))
+                batch.push_back(match);
+            pos++;
+        }
+
+        for (const SearchMatch &match : batch)
+        {
+            if (count++ == 0)
+                first = copied = match.start;
+            pane.document.forEachChunk(copied, match.start - copied, [&](const char *chunk, size_t size)
+                                       { rebuilt.append(chunk, size); });
+            rebuilt += replacement;
+            copied = match.end;
+        }
+    }
+
+    if (count == 0)
+    {
+        status_message = "Pattern not found: " + pattern;
+        return;
     }
 
-    // Redo stack'i temizle
-    redo_stack.clear();
+    beginUndoGroup("replace all");
+    editErase(pane, first, copied);
+    editInsert(pane, first, rebuilt);
+    endUndoGroup();
+    pane.modified = true;
+
+    // İmleç aynı satırda kalır
+    pane.cursor_row = std::min(pane.cursor_row, pane.document.lineCount() - 1);
+    pane.cursor_col = std::min(pane.cursor_col, pane.document.lineLength(pane.cursor_row));
+    pane.selection.clear();
+    ensureCursorVisible();
+
+    double elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - started).count();
+    std::ostringstream report;
+    report << "Replaced " << count << (count == 1 ? " occurrence" : " occurrences") << " in " << std::fixed
+           << std::setprecision(1) << elapsed << " ms";
+    status_message = report.str();
 }
 
-void ModernTextEditor::performUndo()
+int ModernTextEditor::findResultsPane()
+{
+    for (size_t i = 0; i < panes.size(); i++)
+    {
+        if (panes[i].find_results)
+            return static_cast<int>(i);
+    }
+    return -1;
+}
+
+void ModernTextEditor::startFindInFiles(const std::string &text)
+{
+    if (text.empty())
+    {
+        status_message = "Usage: find <text>";
+        return;
+    }
+    SearchQuery query(text, search_ignore_case, search_use_regex);
+    if (!query.valid())
+    {
+        status_message = "Invalid regex: " + query.error();
+        return;
+    }
+
+    find_search.reset(); // önceki arama iptal
+    find_results.clear();
+
+    // Sonuçlar için tek panel kullanılır, yoksa dikey bölmeyle açılır
+    int index = findResultsPane();
+    if (index < 0)
+    {
+        EditorPane results;
+        results.filename = "[Find Results]";
+        results.find_results = true;
+        panes.push_back(results);
+        split_direction = VERTICAL_SPLIT;
+        updatePaneLayout();
+        index = static_cast<int>(panes.size()) - 1;
+    }
+
+    EditorPane &pane = panes[index];
+    pane.document.setText("Searching for \"" + text + "\" in " + fileExplorer.currentPath + " ...\n");
+    if (wrap_lines)
+        startWrap(pane);
+    pane.history.clear();
+    pane.cursor_row = 0;
+    pane.cursor_col = 0;
+    pane.scroll_top = 0;
+    pane.scroll_row = 0;
+    pane.scroll_pixel = 0;
+    pane.scroll_left = 0;
+    pane.selection.clear();
+
+    find_root = fileExplorer.currentPath;
+    find_text = text;
+    find_indexed = false;
+    find_started = GetTickCount();
+    HWND target = hwnd;
+    auto notify = [target]()
+    { PostMessage(target, WM_FIND_PROGRESS, 0, 0); };
+
+    // İndeks hazırsa ağaç gezilirken indekslendiği halde duran aday dışı dosyalar açılmaz.
+    // Yeni ve dışarıda değişmiş dosyalar zaman damgalarından tanınır, arka plan taramasını beklemeden aranır.
+    TrigramIndex &workspace = workspaceIndex(find_root);
+    auto excluded = std::make_shared<TrigramIndex::Exclusions>();
+    if (workspace.ready() && workspace.exclusions(text, search_use_regex, *excluded))
+    {
+        find_root = workspace.root();
+        find_indexed = true;
+        find_search.reset(new FindInFiles(
+            find_root, text, search_ignore_case, search_use_regex,
+            [excluded](const std::filesystem::directory_entry &entry)
+            { return excluded->skip(entry); },
+            notify));
+    }
+    else
+    {
+        find_search.reset(new FindInFiles(find_root, text, search_ignore_case, search_use_regex, notify));
+    }
+    if (GetTickCount() - index_refreshed > INDEX_REFRESH_INTERVAL || !workspace.ready())
+        refreshWorkspaceIndex();
+    status_message = "Searching files for: " + text + " (:findstop cancels)";
+}
+
+void ModernTextEditor::handleFindProgress()
+{
+    if (!find_search)
+        return; // iptal edilmiş aramanın geç gelen mesajı
+
+    int index = findResultsPane();
+    if (index < 0)
+    {
+        find_search.reset();
+        return;
+    }
+
+    // Yeni sonuçlar panelin sonuna eklenir (undo geçmişine yazılmaz)
+    // Bitiş, sonuçlar alınmadan önce okunur: arada yayımlanan son parti bir sonraki mesajda gelir
+    EditorPane &pane = panes[index];
+    bool finished = find_search->finished();
+    size_t first = find_results.size();
+    find_search->takeResults(find_results);
+    // Sürücü ya da dosya sistemi kökü (C:\, /) ayırıcıyla biter, ayırıcı bir kez atlanır
+    size_t prefix = find_root.size();
+    if (prefix > 0 && find_root.back() != '\\' && find_root.back() != '/')
+        prefix++;
+    std::string lines;
+    for (size_t i = first; i < find_results.size(); i++)
+    {
+        const FileMatch &match = find_results[i];
+        std::string path = match.path;
+        if (path.compare(0, find_root.size(), find_root) == 0 && path.size() > prefix)
+            path = path.substr(prefix); // kökten göreli
+        lines += path + ":" + std::to_string(match.line + 1) + ":" + std::to_string(match.column + 1) + ": " +
+                 match.preview + "\n";
+    }
+    // Eklenen satırlar kaydırma düzenine artımlı işlenir, arama sürerken düzen baştan ölçülmez
+    size_t revision = pane.document.revision();
+    int line_count = pane.document.lineCount();
+    std::vector<TextChange> changes{{pane.document.length(), 0, lines.size()}};
+    pane.document.insert(pane.document.length(), lines);
+    updateWrap(pane, revision, line_count, &changes);
+
+    if (finished)
+    {
+        // Başlık satırı özete dönüşür
+        std::string summary = std::to_string(find_results.size()) + " matches for \"" + find_text + "\" in " +
+                              std::to_string(find_search->filesSearched()) + " files (" +
+                              std::to_string(find_search->binaryFiles()) + " binary skipped" +
+                              (find_indexed ? ", " + std::to_string(find_search->skippedFiles()) + " ruled out by index"
+                                            : "") +
+                              "), " +
+                              std::to_string(GetTickCount() - find_started) + " ms" +
+                              (find_search->truncated() ? " - truncated" : "");
+        revision = pane.document.revision();
+        line_count = pane.document.lineCount();
+        changes.assign(1, TextChange{0, pane.document.lineEnd(0), summary.size()});
+        pane.document.erase(0, pane.document.lineEnd(0));
+        pane.document.insert(0, summary);
+        updateWrap(pane, revision, line_count, &changes);
+        status_message = summary;
+        find_search.reset();
+    }
+    invalidateChanges();
+}
+
+TrigramIndex &ModernTextEditor::workspaceIndex(const std::string &root)
+{
+    // Kök değişince eski indeksin taraması iptal edilir, yenisi diskten yüklenir
+    if (!trigram_index || trigram_index->root() != TrigramIndex::normalize(root))
+    {
+        trigram_index.reset(new TrigramIndex(root));
+        trigram_index->load();
+        index_refreshed = 0;
+    }
+    return *trigram_index;
+}
+
+void ModernTextEditor::refreshWorkspaceIndex()
 {
-    if (undo_stack.empty())
+    if (!trigram_index || trigram_index->refreshing())
+        return;
+    index_refreshed = GetTickCount();
+    HWND target = hwnd;
+    trigram_index->startRefresh([target]()
+                                { PostMessage(target, WM_INDEX_PROGRESS, 0, 0); });
+}
+
+void ModernTextEditor::handleIndexProgress()
+{
+    if (!trigram_index || find_search)
+        return; // arama özeti durum satırında kalsın
+    status_message = "Workspace index: " + std::to_string(trigram_index->fileCount()) + " files, " +
+                     std::to_string(trigram_index->postingBytes() / 1024) + " KB postings";
+    invalidateChanges();
+}
+
+void ModernTextEditor::openFindResult()
+{
+    EditorPane &results = panes[active_pane];
+    int row = results.cursor_row - 1; // ilk satır başlık
+    if (row < 0 || static_cast<size_t>(row) >= find_results.size())
+        return;
+    FileMatch match = find_results[row];
+
+    // Sonuç, sonuç paneli dışındaki ilk panelde açılır
+    int target = -1;
+    for (size_t i = 0; i < panes.size() && target < 0; i++)
+    {
+        if (!panes[i].find_results)
+            target = static_cast<int>(i);
+    }
+    if (target < 0)
     {
-        status_message = "Nothing to undo";
+        status_message = "No editor pane to open the result in";
         return;
     }
 
+    switchToPane(target);
+    if (panes[target].filename != match.path)
+        loadFile(match.path);
+
+    EditorPane &pane = panes[active_pane];
+    if (pane.filename != match.path)
+        return; // açılamadı, loadFile mesajı gösterir
+    waitForLines(pane, static_cast<int>(match.line));
+    pane.cursor_row = std::min(static_cast<int>(match.line), pane.document.lineCount() - 1);
+    pane.cursor_col = std::min(static_cast<int>(match.column), pane.document.lineLength(pane.cursor_row));
+    pane.selection.clear();
+    ensureCursorVisible();
+    status_message = match.path + ":" + std::to_string(match.line + 1);
+}
+
+// Undo/Redo functions
+void ModernTextEditor::saveUndoState(const std::string &operation, bool mergeable)
+{
+    // Yeni undo kaydı aç - sonraki editInsert/editErase çağrıları bu kayda yazılır
     EditorPane &pane = panes[active_pane];
+    pane.history.begin(operation, pane.cursor_row, pane.cursor_col, mergeable);
+}
 
-    // Mevcut durumu redo stack'e kaydet
-    UndoState current_state;
-    current_state.lines = pane.lines;
-    current_state.cursor_row = pane.cursor_row;
-    current_state.cursor_col = pane.cursor_col;
-    current_state.operation = "redo";
-    redo_stack.push_back(current_state);
-
-    // Son undo state'i geri yükle
-    UndoState last_state = undo_stack.back();
-    undo_stack.pop_back();
-
-    pane.lines = last_state.lines;
-    pane.cursor_row = last_state.cursor_row;
-    pane.cursor_col = last_state.cursor_col;
-    pane.modified = true;
+void ModernTextEditor::beginUndoGroup(const std::string &operation)
+{
+    EditorPane &pane = panes[active_pane];
+    pane.history.beginGroup(operation, pane.cursor_row, pane.cursor_col);
+}
 
-    status_message = "Undone: " + last_state.operation;
+void ModernTextEditor::endUndoGroup()
+{
+    panes[active_pane].history.endGroup();
 }
 
-void ModernTextEditor::performRedo()
+void ModernTextEditor::editInsert(EditorPane &pane, size_t offset, const std::string &text)
+{
+    size_t revision = pane.document.revision();
+    int line_count = pane.document.lineCount();
+    int row = 0, col = 0;
+    pane.document.positionAt(std::min(offset, pane.document.length()), row, col);
+    markDirtyRows(pane, row, text.find('\n') == std::string::npos ? row : INT_MAX);
+    pane.history.insert(pane.document, offset, text);
+    std::vector<TextChange> changes{{offset, 0, text.size()}};
+    updateSearchMatches(pane, revision, &changes);
+    updateWrap(pane, revision, line_count, &changes);
+    enforceUndoBudget();
+}
+
+void ModernTextEditor::editErase(EditorPane &pane, size_t start, size_t end)
+{
+    size_t revision = pane.document.revision();
+    int line_count = pane.document.lineCount();
+    int first_row = 0, last_row = 0, col = 0;
+    pane.document.positionAt(std::min(start, pane.document.length()), first_row, col);
+    pane.document.positionAt(std::min(end, pane.document.length()), last_row, col);
+    markDirtyRows(pane, first_row, last_row == first_row ? first_row : INT_MAX);
+    if (end > start)
+        pane.history.erase(pane.document, start, end - start);
+    std::vector<TextChange> changes{{start, end - std::min(start, end), 0}};
+    updateSearchMatches(pane, revision, &changes);
+    updateWrap(pane, revision, line_count, &changes);
+    enforceUndoBudget();
+}
+
+void ModernTextEditor::updateSearchMatches(EditorPane &pane, size_t revision, const std::vector<TextChange> *changes)
+{
+    // Eşleşmeler bu panelin düzenleme öncesi haline aitse düzenlemeyle birlikte güncellenir
+    if (search_pane < 0 || search_pane >= static_cast<int>(panes.size()) || &panes[search_pane] != &pane ||
+        search_revision != revision || pane.document.revision() == revision)
+        return;
+
+    // Değişiklikler bilinmiyorsa (checkpoint'ten geri yükleme, çok sayıda dağınık düzenleme) tarama yeniden başlar.
+    // Arka plan taraması sürüyorsa sürer; değişiklikler kaydedilir, anlık görüntünün sonuçları bunlarla kaydırılır
+    if (!changes || changes->size() > MAX_TRACKED_CHANGES)
+    {
+        if (search_pane == active_pane)
+            updateIncrementalSearch(false);
+        else
+            clearSearchMatches();
+        return;
+    }
+
+    search_matches.update(pane.document, currentQuery(), *changes);
+    search_revision = pane.document.revision();
+    if (search_worker)
+    {
+        for (const TextChange &change : *changes)
+            search_edits.add(change);
+        search_scanned = search_edits.map(search_taken, true);
+    }
+    if (search_use_regex)
+        markDirtyRows(pane, 0, INT_MAX); // düzenli ifade eşleşmesi düzenlenen satırların dışına uzanabilir
+}
+
+void ModernTextEditor::enforceUndoBudget()
+{
+    size_t total = 0;
+    for (const EditorPane &pane : panes)
+        total += pane.history.memoryUsage();
+
+    // Bütçe aşıldıysa en uzun süredir kullanılmayan geçmişin en eski kayıtlarından başla
+    while (total > undo_budget)
+    {
+        EditorPane *victim = nullptr;
+        for (EditorPane &pane : panes)
+        {
+            if (pane.history.undoCount() > 1 && (!victim || pane.history.lastUsed() < victim->history.lastUsed()))
+                victim = &pane;
+        }
+        if (!victim)
+            break;
+
+        size_t before = victim->history.memoryUsage();
+        victim->history.dropOldest();
+        total -= before - victim->history.memoryUsage();
+    }
+}
+
+void ModernTextEditor::undoTimeTravel(bool earlier, const std::string &amount)
 {
-    if (redo_stack.empty())
+    // "10" adım, "30s" / "5m" / "2h" süre (vim :earlier / :later gibi)
+    EditorPane &pane = panes[active_pane];
+    const UndoHistory &history = pane.history;
+
+    size_t digits = 0;
+    while (digits < amount.size() && isdigit(static_cast<unsigned char>(amount[digits])))
+        digits++;
+    std::string unit = amount.substr(digits);
+    if (digits == 0 || digits > 9 || (unit != "" && unit != "s" && unit != "m" && unit != "h"))
+    {
+        status_message = "Usage: earlier/later N, Ns, Nm or Nh";
+        return;
+    }
+
+    size_t count = static_cast<size_t>(std::stoul(amount.substr(0, digits)));
+    size_t target = history.currentState();
+    if (unit.empty())
     {
-        status_message = "Nothing to redo";
+        if (earlier)
+            target = count > target ? 0 : target - count;
+        else
+            target = std::min(history.stateCount() - 1, target + count);
+    }
+    else
+    {
+        std::time_t seconds = static_cast<std::time_t>(count) * (unit == "s" ? 1 : unit == "m" ? 60 : 3600);
+        std::time_t now = history.stateTime(history.currentState());
+        target = history.stateAt(earlier ? now - seconds : now + seconds);
+    }
+
+    jumpToUndoState(target);
+}
+
+void ModernTextEditor::jumpToUndoState(size_t state)
+{
+    if (!canEdit())
         return;
+
+    EditorPane &pane = panes[active_pane];
+    if (state != pane.history.currentState())
+    {
+        size_t revision = pane.document.revision();
+        int line_count = pane.document.lineCount();
+        std::vector<TextChange> changes;
+        if (!pane.history.jumpTo(pane.document, state, pane.cursor_row, pane.cursor_col) &&
+            pane.history.historyDiverged())
+        {
+            dropDivergedHistory(pane, revision, line_count);
+            return;
+        }
+        bool known = pane.history.lastChanges(changes);
+        updateSearchMatches(pane, revision, known ? &changes : nullptr);
+        updateWrap(pane, revision, line_count, known ? &changes : nullptr);
+        pane.cursor_row = std::max(0, std::min(pane.cursor_row, pane.document.lineCount() - 1));
+        pane.cursor_col = std::max(0, std::min(pane.cursor_col, pane.document.lineLength(pane.cursor_row)));
+        pane.selection.clear();
+        pane.modified = true;
+        ensureCursorVisible();
+    }
+
+    char stamp[16];
+    std::time_t time = pane.history.stateTime(state);
+    std::strftime(stamp, sizeof(stamp), "%H:%M:%S", std::localtime(&time));
+    status_message = "Undo state " + std::to_string(state) + " of " + std::to_string(pane.history.stateCount() - 1) +
+                     " (" + stamp + ")";
+}
+
+void ModernTextEditor::dropDivergedHistory(EditorPane &pane, size_t revision, int line_count)
+{
+    // Geçmiş belgeyle uyuşmadı (dosya dışarıda değişmiş, günlük eski): belge tutarlı bir durumda kaldı,
+    // günlük artık bu içerikle ve boş geçmişle baştan yazılır
+    updateSearchMatches(pane, revision, nullptr);
+    updateWrap(pane, revision, line_count, nullptr);
+    if (pane.journal)
+    {
+        pane.journal->rewrite(pane.history, pane.document);
+        pane.history.attachJournal(pane.journal);
+    }
+    pane.cursor_row = std::max(0, std::min(pane.cursor_row, pane.document.lineCount() - 1));
+    pane.cursor_col = std::max(0, std::min(pane.cursor_col, pane.document.lineLength(pane.cursor_row)));
+    pane.selection.clear();
+    ensureCursorVisible();
+    status_message = "Undo history does not match the file (changed outside the editor) - history dropped";
+}
+
+std::string ModernTextEditor::undoMemoryReport()
+{
+    size_t total = 0;
+    std::string report;
+    for (size_t i = 0; i < panes.size(); i++)
+    {
+        const UndoHistory &history = panes[i].history;
+        total += history.memoryUsage();
+        report += "Pane " + std::to_string(i + 1) + ": " + std::to_string(history.memoryUsage() / 1024) + " KB (" +
+                  std::to_string(history.undoCount()) + " undo, " + std::to_string(history.redoCount()) + " redo, " +
+                  std::to_string(history.stateCount()) + " states) | ";
     }
+    report += "Total " + std::to_string(total / 1024) + " KB of " + std::to_string(undo_budget / (1024 * 1024)) + " MB";
+    return report;
+}
+
+void ModernTextEditor::performUndo()
+{
+    if (!canEdit())
+        return;
 
     EditorPane &pane = panes[active_pane];
+    std::string operation;
+    size_t revision = pane.document.revision();
+    int line_count = pane.document.lineCount();
+    if (!pane.history.undo(pane.document, pane.cursor_row, pane.cursor_col, operation))
+    {
+        if (pane.history.historyDiverged())
+            dropDivergedHistory(pane, revision, line_count);
+        else
+            status_message = "Nothing to undo";
+        return;
+    }
+    std::vector<TextChange> changes;
+    bool known = pane.history.lastChanges(changes);
+    updateSearchMatches(pane, revision, known ? &changes : nullptr);
+    updateWrap(pane, revision, line_count, known ? &changes : nullptr);
 
-    // Mevcut durumu undo stack'e kaydet
-    UndoState current_state;
-    current_state.lines = pane.lines;
-    current_state.cursor_row = pane.cursor_row;
-    current_state.cursor_col = pane.cursor_col;
-    current_state.operation = "undo";
-    undo_stack.push_back(current_state);
-
-    // Son redo state'i geri yükle
-    UndoState last_state = redo_stack.back();
-    redo_stack.pop_back();
-
-    pane.lines = last_state.lines;
-    pane.cursor_row = last_state.cursor_row;
-    pane.cursor_col = last_state.cursor_col;
+    pane.selection.clear();
     pane.modified = true;
+    ensureCursorVisible();
+    status_message = "Undone: " + operation;
+}
+
+void ModernTextEditor::performRedo()
+{
+    if (!canEdit())
+        return;
 
-    status_message = "Redone: " + last_state.operation;
+    EditorPane &pane = panes[active_pane];
+    std::string operation;
+    size_t revision = pane.document.revision();
+    int line_count = pane.document.lineCount();
+    if (!pane.history.redo(pane.document, pane.cursor_row, pane.cursor_col, operation))
+    {
+        if (pane.history.historyDiverged())
+            dropDivergedHistory(pane, revision, line_count);
+        else
+            status_message = "Nothing to redo";
+        return;
+    }
+    std::vector<TextChange> changes;
+    bool known = pane.history.lastChanges(changes);
+    updateSearchMatches(pane, revision, known ? &changes : nullptr);
+    updateWrap(pane, revision, line_count, known ? &changes : nullptr);
+
+    pane.selection.clear();
+    pane.modified = true;
+    ensureCursorVisible();
+    status_message = "Redone: " + operation;
 }
 
 // File Explorer functions
@@ -1497,22 +2791,20 @@ FileType ModernTextEditor::getFileType(const std::string &filename)
         return FILE_TYPE_OTHER;
 }
 
-void ModernTextEditor::drawFileExplorer(HDC hdc)
+void ModernTextEditor::drawFileExplorer(Renderer &renderer)
 {
     // File explorer arka planını çiz
-    FillRect(hdc, &fileExplorer.rect, explorer_brush);
+    renderer.fillRect(renderRect(fileExplorer.rect), EXPLORER_COLOR);
 
     // Başlık çiz
-    SetBkMode(hdc, OPAQUE);
-    SetBkColor(hdc, RGB(30, 30, 30));
-    SetTextColor(hdc, RGB(200, 200, 200));
-
     std::string title = "FILE EXPLORER";
-    TextOutA(hdc, fileExplorer.rect.left + 5, fileExplorer.rect.top + 5, title.c_str(), title.length());
+    renderer.drawText(fileExplorer.rect.left + 5, fileExplorer.rect.top + 5, title.c_str(), title.length(),
+                      LIST_TEXT_COLOR, EXPLORER_COLOR);
 
     // Mevcut dizin
     std::string currentPath = "Path: " + fileExplorer.currentPath;
-    TextOutA(hdc, fileExplorer.rect.left + 5, fileExplorer.rect.top + 25, currentPath.c_str(), currentPath.length());
+    renderer.drawText(fileExplorer.rect.left + 5, fileExplorer.rect.top + 25, currentPath.c_str(), currentPath.length(),
+                      LIST_TEXT_COLOR, EXPLORER_COLOR);
 
     // Dosya listesi
     int y = fileExplorer.rect.top + 50;
@@ -1525,69 +2817,66 @@ void ModernTextEditor::drawFileExplorer(HDC hdc)
         const FileItem &item = fileExplorer.items[i];
 
         // Seçili item arka planı
-        if (static_cast<int>(i) == fileExplorer.selectedIndex)
+        bool selected = static_cast<int>(i) == fileExplorer.selectedIndex;
+        if (selected)
         {
             RECT selRect = {fileExplorer.rect.left, y, fileExplorer.rect.right, y + line_height};
-            HBRUSH selBrush = CreateSolidBrush(RGB(50, 100, 150));
-            FillRect(hdc, &selRect, selBrush);
-            DeleteObject(selBrush);
+            renderer.fillRect(renderRect(selRect), HIGHLIGHT_COLOR);
         }
 
         // Indent for level
         int x_offset = fileExplorer.rect.left + 5 + (item.level * 15);
 
         // Icon ve text rengi
-        COLORREF textColor = RGB(200, 200, 200);
+        RenderColor textColor = LIST_TEXT_COLOR;
         std::string prefix = "";
 
         switch (item.type)
         {
         case FILE_TYPE_FOLDER:
             prefix = item.isExpanded ? "[+] " : "[-] ";
-            textColor = RGB(255, 255, 100);
+            textColor = renderColor(255, 255, 100);
             break;
         case FILE_TYPE_CPP:
             prefix = "[C] ";
-            textColor = RGB(100, 150, 255);
+            textColor = renderColor(100, 150, 255);
             break;
         case FILE_TYPE_HEADER:
             prefix = "[H] ";
-            textColor = RGB(150, 100, 255);
+            textColor = renderColor(150, 100, 255);
             break;
         case FILE_TYPE_PYTHON:
             prefix = "[P] ";
-            textColor = RGB(100, 255, 100);
+            textColor = renderColor(100, 255, 100);
             break;
         case FILE_TYPE_JAVASCRIPT:
             prefix = "[J] ";
-            textColor = RGB(255, 255, 100);
+            textColor = renderColor(255, 255, 100);
             break;
         default:
             prefix = "[F] ";
             break;
         }
 
-        SetTextColor(hdc, textColor);
         std::string displayName = prefix + item.name;
-        TextOutA(hdc, x_offset, y, displayName.c_str(), displayName.length());
+        renderer.drawText(x_offset, y, displayName.c_str(), displayName.length(), textColor,
+                          selected ? HIGHLIGHT_COLOR : EXPLORER_COLOR);
 
         y += line_height;
     }
 }
 
 // Terminal functions
-void ModernTextEditor::drawTerminal(HDC hdc)
+void ModernTextEditor::drawTerminal(Renderer &renderer)
 {
     // Terminal arka planını çiz
-    FillRect(hdc, &terminal.rect, terminal_brush);
+    renderer.fillRect(renderRect(terminal.rect), TERMINAL_COLOR);
 
     // Başlık çiz
-    SetBkMode(hdc, OPAQUE);
-    SetBkColor(hdc, RGB(20, 20, 20));
-    SetTextColor(hdc, RGB(0, 255, 0)); // Terminal yeşili
-
+    const RenderColor green = renderColor(0, 255, 0); // Terminal yeşili
     std::string title = "TERMINAL";
-    TextOutA(hdc, terminal.rect.left + 5, terminal.rect.top + 5, title.c_str(), title.length());
+    renderer.drawText(terminal.rect.left + 5, terminal.rect.top + 5, title.c_str(), title.length(), green,
+                      TERMINAL_COLOR);
 
     // Terminal output çiz
     int y = terminal.rect.top + 25;
@@ -1598,24 +2887,23 @@ void ModernTextEditor::drawTerminal(HDC hdc)
          i < terminal.output.size() && y < terminal.rect.bottom - line_height * 2;
          i++)
     {
-        SetTextColor(hdc, RGB(200, 200, 200));
-        TextOutA(hdc, terminal.rect.left + 5, y, terminal.output[i].c_str(), terminal.output[i].length());
+        renderer.drawText(terminal.rect.left + 5, y, terminal.output[i].c_str(), terminal.output[i].length(),
+                          LIST_TEXT_COLOR, TERMINAL_COLOR);
         y += line_height;
     }
 
     // Current input line
     if (terminal.isActive)
     {
-        SetTextColor(hdc, RGB(0, 255, 0));
         std::string prompt = "> " + terminal.currentInput;
-        TextOutA(hdc, terminal.rect.left + 5, terminal.rect.bottom - line_height - 5,
-                 prompt.c_str(), prompt.length());
+        renderer.drawText(terminal.rect.left + 5, terminal.rect.bottom - line_height - 5, prompt.c_str(),
+                          prompt.length(), green, TERMINAL_COLOR);
 
         // Cursor
         int cursor_x = terminal.rect.left + 5 + (prompt.length() * char_width);
         RECT cursor_rect = {cursor_x, terminal.rect.bottom - line_height - 5,
                             cursor_x + 2, terminal.rect.bottom - 5};
-        FillRect(hdc, &cursor_rect, cursor_brush);
+        renderer.fillRect(renderRect(cursor_rect), CURSOR_COLOR);
     }
 }
 
@@ -1798,11 +3086,12 @@ void ModernTextEditor::handleFileExplorerClick(int x, int y)
 void ModernTextEditor::duplicateCurrentLine()
 {
     EditorPane &pane = panes[active_pane];
-    if (pane.cursor_row < static_cast<int>(pane.lines.size()))
+    if (pane.cursor_row < pane.document.lineCount() && canEdit())
     {
-        saveUndoState("duplicate line");
-        std::string currentLine = pane.lines[pane.cursor_row];
-        pane.lines.insert(pane.lines.begin() + pane.cursor_row + 1, currentLine);
+        beginUndoGroup("duplicate line");
+        std::string currentLine = pane.document.getLine(pane.cursor_row);
+        editInsert(pane, pane.document.lineEnd(pane.cursor_row), pane.document.eol() + currentLine);
+        endUndoGroup();
         pane.cursor_row++;
         pane.modified = true;
         status_message = "Line duplicated";
@@ -1812,12 +3101,16 @@ void ModernTextEditor::duplicateCurrentLine()
 void ModernTextEditor::deleteCurrentLine()
 {
     EditorPane &pane = panes[active_pane];
-    if (pane.lines.size() > 1)
+    if (pane.document.lineCount() > 1 && canEdit())
     {
         saveUndoState("delete line");
-        pane.lines.erase(pane.lines.begin() + pane.cursor_row);
-        if (pane.cursor_row >= static_cast<int>(pane.lines.size()))
-            pane.cursor_row = static_cast<int>(pane.lines.size()) - 1;
+        // Satırı sonundaki '\n' ile birlikte sil (son satırsa öncekinin '\n'i ile)
+        if (pane.cursor_row < pane.document.lineCount() - 1)
+            editErase(pane, pane.document.lineStart(pane.cursor_row), pane.document.lineStart(pane.cursor_row + 1));
+        else
+            editErase(pane, pane.document.lineEnd(pane.cursor_row - 1), pane.document.length());
+        if (pane.cursor_row >= pane.document.lineCount())
+            pane.cursor_row = pane.document.lineCount() - 1;
         pane.cursor_col = 0;
         pane.modified = true;
         status_message = "Line deleted";
@@ -1831,7 +3124,7 @@ void ModernTextEditor::selectCurrentLine()
     pane.selection.start_row = pane.cursor_row;
     pane.selection.start_col = 0;
     pane.selection.end_row = pane.cursor_row;
-    pane.selection.end_col = pane.lines[pane.cursor_row].length();
+    pane.selection.end_col = pane.document.lineLength(pane.cursor_row);
     status_message = "Line selected";
 }
 
@@ -1845,22 +3138,134 @@ void ModernTextEditor::startGoToLine()
 
 void ModernTextEditor::startQuickOpen()
 {
-    // Quick file open - basit file dialog
-    openFile();
+    // Yol listesi File Explorer dizini için ilk kullanımda kurulur, bayatsa arka planda tazelenir
+    std::string root = workspaceRoot(fileExplorer.currentPath);
+    if (!path_index || path_index->root() != root)
+    {
+        path_index.reset(new PathIndex(root));
+        paths_refreshed = 0;
+    }
+    if (!path_index->refreshing() && (paths_refreshed == 0 || GetTickCount() - paths_refreshed > PATHS_REFRESH_INTERVAL))
+    {
+        paths_refreshed = GetTickCount();
+        HWND target = hwnd;
+        path_index->startRefresh([target]()
+                                 { PostMessage(target, WM_PATHS_PROGRESS, 0, 0); });
+    }
+
+    if (!quick_open_mode)
+        quick_open_previous = mode;
+    quick_open_mode = true;
+    quick_open_text.clear();
+    mode = COMMAND_MODE;
+    updateQuickOpen();
 }
 
-void ModernTextEditor::increaseFontSize()
+void ModernTextEditor::updateQuickOpen()
+{
+    quick_open_results.clear();
+    quick_open_selected = 0;
+    quick_open_total = path_index->query(quick_open_text, QUICK_OPEN_ROWS, quick_open_results);
+
+    if (path_index->size() == 0)
+        status_message = path_index->refreshing() ? "Indexing workspace..." : "No files in " + path_index->root();
+    else
+        status_message = std::to_string(quick_open_total) + " of " + std::to_string(path_index->size()) + " files" +
+                         (path_index->refreshing() ? " (refreshing)" : "");
+}
+
+void ModernTextEditor::closeQuickOpen()
+{
+    quick_open_mode = false;
+    quick_open_results.clear();
+    mode = quick_open_previous;
+}
+
+void ModernTextEditor::openQuickOpenResult()
+{
+    if (quick_open_selected < 0 || static_cast<size_t>(quick_open_selected) >= quick_open_results.size())
+        return;
+    std::string path = quick_open_results[quick_open_selected].path;
+    std::replace(path.begin(), path.end(), '/', '\\');
+    closeQuickOpen();
+
+    // Sonuç paneli düzenlenemez: dosya ilk editör panelinde açılır
+    if (panes[active_pane].find_results)
+    {
+        for (size_t i = 0; i < panes.size(); i++)
+        {
+            if (!panes[i].find_results)
+            {
+                switchToPane(static_cast<int>(i));
+                break;
+            }
+        }
+    }
+    std::string root = path_index->root();
+    if (!root.empty() && root.back() != '\\' && root.back() != '/')
+        root += "\\";
+    loadFile(root + path);
+}
+
+void ModernTextEditor::handlePathsProgress()
+{
+    // Liste açıksa yeni yollarla yeniden sorgulanır
+    if (quick_open_mode && path_index)
+    {
+        updateQuickOpen();
+        invalidateChanges();
+    }
+}
+
+RECT ModernTextEditor::quickOpenRect(size_t rows)
+{
+    RECT client_rect;
+    GetClientRect(hwnd, &client_rect);
+
+    // Editör alanının üst ortasında, VS Code'daki gibi
+    int left = showFileExplorer ? fileExplorer.rect.right : client_rect.left;
+    int width = std::min(static_cast<int>(client_rect.right - left) - 40, 90 * char_width);
+    RECT box = {left + (client_rect.right - left - width) / 2, client_rect.top + 10, 0, 0};
+    box.right = box.left + width;
+    box.bottom = box.top + (static_cast<int>(rows) + 1) * (char_height + 2) + 12;
+    return box;
+}
+
+void ModernTextEditor::drawQuickOpen(Renderer &renderer)
 {
-    DeleteObject(hFont);
+    int line_height = char_height + 2;
+    int rows = static_cast<int>(quick_open_results.size());
+    RECT box = quickOpenRect(quick_open_results.size());
+    renderer.fillRect(renderRect(box), QUICK_OPEN_COLOR);
+
+    std::string prompt = "> " + quick_open_text + "_";
+    renderer.drawText(box.left + 8, box.top + 4, prompt.c_str(), prompt.length(), renderColor(255, 255, 255),
+                      TRANSPARENT_COLOR);
+
+    int y = box.top + 8 + line_height;
+    for (int i = 0; i < rows; i++, y += line_height)
+    {
+        const PathMatch &match = quick_open_results[i];
+        if (i == quick_open_selected)
+        {
+            RECT selected = {box.left, y, box.right, y + line_height};
+            renderer.fillRect(renderRect(selected), HIGHLIGHT_COLOR);
+        }
+
+        // Yol gri, eşleşen karakterler turuncu (yazı tipi sabit genişlikli)
+        int x = box.left + 8;
+        renderer.drawText(x, y, match.path.c_str(), match.path.length(), LIST_TEXT_COLOR, TRANSPARENT_COLOR);
+        for (uint16_t pos : match.positions)
+            renderer.drawText(x + pos * char_width, y, match.path.c_str() + pos, 1, CURSOR_COLOR, TRANSPARENT_COLOR);
+    }
+}
 
+void ModernTextEditor::increaseFontSize()
+{
     // Font boyutunu artır (maksimum 24)
     if (current_font_size < 24)
         current_font_size += 2;
 
-    hFont = CreateFont(current_font_size, 0, 0, 0, FW_BOLD, FALSE, FALSE, FALSE,
-                       ANSI_CHARSET, OUT_DEFAULT_PRECIS, CLIP_DEFAULT_PRECIS,
-                       CLEARTYPE_QUALITY, FIXED_PITCH | FF_MODERN, TEXT("0xNerd Proto"));
-
     calculateCharSize();
     updatePaneLayout();
     status_message = "Font size increased to " + std::to_string(current_font_size);
@@ -1868,16 +3273,10 @@ void ModernTextEditor::increaseFontSize()
 
 void ModernTextEditor::decreaseFontSize()
 {
-    DeleteObject(hFont);
-
     // Font boyutunu azalt (minimum 8)
     if (current_font_size > 8)
         current_font_size -= 2;
 
-    hFont = CreateFont(current_font_size, 0, 0, 0, FW_BOLD, FALSE, FALSE, FALSE,
-                       ANSI_CHARSET, OUT_DEFAULT_PRECIS, CLIP_DEFAULT_PRECIS,
-                       CLEARTYPE_QUALITY, FIXED_PITCH | FF_MODERN, TEXT("0xNerd Proto"));
-
     calculateCharSize();
     updatePaneLayout();
     status_message = "Font size decreased to " + std::to_string(current_font_size);
@@ -1885,15 +3284,9 @@ void ModernTextEditor::decreaseFontSize()
 
 void ModernTextEditor::resetFontSize()
 {
-    DeleteObject(hFont);
-
     // Font boyutunu sıfırla (varsayılan 16)
     current_font_size = 16;
 
-    hFont = CreateFont(current_font_size, 0, 0, 0, FW_BOLD, FALSE, FALSE, FALSE,
-                       ANSI_CHARSET, OUT_DEFAULT_PRECIS, CLIP_DEFAULT_PRECIS,
-                       CLEARTYPE_QUALITY, FIXED_PITCH | FF_MODERN, TEXT("0xNerd Proto"));
-
     calculateCharSize();
     updatePaneLayout();
     status_message = "Font size reset to " + std::to_string(current_font_size);
@@ -1902,28 +3295,197 @@ void ModernTextEditor::resetFontSize()
 void ModernTextEditor::ensureCursorVisible()
 {
     EditorPane &pane = panes[active_pane];
+    syncWrap(pane);
 
-    // Pane boyutlarını hesapla
-    int visible_lines = (pane.rect.bottom - pane.rect.top - 60) / (char_height + 2);
+    // Pane boyutlarını hesapla; konumlar görsel satır cinsinden (kaydırma kapalıyken belge satırı)
+    long long visible_lines = (pane.rect.bottom - pane.rect.top - 60) / (char_height + 2);
+    long long top = static_cast<long long>(visualRow(pane, pane.scroll_top, 0)) + pane.scroll_row;
+    long long cursor = static_cast<long long>(visualRow(pane, pane.cursor_row, pane.cursor_col));
 
-    // Cursor üstte görünmüyor - yukarı scroll
-    if (pane.cursor_row < pane.scroll_top)
+    // Cursor üstte görünmüyor ya da yarım görünüyor - yukarı scroll
+    if (cursor < top || (cursor == top && pane.scroll_pixel > 0))
     {
-        pane.scroll_top = pane.cursor_row;
+        top = cursor;
+        pane.scroll_pixel = 0;
     }
     // Cursor altta görünmüyor - aşağı scroll
-    else if (pane.cursor_row >= pane.scroll_top + visible_lines)
+    else if (cursor >= top + visible_lines)
     {
-        pane.scroll_top = pane.cursor_row - visible_lines + 1;
+        top = cursor - visible_lines + 1;
+        pane.scroll_pixel = 0;
     }
 
     // Scroll sınırlarını kontrol et
-    if (pane.scroll_top < 0)
-        pane.scroll_top = 0;
+    if (top < 0)
+        top = 0;
 
-    int max_scroll = static_cast<int>(pane.lines.size()) - visible_lines;
+    long long max_scroll = static_cast<long long>(totalVisualRows(pane)) - visible_lines;
     if (max_scroll < 0)
         max_scroll = 0;
-    if (pane.scroll_top > max_scroll)
-        pane.scroll_top = max_scroll;
+    if (top >= max_scroll)
+    {
+        top = max_scroll;
+        pane.scroll_pixel = 0;
+    }
+    setTopVisualRow(pane, static_cast<size_t>(top));
+
+    // Satır kaydırmada yatay scroll yok
+    if (wrap_lines)
+    {
+        pane.scroll_left = 0;
+        return;
+    }
+
+    // Cursor sağda ya da solda görünmüyor - yatay scroll; her karakterde panel kaymasın diye çeyrek genişlik pay
+    int text_width = pane.rect.right - pane.rect.left - 50;
+    int visible_cols = std::max(text_width / std::max(char_width, 1) - 1, 1);
+    if (pane.cursor_col < pane.scroll_left)
+        pane.scroll_left = std::max(pane.cursor_col - visible_cols / 4, 0);
+    else if (pane.cursor_col >= pane.scroll_left + visible_cols)
+        pane.scroll_left = pane.cursor_col - visible_cols * 3 / 4;
+}
+
+int ModernTextEditor::wrapColumns(const EditorPane &pane)
+{
+    // Metin alanına tam sığan sütunlar (TextView'daki yerleşimle aynı)
+    int text_width = pane.rect.right - pane.rect.left - 50;
+    return std::max(text_width / std::max(char_width, 1), 1);
+}
+
+size_t ModernTextEditor::visualRow(const EditorPane &pane, int row, int col)
+{
+    if (!wrap_lines)
+        return static_cast<size_t>(std::max(row, 0));
+    return pane.wrap.rowsBefore(row) + static_cast<size_t>(std::max(col, 0) / std::max(pane.wrap.columns(), 1));
+}
+
+size_t ModernTextEditor::totalVisualRows(const EditorPane &pane)
+{
+    return wrap_lines ? pane.wrap.totalRows() : static_cast<size_t>(pane.document.lineCount());
+}
+
+void ModernTextEditor::setTopVisualRow(EditorPane &pane, size_t row)
+{
+    if (wrap_lines)
+    {
+        pane.scroll_top = pane.wrap.lineAt(row, pane.scroll_row);
+        return;
+    }
+    pane.scroll_top = static_cast<int>(row);
+    pane.scroll_row = 0;
+}
+
+void ModernTextEditor::moveCursorRows(EditorPane &pane, int rows)
+{
+    // İmleç görsel satır kadar ilerler; satır kaydırmada satır parçası içindeki sütunu korunur
+    syncWrap(pane);
+    long long target = static_cast<long long>(visualRow(pane, pane.cursor_row, pane.cursor_col)) + rows;
+    target = std::max(0LL, std::min(target, static_cast<long long>(totalVisualRows(pane)) - 1));
+
+    int sub_row = 0;
+    int column = pane.cursor_col;
+    if (wrap_lines)
+    {
+        int columns = std::max(pane.wrap.columns(), 1);
+        pane.cursor_row = pane.wrap.lineAt(static_cast<size_t>(target), sub_row);
+        column = sub_row * columns + pane.cursor_col % columns;
+    }
+    else
+    {
+        pane.cursor_row = static_cast<int>(target);
+    }
+    pane.cursor_col = std::min(column, pane.document.lineLength(pane.cursor_row));
+}
+
+void ModernTextEditor::syncWrap(EditorPane &pane)
+{
+    // Ölçüm düzenleme (updateWrap), yükleme ve boyut işleyicilerinden başlar; çizim ve kaydırma burada
+    // ölçüm başlatmaz. Yükleme sürerken eklenen satırlar tek görsel satır sayılır, yükleme bitince ölçülür
+    if (wrap_lines && pane.wrap.lineCount() != pane.document.lineCount())
+        pane.wrap.reset(pane.document.lineCount(), pane.wrap.columns(), pane.document.revision());
+}
+
+void ModernTextEditor::startWrap(EditorPane &pane)
+{
+    // Ölçüm bitene kadar eski sayılarla (satır sayısı değiştiyse tek görsel satır varsayımıyla) devam edilir;
+    // görünür satırlar hemen, kalanı belgenin anlık görüntüsü üzerinde arka planda ölçülür
+    int columns = wrapColumns(pane);
+    pane.wrap.reset(pane.document.lineCount(), columns, pane.document.revision());
+    pane.wrap_worker.reset();
+    pane.wrap_edits.clear();
+    if (!pane.loader)
+    {
+        HWND target = hwnd;
+        pane.wrap_worker = std::make_shared<WrapWorker>(pane.document.snapshot(), columns, [target]()
+                                                        { PostMessage(target, WM_WRAP_PROGRESS, 0, 0); });
+    }
+    wrapVisibleLines(pane);
+}
+
+void ModernTextEditor::wrapVisibleLines(EditorPane &pane)
+{
+    // Arka plan ölçümü ya da yükleme sürerken ekrandaki satırlar ve imleç satırı hemen ölçülür
+    if (!wrap_lines || (!pane.wrap_worker && !pane.loader))
+        return;
+
+    int visible_rows = (pane.rect.bottom - pane.rect.top - 60) / (char_height + 2) + 2;
+    int rows = -pane.scroll_row;
+    for (int line = pane.scroll_top; line < pane.wrap.lineCount() && rows < visible_rows; line++)
+    {
+        pane.wrap.replaceLines(pane.document, line, 1, 1);
+        rows += static_cast<int>(pane.wrap.rows(line));
+    }
+    if (pane.cursor_row < pane.wrap.lineCount())
+        pane.wrap.replaceLines(pane.document, pane.cursor_row, 1, 1);
+    pane.scroll_row = std::min(pane.scroll_row, static_cast<int>(pane.wrap.rows(pane.scroll_top)) - 1);
+}
+
+void ModernTextEditor::updateWrap(EditorPane &pane, size_t revision, int line_count,
+                                  const std::vector<TextChange> *changes)
+{
+    // Sadece düzenlenen satırlar yeniden ölçülür. Düzen düzenleme öncesi belgeye ait değilse ya da
+    // değişiklikler bilinmiyorsa baştan ölçülür
+    if (!wrap_lines)
+        return;
+    if (!changes || pane.wrap.revision() != revision || pane.wrap.lineCount() != line_count)
+    {
+        startWrap(pane);
+        return;
+    }
+
+    WrapLayout::LineEdit edit;
+    long long delta = pane.wrap.update(pane.document, line_count, *changes, &edit);
+    if (pane.wrap_worker && pane.wrap.revision() == pane.document.revision())
+        pane.wrap_edits.push_back(edit); // arka plan sonucu bu düzenlemelerle kaydırılarak alınacak
+    if (delta != 0 && pane.dirty_first <= pane.dirty_last)
+        markDirtyRows(pane, pane.dirty_first, INT_MAX); // satırın görsel satır sayısı değişti, alttakiler kayar
+}
+
+void ModernTextEditor::handleWrapProgress()
+{
+    for (EditorPane &pane : panes)
+    {
+        if (!pane.wrap_worker || !pane.wrap_worker->finished())
+            continue;
+
+        // Ölçüm sürerken yapılan düzenlemeler sonuca işlenir; genişlik değiştiyse ya da düzenlemelerden biri
+        // izlenemediyse sonuç eskidir, yeniden ölçülür
+        std::shared_ptr<WrapWorker> worker = std::move(pane.wrap_worker);
+        pane.wrap_worker.reset();
+        std::vector<WrapLayout::LineEdit> edits;
+        edits.swap(pane.wrap_edits);
+        if (!wrap_lines)
+            continue;
+        if (worker->columns() != wrapColumns(pane) || worker->columns() != pane.wrap.columns() ||
+            pane.wrap.revision() != pane.document.revision() || !pane.wrap.merge(worker->takeRows(), edits))
+        {
+            startWrap(pane);
+            continue;
+        }
+
+        // Üstteki satır yerinde kalır; altındakiler gerçek sayılarıyla yeniden dizilir
+        pane.scroll_row = std::min(pane.scroll_row, static_cast<int>(pane.wrap.rows(pane.scroll_top)) - 1);
+        InvalidateRect(hwnd, &pane.rect, FALSE);
+    }
+    invalidateChanges();
 }
\ No newline at end of file
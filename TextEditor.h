@@ -9,7 +9,29 @@
 #include <richedit.h>
 #include <commdlg.h>
 #include <algorithm>
+#include <memory>
 #include "EditorPane.h"
+#include "LineScanner.h"
+#include "MatchList.h"
+#include "FindInFiles.h"
+#include "PathIndex.h"
+#include "RenderResources.h"
+#include "Renderer.h"
+#include "SearchWorker.h"
+#include "TrigramIndex.h"
+
+// Arka plan yükleyicisinin ilerleme mesajı
+const UINT WM_LOAD_PROGRESS = WM_APP + 1;
+// Arka plan aramasının ilerleme mesajı
+const UINT WM_SEARCH_PROGRESS = WM_APP + 2;
+// Dosyalarda aramanın ilerleme mesajı
+const UINT WM_FIND_PROGRESS = WM_APP + 3;
+// Çalışma alanı indeksi taramasının bitiş mesajı
+const UINT WM_INDEX_PROGRESS = WM_APP + 4;
+// Hızlı dosya açma yol listesi taramasının bitiş mesajı
+const UINT WM_PATHS_PROGRESS = WM_APP + 5;
+// Satır kaydırma ölçümünün bitiş mesajı
+const UINT WM_WRAP_PROGRESS = WM_APP + 6;
 
 // Editör modları
 enum EditorMode
@@ -73,6 +95,61 @@ struct Terminal
     Terminal() : scrollTop(0), isActive(false) {}
 };
 
+// Ekranda en son çizilen durumun özeti. Tuş ve mesajlardan sonra mevcut durumla karşılaştırılır,
+// sadece değişen satırlar, paneller ve status bar geçersiz kılınır.
+struct PaneView
+{
+    RECT rect;
+    int scroll_top;
+    int scroll_row;
+    int scroll_pixel;
+    int scroll_left;
+    int cursor_row;
+    int cursor_col;
+    int line_count;
+    size_t revision;
+    bool is_active;
+};
+
+struct ViewState
+{
+    std::vector<PaneView> panes;
+    bool show_explorer;
+    bool show_terminal;
+    int font_size;
+    bool quick_open;
+    std::string quick_open_text;
+    size_t quick_open_rows;
+    int quick_open_selected;
+    int search_pane;
+    size_t search_generation;
+    std::string status;
+    int explorer_selected;
+    int explorer_scroll;
+    size_t explorer_items;
+    std::string explorer_path;
+    size_t terminal_lines;
+    int terminal_scroll;
+    bool terminal_active;
+    std::string terminal_input;
+};
+
+// Yeniden çizim sayaçları (:repaints)
+struct RepaintStats
+{
+    unsigned long long frames;
+    unsigned long long lines;  // çizilen metin satırları
+    unsigned long long pixels; // yeniden çizilen alan
+    int last_lines;
+    long long last_pixels;
+    long long window_pixels; // son çerçevede pencerenin alanı
+    unsigned long long last_allocations; // son çerçevede oluşturulan çizim kaynakları
+    unsigned long long allocations;
+
+    RepaintStats() : frames(0), lines(0), pixels(0), last_lines(0), last_pixels(0), window_pixels(0),
+                     last_allocations(0), allocations(0) {}
+};
+
 // Ana editör sınıfı
 class ModernTextEditor
 {
@@ -103,35 +180,67 @@ private:
     bool replace_mode;
     std::string search_text;
     std::string replace_text;
-    int current_search_result;
+    bool search_ignore_case; // :ignorecase ile değişir
+    bool search_use_regex;   // :regex ile değişir
+    bool replace_field;      // değiştirme girişinde Tab ile ikinci alana geçildi
+    std::unique_ptr<SearchQuery> search_query; // desen ya da ayarlar değişince yeniden derlenir
+
+    // Artımlı arama: görünür bölge hemen, belgenin kalanı arka planda taranır
+    std::unique_ptr<SearchWorker> search_worker; // tarama sürerken dolu
+    MatchList search_matches;                    // belge sırasında; düzenlemelerle birlikte güncellenir
+    EditMap search_edits;       // tarama sürerken yapılan düzenlemeler; gelen sonuçlar bunlarla kaydırılır
+    size_t search_taken;        // arka plandan alınan son offset (anlık görüntüde)
+    size_t search_scanned;      // arka planın taradığı offset (belgenin son halinde)
+    size_t search_visible_from; // görünür bölge taramasının başı
+    size_t search_origin;       // arama başladığında imleç
+    size_t search_revision;     // eşleşmelerin güncel olduğu belge sürümü
+    int search_pane;            // eşleşmelerin ait olduğu panel, yoksa -1
+    bool search_jump_pending;   // imleç henüz ilk eşleşmeye gitmedi
+    size_t search_generation;   // eşleşmeler yeniden hesaplandıkça artar (panel yeniden çizilir)
+
+    // Dosyalarda arama (:find) - sonuçlar ayrı panelde akarak görünür
+    std::unique_ptr<FindInFiles> find_search; // arama sürerken dolu
+    std::vector<FileMatch> find_results;      // sonuç panelinin satırları (başlık satırından sonra)
+    std::string find_root;
+    std::string find_text;
+    bool find_indexed; // trigram indeksi dosya eledi (özet notu)
+    DWORD find_started;
+
+    // Kök dizinin trigram indeksi: :find ilk kullanımda yükler, bayatsa arka planda tazeler
+    std::unique_ptr<TrigramIndex> trigram_index;
+    DWORD index_refreshed;
+
+    // Hızlı dosya açma (Ctrl+P) - yazdıkça bulanık eşleşen yollar açılır listede görünür
+    std::unique_ptr<PathIndex> path_index;
+    DWORD paths_refreshed;
+    bool quick_open_mode;
+    EditorMode quick_open_previous; // kapanınca dönülecek mod
+    std::string quick_open_text;
+    std::vector<PathMatch> quick_open_results;
+    size_t quick_open_total;
+    int quick_open_selected;
+
+    // Undo/Redo system - her pane kendi geçmişini tutar, toplam bellek bütçeyle sınırlı
+    size_t undo_budget;
 
-    // Undo/Redo system
-    struct UndoState
-    {
-        std::vector<std::string> lines;
-        int cursor_row;
-        int cursor_col;
-        std::string operation;
-    };
+    // Kısmi yeniden çizim: ekrandaki durum ve sayaçlar
+    ViewState painted;
+    bool painted_valid;
+    RepaintStats repaint_stats;
 
-    std::vector<UndoState> undo_stack;
-    std::vector<UndoState> redo_stack;
-    int max_undo_levels;
+    // Tekerlekle yumuşak kaydırma: zamanlayıcıyla kademeli uygulanan kalan piksel
+    int wheel_pane;
+    int wheel_remaining;
+
+    // Satır kaydırma (:wrap ile değişir); kaydırma konumu görsel satır cinsindendir
+    bool wrap_lines;
 
     // Font ayarları
-    HFONT hFont;
+    RenderResources resources; // arka tampon, yazı tipleri ve glyph atlasları (çizimler arasında kalıcı)
     int char_width;
     int char_height;
     int current_font_size;
 
-    // Renkler
-    HBRUSH bg_brush;
-    HBRUSH status_brush;
-    HBRUSH cursor_brush;
-    HBRUSH selection_brush;
-    HBRUSH explorer_brush;
-    HBRUSH terminal_brush;
-
 public:
     ModernTextEditor();
     ~ModernTextEditor();
@@ -164,22 +273,36 @@ public:
     void openFile();
     void loadFile(const std::string &filename);
     void saveFile();
-    void paint(HDC hdc);
-    void drawPane(HDC hdc, const EditorPane &pane, int pane_index);
-    void drawSelection(HDC hdc, const EditorPane &pane, int current_line, int line_y);
-    void drawStatusBar(HDC hdc);
+    void paint(HDC hdc, const RECT &area);
+    int drawPane(Renderer &renderer, const EditorPane &pane, int pane_index, const RECT &area);
+    void drawSelection(Renderer &renderer, const EditorPane &pane, int current_line, int line_y);
+    void drawStatusBar(Renderer &renderer);
+    std::string statusText(std::string &mode_info);
+    RECT statusBarRect();
+    RECT quickOpenRect(size_t rows);
+
+    // Kısmi yeniden çizim
+    ViewState captureView();
+    void invalidateChanges();
+    void invalidateRows(const EditorPane &pane, int first, int last);
+    void markDirtyRows(EditorPane &pane, int first, int last);
+    bool scrollPixels(const EditorPane &pane, int dy);
+    std::string repaintReport();
     void handleResize();
     void handleMouseClick(int x, int y);
+    void handleMouseWheel(int delta, int x, int y);
+    void handleTimer(UINT_PTR id);
+    void scrollPane(EditorPane &pane, int pixels);
 
     // New methods for file explorer and terminal
     void initializeFileExplorer();
     void refreshFileExplorer();
-    void drawFileExplorer(HDC hdc);
+    void drawFileExplorer(Renderer &renderer);
     void handleFileExplorerClick(int x, int y);
     void loadDirectory(const std::string &path, std::vector<FileItem> &items, int level);
     FileType getFileType(const std::string &filename);
 
-    void drawTerminal(HDC hdc);
+    void drawTerminal(Renderer &renderer);
     void handleTerminalInput(char ch);
     void executeTerminalCommand(const std::string &command);
     void addTerminalOutput(const std::string &text);
@@ -190,9 +313,35 @@ public:
     void startReplace();
     void performSearch();
     void performReplace();
+    void replaceAll(const std::string &pattern, const std::string &replacement, bool ignore_case);
+    bool findMatch(EditorPane &pane, size_t from, size_t to, size_t &match_start, size_t &match_end);
+    SearchQuery &currentQuery();
+    std::string searchPrompt();
+    std::string searchCounter();
+    void updateIncrementalSearch(bool jump = true);
+    void handleSearchProgress();
+    void jumpToSearchMatch();
+    void clearSearchMatches();
+    void updateSearchMatches(EditorPane &pane, size_t revision, const std::vector<TextChange> *changes);
+    void startFindInFiles(const std::string &text);
+    void handleFindProgress();
+    TrigramIndex &workspaceIndex(const std::string &root);
+    void refreshWorkspaceIndex();
+    void handleIndexProgress();
+    void openFindResult();
+    int findResultsPane();
 
     // Undo/Redo functions
-    void saveUndoState(const std::string &operation);
+    void saveUndoState(const std::string &operation, bool mergeable = false);
+    void beginUndoGroup(const std::string &operation);
+    void endUndoGroup();
+    void enforceUndoBudget();
+    void undoTimeTravel(bool earlier, const std::string &amount);
+    void jumpToUndoState(size_t state);
+    void dropDivergedHistory(EditorPane &pane, size_t revision, int line_count);
+    std::string undoMemoryReport();
+    void editInsert(EditorPane &pane, size_t offset, const std::string &text);
+    void editErase(EditorPane &pane, size_t start, size_t end);
     void performUndo();
     void performRedo();
 
@@ -202,8 +351,33 @@ public:
     void selectCurrentLine();
     void startGoToLine();
     void startQuickOpen();
+    void updateQuickOpen();
+    void closeQuickOpen();
+    void openQuickOpenResult();
+    void handlePathsProgress();
+    void drawQuickOpen(Renderer &renderer);
     void increaseFontSize();
     void decreaseFontSize();
     void resetFontSize();
     void ensureCursorVisible();
+
+    // Satır kaydırma: görsel satırlar, panel düzeninin belgeyle eşitlenmesi ve arka plan ölçümü
+    int wrapColumns(const EditorPane &pane);
+    size_t visualRow(const EditorPane &pane, int row, int col);
+    size_t totalVisualRows(const EditorPane &pane);
+    void setTopVisualRow(EditorPane &pane, size_t row);
+    void moveCursorRows(EditorPane &pane, int rows);
+    void syncWrap(EditorPane &pane);
+    void startWrap(EditorPane &pane);
+    void wrapVisibleLines(EditorPane &pane);
+    void updateWrap(EditorPane &pane, size_t revision, int line_count, const std::vector<TextChange> *changes);
+    void handleWrapProgress();
+
+    // Arka planda dosya yükleme
+    void handleLoadProgress();
+    void drainLoader(EditorPane &pane);
+    void openJournal(EditorPane &pane);
+    std::shared_ptr<UndoJournal> claimJournal(EditorPane &pane);
+    void waitForLines(EditorPane &pane, int row);
+    bool canEdit();
 };
\ No newline at end of file
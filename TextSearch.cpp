@@ -0,0 +1,349 @@
+#include "TextSearch.h"
+
+#include <algorithm>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define GLITCH_X86 1
+#include <immintrin.h>
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+#define GLITCH_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define GLITCH_TARGET_AVX2
+#endif
+
+namespace
+{
+    // Bu uzunluktan itibaren filtre yerine two-way kullanılır (aday doğrulaması O(n*m)'e kaymasın)
+    const size_t LONG_NEEDLE = 32;
+
+    struct FoldTables
+    {
+        unsigned char identity[256];
+        unsigned char lower[256];
+
+        FoldTables()
+        {
+            for (int i = 0; i < 256; i++)
+            {
+                identity[i] = static_cast<unsigned char>(i);
+                lower[i] = static_cast<unsigned char>(i >= 'A' && i <= 'Z' ? i + 32 : i);
+            }
+        }
+    };
+
+    const FoldTables &foldTables()
+    {
+        static const FoldTables tables;
+        return tables;
+    }
+
+    inline unsigned countTrailingZeros(uint32_t mask)
+    {
+#ifdef _MSC_VER
+        unsigned long index;
+        _BitScanForward(&index, mask);
+        return index;
+#else
+        return __builtin_ctz(mask);
+#endif
+    }
+
+    // SIMD karşılaştırmasında harfler için 0x20 bitini zorla: ('A' | 0x20) == 'a'
+    inline char caseBit(unsigned char ch, bool ignore_case)
+    {
+        return ignore_case && ch >= 'a' && ch <= 'z' ? 0x20 : 0;
+    }
+}
+
+TextSearcher::TextSearcher(const std::string &needle, bool ignore_case)
+    : fold(ignore_case ? foldTables().lower : foldTables().identity), ignore_case(ignore_case),
+      kind(detectScanner()), two_way(false), critical(0), period(1), periodic(false)
+{
+    pattern.resize(needle.size());
+    for (size_t i = 0; i < needle.size(); i++)
+        pattern[i] = static_cast<char>(fold[static_cast<unsigned char>(needle[i])]);
+
+    size_t m = pattern.size();
+    if (m < LONG_NEEDLE)
+        return;
+
+    // Kritik faktörleştirme: iki sıralamaya göre maksimal sonekten uzun olanı
+    const unsigned char *n = reinterpret_cast<const unsigned char *>(pattern.data());
+    size_t best_suffix = 0;
+    size_t best_period = 1;
+    for (int order = 0; order < 2; order++)
+    {
+        size_t ip = static_cast<size_t>(-1); // -1'den başlar, ip + k taşmasıyla doğru çalışır
+        size_t jp = 0;
+        size_t k = 1;
+        size_t p = 1;
+        while (jp + k < m)
+        {
+            unsigned char a = n[ip + k];
+            unsigned char b = n[jp + k];
+            if (a == b)
+            {
+                if (k == p)
+                {
+                    jp += p;
+                    k = 1;
+                }
+                else
+                {
+                    k++;
+                }
+            }
+            else if (order == 0 ? a > b : a < b)
+            {
+                jp += k;
+                k = 1;
+                p = jp - ip;
+            }
+            else
+            {
+                ip = jp++;
+                k = p = 1;
+            }
+        }
+        if (order == 0 || ip + 1 > best_suffix + 1)
+        {
+            best_suffix = ip;
+            best_period = p;
+        }
+    }
+
+    two_way = true;
+    critical = best_suffix;
+    periodic = memcmp(n, n + best_period, critical + 1) == 0;
+    period = periodic ? best_period : std::max(critical + 1, m - critical - 1) + 1;
+
+    shift.assign(256, 0);
+    for (size_t i = 0; i < m; i++)
+        shift[n[i]] = i + 1;
+}
+
+bool TextSearcher::verify(const char *candidate) const
+{
+    size_t m = pattern.size();
+    if (m <= 2)
+        return true;
+    if (!ignore_case)
+        return memcmp(candidate + 1, pattern.data() + 1, m - 2) == 0;
+    for (size_t i = 1; i + 1 < m; i++)
+    {
+        if (fold[static_cast<unsigned char>(candidate[i])] != static_cast<unsigned char>(pattern[i]))
+            return false;
+    }
+    return true;
+}
+
+#ifdef GLITCH_X86
+namespace
+{
+    // İlk byte'ı i'de ve son byte'ı i + m - 1'de tutan konumların maskesi, sonra doğrulama
+    // Bulunamazsa i taranmamış kuyruğun başında kalır
+    template <typename Verify>
+    size_t filterSse2(const char *data, size_t size, size_t &i, const std::string &pattern, bool ignore_case,
+                      Verify verify)
+    {
+        size_t m = pattern.size();
+        unsigned char head = static_cast<unsigned char>(pattern[0]);
+        unsigned char tail = static_cast<unsigned char>(pattern[m - 1]);
+        const __m128i first = _mm_set1_epi8(static_cast<char>(head));
+        const __m128i last = _mm_set1_epi8(static_cast<char>(tail));
+        const __m128i first_case = _mm_set1_epi8(caseBit(head, ignore_case));
+        const __m128i last_case = _mm_set1_epi8(caseBit(tail, ignore_case));
+
+        for (; i + m - 1 + 16 <= size; i += 16)
+        {
+            __m128i a = _mm_or_si128(_mm_loadu_si128(reinterpret_cast<const __m128i *>(data + i)), first_case);
+            __m128i b = _mm_or_si128(_mm_loadu_si128(reinterpret_cast<const __m128i *>(data + i + m - 1)), last_case);
+            uint32_t mask = static_cast<uint32_t>(_mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(a, first), _mm_cmpeq_epi8(b, last))));
+            while (mask)
+            {
+                size_t pos = i + countTrailingZeros(mask);
+                if (verify(data + pos))
+                    return pos;
+                mask &= mask - 1;
+            }
+        }
+        return TextSearcher::npos;
+    }
+
+    template <typename Verify>
+    GLITCH_TARGET_AVX2 size_t filterAvx2(const char *data, size_t size, size_t &i, const std::string &pattern,
+                                         bool ignore_case, Verify verify)
+    {
+        size_t m = pattern.size();
+        unsigned char head = static_cast<unsigned char>(pattern[0]);
+        unsigned char tail = static_cast<unsigned char>(pattern[m - 1]);
+        const __m256i first = _mm256_set1_epi8(static_cast<char>(head));
+        const __m256i last = _mm256_set1_epi8(static_cast<char>(tail));
+        const __m256i first_case = _mm256_set1_epi8(caseBit(head, ignore_case));
+        const __m256i last_case = _mm256_set1_epi8(caseBit(tail, ignore_case));
+
+        for (; i + m - 1 + 32 <= size; i += 32)
+        {
+            __m256i a = _mm256_or_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(data + i)), first_case);
+            __m256i b = _mm256_or_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(data + i + m - 1)), last_case);
+            uint32_t mask = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_and_si256(_mm256_cmpeq_epi8(a, first), _mm256_cmpeq_epi8(b, last))));
+            while (mask)
+            {
+                size_t pos = i + countTrailingZeros(mask);
+                if (verify(data + pos))
+                    return pos;
+                mask &= mask - 1;
+            }
+        }
+        return TextSearcher::npos;
+    }
+}
+#endif
+
+size_t TextSearcher::findFiltered(const char *data, size_t size, size_t from) const
+{
+    size_t m = pattern.size();
+    size_t i = from;
+
+#ifdef GLITCH_X86
+    auto check = [this](const char *candidate)
+    { return verify(candidate); };
+
+    size_t result = npos;
+    if (kind == SCANNER_AVX2)
+        result = filterAvx2(data, size, i, pattern, ignore_case, check);
+    else if (kind == SCANNER_SSE2)
+        result = filterSse2(data, size, i, pattern, ignore_case, check);
+    if (result != npos)
+        return result;
+#endif
+
+    // Kalan kuyruk (ya da SIMD'siz platform)
+    unsigned char head = static_cast<unsigned char>(pattern[0]);
+    unsigned char tail = static_cast<unsigned char>(pattern[m - 1]);
+    for (; i + m <= size; i++)
+    {
+        if (!ignore_case)
+        {
+            // Hassas aramada ilk byte'a memchr ile atla
+            const void *hit = memchr(data + i, head, size - m + 1 - i);
+            if (!hit)
+                return npos;
+            i = static_cast<const char *>(hit) - data;
+        }
+        else if (fold[static_cast<unsigned char>(data[i])] != head)
+        {
+            continue;
+        }
+        if (fold[static_cast<unsigned char>(data[i + m - 1])] == tail && verify(data + i))
+            return i;
+    }
+    return npos;
+}
+
+size_t TextSearcher::findTwoWay(const char *data, size_t size, size_t from) const
+{
+    size_t m = pattern.size();
+    const unsigned char *n = reinterpret_cast<const unsigned char *>(pattern.data());
+    const unsigned char *h = reinterpret_cast<const unsigned char *>(data);
+    size_t memory = 0; // periyodik iğnede zaten eşleştiği bilinen önek
+
+    size_t pos = from;
+    while (pos + m <= size)
+    {
+        // Önce son byte: iğnede yoksa tamamen atla, varsa son geçtiği yere hizala
+        size_t skip = m - shift[fold[h[pos + m - 1]]];
+        if (skip)
+        {
+            pos += std::max(skip, memory);
+            memory = 0;
+            continue;
+        }
+
+        // Sağ yarı
+        size_t k = std::max(critical + 1, memory);
+        while (k < m && n[k] == fold[h[pos + k]])
+            k++;
+        if (k < m)
+        {
+            pos += k - critical;
+            memory = 0;
+            continue;
+        }
+
+        // Sol yarı
+        k = critical + 1;
+        while (k > memory && n[k - 1] == fold[h[pos + k - 1]])
+            k--;
+        if (k <= memory)
+            return pos;
+
+        pos += period;
+        memory = periodic ? m - period : 0;
+    }
+    return npos;
+}
+
+size_t TextSearcher::find(const char *data, size_t size, size_t from) const
+{
+    if (pattern.empty())
+        return from <= size ? from : npos;
+    if (from >= size || size - from < pattern.size())
+        return npos;
+    return two_way ? findTwoWay(data, size, from) : findFiltered(data, size, from);
+}
+
+size_t TextSearcher::find(const TextDocument &document, size_t from, size_t to) const
+{
+    to = std::min(to, document.length());
+    size_t m = pattern.size();
+    if (m == 0 || from >= to || to - from < m)
+        return m == 0 && from <= to ? from : npos;
+
+    // Parçalar yerinde aranır; sınırı aşan eşleşmeler için önceki parçanın son m-1 byte'ı
+    // ile sonrakinin ilk m-1 byte'ı küçük bir tamponda birleştirilir
+    size_t result = npos;
+    size_t pos = from;
+    std::string carry;
+    std::string joint;
+
+    document.forEachChunkUntil(from, to - from, [&](const char *data, size_t size)
+                               {
+        if (!carry.empty())
+        {
+            joint.assign(carry);
+            joint.append(data, std::min(size, m - 1));
+            size_t hit = find(joint.data(), joint.size(), 0);
+            if (hit != npos && hit < carry.size())
+            {
+                result = pos - carry.size() + hit;
+                return false;
+            }
+        }
+
+        size_t hit = find(data, size, 0);
+        if (hit != npos)
+        {
+            result = pos + hit;
+            return false;
+        }
+
+        // Eşleşmenin başlayabileceği son m-1 byte taşınır
+        if (size >= m - 1)
+        {
+            carry.assign(data + size - (m - 1), m - 1);
+        }
+        else
+        {
+            carry.append(data, size);
+            if (carry.size() > m - 1)
+                carry.erase(0, carry.size() - (m - 1));
+        }
+        pos += size;
+        return true; });
+
+    return result;
+}
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+#include "LineScanner.h"
+#include "TextDocument.h"
+
+// Önceden işlenmiş iğne ile alt dizi arama
+// - Kısa iğneler: ilk ve son byte SIMD ile aynı anda filtrelenir (SSE2/AVX2), adaylar doğrulanır
+// - Uzun iğneler: two-way (Crochemore-Perrin), en kötü durumda da doğrusal
+// - Büyük/küçük harf duyarsız arama kopya üretmez; byte'lar tablo ile katlanır (ASCII)
+// - Belge araması piece'lerin bitişik buffer parçaları üzerinde çalışır, parça sınırını aşan eşleşmeler de bulunur
+class TextSearcher
+{
+public:
+    static constexpr size_t npos = static_cast<size_t>(-1);
+
+    TextSearcher(const std::string &needle, bool ignore_case = false);
+
+    bool empty() const { return pattern.empty(); }
+    size_t size() const { return pattern.size(); }
+
+    // data[from, size) içindeki ilk eşleşmenin başlangıcı; yoksa npos
+    size_t find(const char *data, size_t size, size_t from = 0) const;
+    // Belgede tamamen [from, to) içinde kalan ilk eşleşmenin offset'i; yoksa npos
+    size_t find(const TextDocument &document, size_t from, size_t to) const;
+
+private:
+    std::string pattern; // katlanmış iğne
+    const unsigned char *fold;
+    bool ignore_case;
+    ScannerKind kind;
+
+    // two-way ön hesapları (uzun iğneler)
+    bool two_way;
+    size_t critical; // kritik faktörleştirmenin sol yarısının son indeksi
+    size_t period;
+    bool periodic;
+    std::vector<size_t> shift; // son byte'a göre kaydırma (256)
+
+    bool verify(const char *candidate) const;
+    size_t findFiltered(const char *data, size_t size, size_t from) const;
+    size_t findTwoWay(const char *data, size_t size, size_t from) const;
+};
@@ -0,0 +1,160 @@
+#include "TextView.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace
+{
+    // Panel içi yerleşim (TextEditor'daki tıklama ve kaydırma hesaplarıyla aynı)
+    const int TEXT_LEFT = 50;
+    const int TEXT_TOP = 30;
+    const int NUMBER_LEFT = 5;
+
+    const RenderColor BACKGROUND = renderColor(0, 0, 0);
+    const RenderColor LINE_NUMBER = renderColor(255, 165, 0); // turuncu
+    const RenderColor TEXT = renderColor(0, 255, 0);          // Linux terminal yeşili
+    const RenderColor CURSOR = renderColor(255, 165, 0);
+    const RenderColor MATCH = renderColor(90, 70, 0);
+    const RenderColor MATCH_TEXT = renderColor(255, 255, 255);
+    const RenderColor CURRENT_MATCH = renderColor(255, 165, 0);
+    const RenderColor CURRENT_MATCH_TEXT = renderColor(0, 0, 0);
+
+    // text satırın column'dan başlayan görünür kısmıdır
+    void buildLayout(LineLayout &layout, const TextDocument &document, const TextView &view, size_t line,
+                     size_t column, std::string_view text, size_t cursor, std::vector<SearchMatch> &matches)
+    {
+        // 4 haneye sağa yaslı numara
+        int written = std::snprintf(layout.number, sizeof(layout.number), "%4zu", line + 1);
+        layout.number_length = written > 0 ? static_cast<size_t>(written) : 0;
+
+        // Metin yeşil, eşleşen kısımlar vurgu arka planıyla; imleçteki eşleşme ayrı renkte
+        layout.runs.clear();
+        size_t position = 0;
+        if (view.matches)
+        {
+            // Satırla kesişen eşleşmeler O(log n + k) ile bulunur
+            size_t line_start = document.lineStart(static_cast<int>(line)) + column;
+            matches.clear();
+            view.matches->collect(line_start, line_start + text.length(), matches);
+            for (const SearchMatch &match : matches)
+            {
+                size_t from = std::max(match.start, line_start) - line_start;
+                size_t to = std::min(match.end, line_start + text.length()) - line_start;
+                if (from >= to)
+                    continue;
+                if (from > position)
+                    layout.runs.push_back(TextRun{position, from - position, TEXT, BACKGROUND});
+                bool current = match.start == cursor;
+                layout.runs.push_back(TextRun{from, to - from, current ? CURRENT_MATCH_TEXT : MATCH_TEXT,
+                                              current ? CURRENT_MATCH : MATCH});
+                position = to;
+            }
+        }
+        if (position < text.length())
+            layout.runs.push_back(TextRun{position, text.length() - position, TEXT, BACKGROUND});
+    }
+}
+
+RenderRect textViewport(const RenderRect &rect, int char_height)
+{
+    // Üst kenarı panelin alt kenarından bir satır yukarıda kalan her satır tam çizilir
+    int line_height = char_height + 2;
+    int top = rect.top + TEXT_TOP;
+    int rows = std::max(rect.bottom - line_height - top + line_height - 1, 0) / line_height;
+    return RenderRect{rect.left, top, rect.right, top + rows * line_height};
+}
+
+int drawTextView(Renderer &renderer, const TextDocument &document, const TextView &view, const RenderRect &area)
+{
+    int line_height = view.char_height + 2;
+    int text_x = view.rect.left + TEXT_LEFT;
+    size_t line_count = static_cast<size_t>(document.lineCount() - (view.partial_last_line ? 1 : 0));
+    size_t cursor = view.matches ? document.offsetAt(view.cursor_row, view.cursor_col) : 0;
+    // Panele sığan sütunlar (sağdaki yarım karakter dahil); satırların sadece bu kısmı okunur.
+    // Satır kaydırmada her görsel satır satırın sıradaki wrap->columns() sütunudur
+    size_t columns = static_cast<size_t>(std::max(view.rect.right - text_x + view.char_width - 1, 0) /
+                                         std::max(view.char_width, 1));
+    if (view.wrap)
+        columns = static_cast<size_t>(std::max(view.wrap->columns(), 1));
+
+    // Satır alanının dışı arka plan; satırlar alana kırpılır (yumuşak kaydırmada üst ve alt satır yarım görünür)
+    RenderRect outer = renderer.clipRect();
+    RenderRect viewport = textViewport(view.rect, view.char_height);
+    renderer.fillRect(RenderRect{area.left, area.top, area.right, std::min(viewport.top, area.bottom)}, BACKGROUND);
+    renderer.fillRect(RenderRect{area.left, std::max(viewport.bottom, area.top), area.right, area.bottom}, BACKGROUND);
+    RenderRect inner = {std::max(outer.left, area.left), std::max({outer.top, area.top, viewport.top}),
+                        std::min(outer.right, area.right), std::min({outer.bottom, area.bottom, viewport.bottom})};
+    if (inner.top >= inner.bottom)
+        return 0;
+    renderer.setClip(inner);
+
+    // Alanın üstünde kalan görsel satırlar atlanır
+    int line_y = viewport.top - view.scroll_pixel;
+    size_t first = static_cast<size_t>(view.scroll_top);
+    size_t row = view.wrap ? static_cast<size_t>(std::max(view.scroll_row, 0)) : 0;
+    if (inner.top > line_y)
+    {
+        size_t skipped = static_cast<size_t>((inner.top - line_y) / line_height);
+        line_y += static_cast<int>(skipped) * line_height;
+        for (; skipped > 0 && first < line_count; skipped--)
+        {
+            if (!view.wrap || ++row >= view.wrap->rows(static_cast<int>(first)))
+            {
+                first++;
+                row = 0;
+            }
+        }
+    }
+
+    // Her piksel bir kez yazılır: arka plan sadece yazı hücrelerinin dışında kalan yerlere doldurulur
+    int drawn = 0;
+    std::string scratch;
+    LineLayout layout;
+    std::vector<SearchMatch> matches;
+    for (size_t i = first; i < line_count && line_y < inner.bottom;)
+    {
+        // Eşli dosyada satır kopyalanmadan doğrudan buffer'dan çizilir
+        size_t column = view.wrap ? row * columns : static_cast<size_t>(std::max(view.scroll_left, 0));
+        std::string_view line = document.lineView(static_cast<int>(i), column, columns, scratch);
+        buildLayout(layout, document, view, i, column, line, cursor, matches);
+
+        // Devam eden görsel satırda numara yok
+        int number_x = view.rect.left + NUMBER_LEFT;
+        size_t number_length = row == 0 ? layout.number_length : 0;
+        int number_end = number_x + static_cast<int>(number_length) * view.char_width;
+        int text_end = text_x + static_cast<int>(line.length()) * view.char_width;
+        int glyph_bottom = line_y + view.char_height;
+        renderer.fillRect(RenderRect{inner.left, line_y, number_x, glyph_bottom}, BACKGROUND);
+        renderer.fillRect(RenderRect{number_end, line_y, text_x, glyph_bottom}, BACKGROUND);
+        renderer.fillRect(RenderRect{std::max(text_end, text_x), line_y, inner.right, glyph_bottom}, BACKGROUND);
+        renderer.fillRect(RenderRect{inner.left, glyph_bottom, inner.right, line_y + line_height}, BACKGROUND);
+
+        renderer.drawText(number_x, line_y, layout.number, number_length, LINE_NUMBER, BACKGROUND);
+        for (const TextRun &run : layout.runs)
+        {
+            renderer.drawText(text_x + static_cast<int>(run.start) * view.char_width, line_y, line.data() + run.start,
+                              run.length, run.color, run.background);
+        }
+
+        if (view.show_cursor && static_cast<int>(i) == view.cursor_row && view.cursor_col >= static_cast<int>(column) &&
+            (!view.wrap || static_cast<size_t>(view.cursor_col) < column + columns))
+        {
+            int cursor_x = text_x + (view.cursor_col - static_cast<int>(column)) * view.char_width;
+            renderer.fillRect(RenderRect{cursor_x, line_y, cursor_x + 2, line_y + line_height}, CURSOR);
+        }
+
+        line_y += line_height;
+        drawn++;
+        if (!view.wrap || ++row >= view.wrap->rows(static_cast<int>(i)))
+        {
+            i++;
+            row = 0;
+        }
+    }
+    renderer.fillRect(RenderRect{inner.left, line_y, inner.right, inner.bottom}, BACKGROUND);
+    renderer.setClip(outer);
+    return drawn;
+}
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <vector>
+#include "MatchList.h"
+#include "Renderer.h"
+#include "TextDocument.h"
+#include "WrapLayout.h"
+
+// Bir panelin metin alanını çizmek için gereken görünüm durumu
+struct TextView
+{
+    RenderRect rect; // panelin alanı
+    int scroll_top;
+    int scroll_row;           // satır kaydırmada scroll_top satırının yukarıda kalan görsel satırları
+    int scroll_pixel;         // yumuşak kaydırma: ilk satırın yukarıda kalan kısmı (0 - satır yüksekliği)
+    int scroll_left;          // yatay kaydırma: soldan gizlenen sütun sayısı
+    int cursor_row;
+    int cursor_col;
+    bool show_cursor;         // aktif panel
+    bool partial_last_line;   // yükleme sürüyor: son satır henüz yarım, çizilmez
+    const MatchList *matches; // belgenin güncel haline ait vurgulanacak eşleşmeler, yoksa nullptr
+    int char_width;
+    int char_height;          // satır yüksekliği char_height + 2
+    const WrapLayout *wrap;   // satır kaydırma düzeni (belgeyle eşit); nullptr ise satırlar kaydırılmaz
+};
+
+// Satırın aynı renklerle çizilen parçası (karakter cinsinden)
+struct TextRun
+{
+    size_t start;
+    size_t length;
+    RenderColor color;
+    RenderColor background;
+};
+
+// Bir satırın çizim düzeni: sağa yaslı satır numarası ve metnin renk parçaları (parçalar görünür sütunlara göre).
+// Her çizimde görünür satırlar için yeniden kurulur; vektörler satırlar arasında yeniden kullanılır
+struct LineLayout
+{
+    char number[24];
+    size_t number_length;
+    std::vector<TextRun> runs;
+};
+
+// Satırların çizildiği alan: başlığın altından panelin altına tam sığan son satıra kadar.
+// Kaydırmada bu alanın pikselleri kaydırılır, dışı hep arka plandır
+RenderRect textViewport(const RenderRect &rect, int char_height);
+
+// Satır numaraları, metin, arama vurguları ve imleç. Sadece area ile kesişen satırlar ve panele sığan
+// sütunlar okunur ve çizilir (satırın uzunluğu maliyeti etkilemez); çizilen (görsel) satır sayısı döner.
+// Satır kaydırmada satırın devam eden görsel satırlarında numara yazılmaz. Editör (GDI) ve benchmark'lar (headless) aynı kodu kullanır.
+int drawTextView(Renderer &renderer, const TextDocument &document, const TextView &view, const RenderRect &area);
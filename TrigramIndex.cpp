@@ -0,0 +1,759 @@
+#include "TrigramIndex.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include "MappedFile.h"
+#include "UndoJournal.h"
+#include "WorkspaceWalk.h"
+
+namespace
+{
+    const char MAGIC[] = "GLTI\x01";
+    const size_t MAGIC_SIZE = 5;
+
+    // FindInFiles ile aynı ikili dosya tespiti
+    const size_t BINARY_PROBE = 8 * 1024;
+    // Bundan büyük dosyaların trigram'ları tutulmaz (her sorguda taranırlar)
+    const uint64_t MAX_INDEXED_SIZE = 256 * 1024 * 1024;
+    // Tarama dosyaları bu gruplar halinde paralel indeksler, sonra kilit altında ekler
+    const size_t REFRESH_BATCH = 1024;
+
+    const uint64_t FNV_OFFSET = 14695981039346656037ULL;
+    const uint64_t FNV_PRIME = 1099511628211ULL;
+
+    struct FoldTable
+    {
+        unsigned char map[256];
+        FoldTable()
+        {
+            for (int i = 0; i < 256; i++)
+                map[i] = static_cast<unsigned char>(i >= 'A' && i <= 'Z' ? i + 32 : i);
+        }
+    };
+    const FoldTable FOLD;
+
+    void putVarint(std::string &out, uint64_t value)
+    {
+        while (value >= 0x80)
+        {
+            out += static_cast<char>((value & 0x7F) | 0x80);
+            value >>= 7;
+        }
+        out += static_cast<char>(value);
+    }
+
+    bool getVarint(const char *&p, const char *end, uint64_t &value)
+    {
+        value = 0;
+        for (int shift = 0; p < end && shift < 64; shift += 7)
+        {
+            uint8_t byte = static_cast<uint8_t>(*p++);
+            value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+            if (!(byte & 0x80))
+                return true;
+        }
+        return false;
+    }
+
+    void putString(std::string &out, const std::string &text)
+    {
+        putVarint(out, text.size());
+        out += text;
+    }
+
+    bool getString(const char *&p, const char *end, std::string &text)
+    {
+        uint64_t length = 0;
+        if (!getVarint(p, end, length) || length > static_cast<uint64_t>(end - p))
+            return false;
+        text.assign(p, static_cast<size_t>(length));
+        p += length;
+        return true;
+    }
+
+    // Diskten okunan liste: kimlikler kesin artan, file_count'tan küçük; sayı ve son kimlik başlıkla aynı
+    bool validPosting(const std::string &deltas, uint64_t count, uint64_t last, uint64_t file_count)
+    {
+        const char *p = deltas.data();
+        const char *end = p + deltas.size();
+        uint64_t decoded = 0, value = 0, delta = 0;
+        while (p < end)
+        {
+            if (!getVarint(p, end, delta) || (decoded > 0 && delta == 0))
+                return false;
+            value = decoded > 0 ? value + delta : delta;
+            if (value >= file_count || value < delta)
+                return false;
+            decoded++;
+        }
+        return decoded > 0 && decoded == count && value == last;
+    }
+
+    uint32_t trigramAt(const std::string &text, size_t i)
+    {
+        return (static_cast<uint32_t>(FOLD.map[static_cast<unsigned char>(text[i])]) << 16) |
+               (static_cast<uint32_t>(FOLD.map[static_cast<unsigned char>(text[i + 1])]) << 8) |
+               FOLD.map[static_cast<unsigned char>(text[i + 2])];
+    }
+
+    // '(' ya da '[' ile başlayan grubun/sınıfın bittiği yerin sonrası
+    size_t skipBalanced(const std::string &text, size_t i)
+    {
+        size_t n = text.size();
+        if (text[i] == '[')
+        {
+            size_t j = i + 1;
+            if (j < n && text[j] == '^')
+                j++;
+            if (j < n && text[j] == ']')
+                j++;
+            for (; j < n && text[j] != ']'; j++)
+            {
+                if (text[j] == '\\')
+                    j++;
+            }
+            return std::min(j + 1, n);
+        }
+
+        int depth = 0;
+        for (size_t j = i; j < n; j++)
+        {
+            if (text[j] == '\\')
+                j++;
+            else if (text[j] == '[')
+                j = skipBalanced(text, j) - 1;
+            else if (text[j] == '(')
+                depth++;
+            else if (text[j] == ')' && --depth == 0)
+                return j + 1;
+        }
+        return n;
+    }
+}
+
+TrigramIndex::TrigramIndex(const std::string &root)
+    : dead_count(0), is_ready(false), refresh_running(false), cancelled(false)
+{
+    root_path = normalize(root);
+}
+
+TrigramIndex::~TrigramIndex()
+{
+    cancelled = true;
+    if (refresher.joinable())
+        refresher.join();
+}
+
+std::string TrigramIndex::normalize(const std::string &path)
+{
+    return workspaceRoot(path);
+}
+
+std::string TrigramIndex::indexPath(const std::string &root)
+{
+    uint64_t hash = FNV_OFFSET;
+    for (char ch : root)
+        hash = (hash ^ static_cast<uint8_t>(ch)) * FNV_PRIME;
+
+    char suffix[32];
+    snprintf(suffix, sizeof(suffix), "-%016llx.trigram", static_cast<unsigned long long>(hash));
+    std::string name = std::filesystem::path(root).filename().string();
+    return (std::filesystem::path(UndoJournal::sessionDirectory()) / (name + suffix)).string();
+}
+
+size_t TrigramIndex::fileCount()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return live_ids.size();
+}
+
+size_t TrigramIndex::postingBytes()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    size_t total = 0;
+    for (const auto &entry : postings)
+        total += entry.second.deltas.size();
+    return total;
+}
+
+bool TrigramIndex::extract(FileEntry &entry, std::vector<uint32_t> &trigrams)
+{
+    trigrams.clear();
+    entry.flags = 0;
+    std::shared_ptr<MappedFile> file = MappedFile::open(entry.path);
+    if (!file)
+        return false;
+
+    const unsigned char *data = reinterpret_cast<const unsigned char *>(file->data());
+    size_t size = file->size();
+    if (size > 0 && memchr(data, 0, std::min(size, BINARY_PROBE)))
+    {
+        entry.flags = FILE_BINARY;
+        return true;
+    }
+    if (size > MAX_INDEXED_SIZE)
+    {
+        entry.flags = FILE_UNINDEXED;
+        return true;
+    }
+
+    // Tekrarlar thread başına 2 MB'lık bit kümesiyle elenir, sonra sadece yazılan kelimeler temizlenir
+    thread_local std::vector<uint64_t> seen(1 << 18, 0);
+    uint32_t key = 0;
+    for (size_t i = 0; i < size; i++)
+    {
+        key = ((key << 8) | FOLD.map[data[i]]) & 0xFFFFFF;
+        if (i < 2)
+            continue;
+        uint64_t &word = seen[key >> 6];
+        uint64_t bit = 1ULL << (key & 63);
+        if (!(word & bit))
+        {
+            word |= bit;
+            trigrams.push_back(key);
+        }
+    }
+    for (uint32_t trigram : trigrams)
+        seen[trigram >> 6] = 0;
+    std::sort(trigrams.begin(), trigrams.end());
+    return true;
+}
+
+void TrigramIndex::addFile(const FileEntry &entry, const std::vector<uint32_t> &trigrams)
+{
+    uint32_t id = static_cast<uint32_t>(files.size());
+    files.push_back(entry);
+    live_ids[entry.path] = id;
+    if (entry.flags & FILE_UNINDEXED)
+        unindexed.push_back(id);
+
+    // Yeni kimlik her listedeki son kimlikten büyüktür: ekleme sona yazmaktır
+    for (uint32_t trigram : trigrams)
+    {
+        Posting &posting = postings[trigram];
+        putVarint(posting.deltas, posting.count ? id - posting.last : id);
+        posting.last = id;
+        posting.count++;
+    }
+}
+
+void TrigramIndex::removeFile(const std::string &path)
+{
+    auto found = live_ids.find(path);
+    if (found == live_ids.end())
+        return;
+    files[found->second].flags |= FILE_DEAD;
+    live_ids.erase(found);
+    dead_count++;
+}
+
+std::vector<uint32_t> TrigramIndex::decode(const Posting &posting) const
+{
+    std::vector<uint32_t> ids;
+    ids.reserve(posting.count);
+    const char *p = posting.deltas.data();
+    const char *end = p + posting.deltas.size();
+    uint64_t value = 0, delta = 0;
+    while (p < end && getVarint(p, end, delta))
+    {
+        value = ids.empty() ? delta : value + delta;
+        ids.push_back(static_cast<uint32_t>(value));
+    }
+    return ids;
+}
+
+void TrigramIndex::compact()
+{
+    if (dead_count == 0)
+        return;
+
+    // Ölü kimlikler atılır, kalanlar sırası korunarak yeniden numaralanır
+    const uint32_t NONE = static_cast<uint32_t>(-1);
+    std::vector<uint32_t> remap(files.size(), NONE);
+    std::vector<FileEntry> live;
+    live.reserve(live_ids.size());
+    for (size_t id = 0; id < files.size(); id++)
+    {
+        if (files[id].flags & FILE_DEAD)
+            continue;
+        remap[id] = static_cast<uint32_t>(live.size());
+        live.push_back(std::move(files[id]));
+    }
+
+    for (auto it = postings.begin(); it != postings.end();)
+    {
+        Posting rebuilt = Posting();
+        for (uint32_t id : decode(it->second))
+        {
+            if (remap[id] == NONE)
+                continue;
+            putVarint(rebuilt.deltas, rebuilt.count ? remap[id] - rebuilt.last : remap[id]);
+            rebuilt.last = remap[id];
+            rebuilt.count++;
+        }
+        if (rebuilt.count == 0)
+        {
+            it = postings.erase(it);
+        }
+        else
+        {
+            it->second = std::move(rebuilt);
+            ++it;
+        }
+    }
+
+    std::vector<uint32_t> kept;
+    for (uint32_t id : unindexed)
+    {
+        if (remap[id] != NONE)
+            kept.push_back(remap[id]);
+    }
+    unindexed.swap(kept);
+
+    files.swap(live);
+    live_ids.clear();
+    for (size_t id = 0; id < files.size(); id++)
+        live_ids[files[id].path] = static_cast<uint32_t>(id);
+    dead_count = 0;
+}
+
+bool TrigramIndex::save()
+{
+    std::string out(MAGIC, MAGIC_SIZE);
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        compact();
+        putString(out, root_path);
+        putVarint(out, files.size());
+        for (const FileEntry &entry : files)
+        {
+            putString(out, entry.path);
+            putVarint(out, entry.size);
+            putVarint(out, static_cast<uint64_t>(entry.mtime));
+            putVarint(out, entry.flags);
+        }
+        putVarint(out, postings.size());
+        for (const auto &entry : postings)
+        {
+            putVarint(out, entry.first);
+            putVarint(out, entry.second.count);
+            putVarint(out, entry.second.last);
+            putString(out, entry.second.deltas);
+        }
+    }
+
+    // Yarım yazılmış indeks okunmasın: geçici dosyaya yaz, sonra yerine koy
+    std::string target = indexPath(root_path);
+    std::string tmp = target + ".tmp";
+    FILE *file = fopen(tmp.c_str(), "wb");
+    if (!file)
+        return false;
+    bool ok = fwrite(out.data(), 1, out.size(), file) == out.size();
+    ok = fclose(file) == 0 && ok;
+    if (!ok || !MappedFile::replaceFile(tmp, target))
+    {
+        std::remove(tmp.c_str());
+        return false;
+    }
+    return true;
+}
+
+bool TrigramIndex::load()
+{
+    std::shared_ptr<MappedFile> file = MappedFile::open(indexPath(root_path));
+    if (!file || file->size() < MAGIC_SIZE || memcmp(file->data(), MAGIC, MAGIC_SIZE) != 0)
+        return false;
+
+    const char *p = file->data() + MAGIC_SIZE;
+    const char *end = file->data() + file->size();
+    std::string root;
+    uint64_t file_count = 0;
+    if (!getString(p, end, root) || root != root_path || !getVarint(p, end, file_count))
+        return false;
+
+    std::vector<FileEntry> loaded_files;
+    for (uint64_t i = 0; i < file_count; i++)
+    {
+        FileEntry entry;
+        uint64_t size = 0, mtime = 0, flags = 0;
+        if (!getString(p, end, entry.path) || !getVarint(p, end, size) || !getVarint(p, end, mtime) ||
+            !getVarint(p, end, flags))
+            return false;
+        entry.size = size;
+        entry.mtime = static_cast<int64_t>(mtime);
+        entry.flags = static_cast<uint8_t>(flags);
+        loaded_files.push_back(std::move(entry));
+    }
+
+    uint64_t posting_count = 0;
+    if (!getVarint(p, end, posting_count))
+        return false;
+    std::unordered_map<uint32_t, Posting> loaded_postings;
+    loaded_postings.reserve(static_cast<size_t>(posting_count));
+    for (uint64_t i = 0; i < posting_count; i++)
+    {
+        uint64_t key = 0, count = 0, last = 0;
+        Posting posting;
+        if (!getVarint(p, end, key) || !getVarint(p, end, count) || !getVarint(p, end, last) ||
+            !getString(p, end, posting.deltas) || !validPosting(posting.deltas, count, last, file_count))
+            return false;
+        posting.count = static_cast<uint32_t>(count);
+        posting.last = static_cast<uint32_t>(last);
+        loaded_postings[static_cast<uint32_t>(key)] = std::move(posting);
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+    files.swap(loaded_files);
+    postings.swap(loaded_postings);
+    live_ids.clear();
+    unindexed.clear();
+    dead_count = 0;
+    for (size_t id = 0; id < files.size(); id++)
+    {
+        live_ids[files[id].path] = static_cast<uint32_t>(id);
+        if (files[id].flags & FILE_UNINDEXED)
+            unindexed.push_back(static_cast<uint32_t>(id));
+    }
+    is_ready = true;
+    return true;
+}
+
+void TrigramIndex::startRefresh(std::function<void()> on_done)
+{
+    if (refresh_running)
+        return;
+    if (refresher.joinable())
+        refresher.join();
+    cancelled = false;
+    refresh_running = true;
+    refresher = std::thread(&TrigramIndex::refresh, this, true, std::move(on_done));
+}
+
+bool TrigramIndex::stamp(const std::filesystem::directory_entry &entry, uint64_t &size, int64_t &mtime)
+{
+    std::error_code error;
+    size = entry.file_size(error);
+    if (error)
+        return false;
+    mtime = static_cast<int64_t>(entry.last_write_time(error).time_since_epoch().count());
+    return !error;
+}
+
+void TrigramIndex::refresh(bool walk, std::function<void()> on_done)
+{
+    // Boyutu ya da zaman damgası değişenler yeniden indekslenir, ağaçta olmayanlar silinir
+    std::vector<FileEntry> changed;
+    if (walk)
+    {
+        std::vector<FileEntry> found;
+        walkWorkspace(root_path, cancelled, [&found](const std::filesystem::directory_entry &entry)
+                      {
+                          FileEntry file{entry.path().string(), 0, 0, 0};
+                          if (stamp(entry, file.size, file.mtime))
+                              found.push_back(std::move(file)); });
+
+        if (!cancelled)
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            std::vector<bool> seen(files.size(), false);
+            for (FileEntry &entry : found)
+            {
+                auto known = live_ids.find(entry.path);
+                if (known != live_ids.end())
+                {
+                    seen[known->second] = true;
+                    const FileEntry &indexed = files[known->second];
+                    if (indexed.size == entry.size && indexed.mtime == entry.mtime)
+                        continue;
+                }
+                changed.push_back(std::move(entry));
+            }
+            for (auto it = live_ids.begin(); it != live_ids.end();)
+            {
+                if (it->second < seen.size() && !seen[it->second])
+                {
+                    files[it->second].flags |= FILE_DEAD;
+                    dead_count++;
+                    it = live_ids.erase(it);
+                }
+                else
+                {
+                    ++it;
+                }
+            }
+        }
+    }
+
+    // Kaydedilen dosyalar taramanın gruplarından sonra indekslenir: taramanın kaydetmeden önce çıkardığı
+    // trigram'lar yenilerinin üstüne yazılamaz. Sıra boşalınca thread aynı kilit altında durur.
+    while (!cancelled)
+    {
+        reindex(changed);
+        changed.clear();
+
+        std::vector<std::string> paths;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (queued.empty() || cancelled)
+                break;
+            paths.swap(queued);
+        }
+        for (const std::string &path : paths)
+        {
+            // Zaman damgası içerikten önce okunur; arada değişen dosya bir sonraki aramada yine taranır
+            FileEntry entry{path, 0, 0, 0};
+            std::error_code error;
+            if (!stamp(std::filesystem::directory_entry(path, error), entry.size, entry.mtime) || error)
+                entry.flags = FILE_DEAD; // silinmiş: sadece çıkarılır
+            changed.push_back(std::move(entry));
+        }
+    }
+
+    if (walk && !cancelled)
+    {
+        is_ready = true;
+        save();
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        queued.clear();
+        refresh_running = false;
+    }
+    if (walk && on_done && !cancelled)
+        on_done();
+}
+
+void TrigramIndex::reindex(std::vector<FileEntry> &changed)
+{
+    unsigned threads = std::max(1u, std::thread::hardware_concurrency());
+    for (size_t begin = 0; begin < changed.size() && !cancelled; begin += REFRESH_BATCH)
+    {
+        size_t end = std::min(changed.size(), begin + REFRESH_BATCH);
+        std::vector<std::vector<uint32_t>> trigrams(end - begin);
+        std::vector<char> ok(end - begin, 0);
+        std::atomic<size_t> next(begin);
+        auto work = [&]()
+        {
+            for (size_t k = next++; k < end && !cancelled; k = next++)
+                ok[k - begin] = !(changed[k].flags & FILE_DEAD) && extract(changed[k], trigrams[k - begin]);
+        };
+        std::vector<std::thread> pool;
+        for (unsigned t = 1; t < threads && t < end - begin; t++)
+            pool.push_back(std::thread(work));
+        work();
+        for (std::thread &worker : pool)
+            worker.join();
+
+        std::lock_guard<std::mutex> lock(mutex);
+        for (size_t k = begin; k < end; k++)
+        {
+            removeFile(changed[k].path);
+            if (ok[k - begin])
+                addFile(changed[k], trigrams[k - begin]);
+        }
+    }
+}
+
+void TrigramIndex::updateFile(const std::string &path)
+{
+    // Kök önekini paylaşan kardeş dizinler (/ws/proj ve /ws/project) kök içinde sayılmaz
+    std::string normal = normalize(path);
+    bool separated = !root_path.empty() && (root_path.back() == '/' || root_path.back() == '\\');
+    if (normal.size() <= root_path.size() || normal.compare(0, root_path.size(), root_path) != 0 ||
+        (!separated && normal[root_path.size()] != '/' && normal[root_path.size()] != '\\'))
+        return;
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        queued.push_back(normal);
+        if (refresh_running)
+            return; // süren tarama bitmeden sırayı işler
+        refresh_running = true;
+    }
+    if (refresher.joinable())
+        refresher.join();
+    cancelled = false;
+    refresher = std::thread(&TrigramIndex::refresh, this, false, nullptr);
+}
+
+std::vector<std::string> TrigramIndex::requiredLiterals(const std::string &text, bool use_regex)
+{
+    std::vector<std::string> literals;
+    if (!use_regex)
+    {
+        literals.push_back(text);
+        return literals;
+    }
+
+    std::string run;
+    size_t i = 0, n = text.size();
+    auto flush = [&]()
+    {
+        if (run.size() >= 3)
+            literals.push_back(run);
+        run.clear();
+    };
+    // i'deki niceleyiciyi atlar; önceki atom en az bir kez geçmeli mi (required) bildirir
+    auto quantifier = [&](bool &required)
+    {
+        if (i >= n)
+            return false;
+        char ch = text[i];
+        if (ch == '*' || ch == '?' || ch == '+')
+        {
+            required = ch == '+';
+            i++;
+        }
+        else if (ch == '{')
+        {
+            size_t j = i + 1;
+            size_t minimum = 0;
+            while (j < n && isdigit(static_cast<unsigned char>(text[j])))
+                minimum = minimum * 10 + (text[j++] - '0');
+            size_t close = text.find('}', j);
+            if (j == i + 1 || close == std::string::npos)
+                return false; // niceleyici değil
+            required = minimum > 0;
+            i = close + 1;
+        }
+        else
+        {
+            return false;
+        }
+        if (i < n && text[i] == '?')
+            i++; // tembel
+        return true;
+    };
+
+    while (i < n)
+    {
+        char ch = text[i];
+        bool required = true;
+        if (ch == '|')
+            return std::vector<std::string>(); // alternation: hiçbir parça zorunlu değil
+        if (ch == '(' || ch == '[')
+        {
+            // Grup ve sınıf içeriği literal sayılmaz
+            flush();
+            i = skipBalanced(text, i);
+            quantifier(required);
+            continue;
+        }
+        if (ch == '.' || ch == '^' || ch == '$' || ch == '*' || ch == '+' || ch == '?' || ch == '{')
+        {
+            flush();
+            i++;
+            quantifier(required);
+            continue;
+        }
+        if (ch == '\\')
+        {
+            if (i + 1 >= n)
+                break;
+            ch = text[i + 1];
+            i += 2;
+            if (ch == 'x' && i + 2 <= n && isxdigit(static_cast<unsigned char>(text[i])) &&
+                isxdigit(static_cast<unsigned char>(text[i + 1])))
+            {
+                // \xHH tek bir literal byte
+                ch = static_cast<char>(std::stoi(text.substr(i, 2), nullptr, 16));
+                i += 2;
+            }
+            else if (isalnum(static_cast<unsigned char>(ch)))
+            {
+                // \d \w \b gibi sınıf ve bağlam kaçışları
+                flush();
+                quantifier(required);
+                continue;
+            }
+        }
+        else
+        {
+            i++;
+        }
+
+        // Niceleyicili literal: zorunluysa çalıştırmayı bitirir (a+ sonrası bitişik değildir)
+        if (quantifier(required))
+        {
+            if (required)
+                run += ch;
+            flush();
+        }
+        else
+        {
+            run += ch;
+        }
+    }
+    flush();
+    return literals;
+}
+
+bool TrigramIndex::Exclusions::skip(const std::filesystem::directory_entry &entry) const
+{
+    auto found = files.find(entry.path().string());
+    if (found == files.end())
+        return false;
+    uint64_t size = 0;
+    int64_t mtime = 0;
+    return stamp(entry, size, mtime) && size == found->second.first && mtime == found->second.second;
+}
+
+bool TrigramIndex::exclusions(const std::string &text, bool use_regex, Exclusions &out)
+{
+    std::vector<uint32_t> keys;
+    for (const std::string &literal : requiredLiterals(text, use_regex))
+    {
+        for (size_t i = 0; i + 3 <= literal.size(); i++)
+            keys.push_back(trigramAt(literal, i));
+    }
+    std::sort(keys.begin(), keys.end());
+    keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+    if (keys.empty())
+        return false;
+
+    std::lock_guard<std::mutex> lock(mutex);
+
+    // En kısa listeden başlayarak kesiştir; listesi olmayan trigram varsa indeksli aday yoktur
+    std::vector<const Posting *> lists;
+    for (uint32_t key : keys)
+    {
+        auto found = postings.find(key);
+        if (found == postings.end())
+        {
+            lists.clear();
+            break;
+        }
+        lists.push_back(&found->second);
+    }
+    std::sort(lists.begin(), lists.end(), [](const Posting *a, const Posting *b)
+              { return a->count < b->count; });
+
+    std::vector<uint32_t> result, next, merged;
+    if (!lists.empty())
+        result = decode(*lists[0]);
+    for (size_t i = 1; i < lists.size() && !result.empty(); i++)
+    {
+        next = decode(*lists[i]);
+        merged.clear();
+        std::set_intersection(result.begin(), result.end(), next.begin(), next.end(), std::back_inserter(merged));
+        result.swap(merged);
+    }
+
+    // Aday olmayan canlı dosyalar dışlanır; çok büyük (trigram'sız) dosyalar her zaman adaydır
+    out.files.clear();
+    out.files.reserve(live_ids.size() - std::min(live_ids.size(), result.size()));
+    size_t r = 0;
+    for (uint32_t id = 0; id < files.size(); id++)
+    {
+        while (r < result.size() && result[r] < id)
+            r++;
+        const FileEntry &entry = files[id];
+        if ((entry.flags & (FILE_DEAD | FILE_UNINDEXED)) || (r < result.size() && result[r] == id))
+            continue;
+        out.files.emplace(entry.path, std::make_pair(entry.size, entry.mtime));
+    }
+    return true;
+}
@@ -0,0 +1,121 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+// Çalışma alanının kalıcı trigram indeksi (dosyalarda aramayı aday dosyalara daraltır)
+// - Her dosyanın içerdiği 3 byte'lık diziler (ASCII küçük harfe katlanmış) posting listelerine yazılır
+// - Posting listeleri artan dosya kimliklerinin delta + varint kodlamasıdır; yeni dosya hep en büyük
+//   kimliği alır, böylece ekleme listenin sonuna yazmaktır. Değişen dosya eski kimliği ölü sayılıp
+//   yeni kimlikle eklenir, ölüler sıkıştırmada (kaydetmede) temizlenir
+// - Diskte oturum dizininde kök yolunun hash'i ile saklanır; açılışta yüklenir, arka plan taraması
+//   boyut/zaman damgası değişen dosyaları yeniden indeksler, silinenleri çıkarır
+// - Sorgunun zorunlu literal parçalarının trigram'ları kesiştirilir; aday kümesi her zaman gerçek
+//   eşleşmelerin üst kümesidir (ikili dosyalar hiç aday olmaz, çok büyük dosyalar hep adaydır)
+// - İndeks aramada sadece eleme için kullanılır: ağaç yine gezilir, indekslendiği boyut ve zaman damgasıyla
+//   duran aday dışı dosyalar atlanır. Yeni ya da dışarıda değişmiş dosyalar, tarama beklenmeden aranır
+class TrigramIndex
+{
+public:
+    explicit TrigramIndex(const std::string &root);
+    ~TrigramIndex();
+    TrigramIndex(const TrigramIndex &) = delete;
+    TrigramIndex &operator=(const TrigramIndex &) = delete;
+
+    const std::string &root() const { return root_path; }
+    static std::string indexPath(const std::string &root);
+
+    // Diskteki indeksi yükler / yazar (yoksa ya da bozuksa load false döner)
+    bool load();
+    bool save();
+
+    // Ağacı arka planda tarar: yeni ve değişen dosyalar indekslenir, silinenler çıkarılır, sonra kaydedilir.
+    // on_done bitince worker thread'inden çağrılır.
+    void startRefresh(std::function<void()> on_done);
+    bool refreshing() const { return refresh_running; }
+    // Yüklendi ya da en az bir tarama bitti: eleme için kullanılabilir
+    bool ready() const { return is_ready; }
+
+    // Kaydedilen tek dosyayı arka plan thread'inde yeniden indekslemek için sıraya koyar (kök dışındaysa
+    // yok sayılır). Süren tarama sırayı kendi gruplarından sonra işler, eski içerik yenisinin üstüne yazılmaz.
+    void updateFile(const std::string &path);
+
+    // Bir sorguda ağaç gezilirken atlanabilecek dosyalar: sorgunun trigram'larını içermeyen ve diskte
+    // indekslendiği boyut ve zaman damgasıyla duran dosyalar. İndekste olmayan ya da değişmiş dosya atlanmaz.
+    class Exclusions
+    {
+    public:
+        bool skip(const std::filesystem::directory_entry &entry) const;
+        size_t size() const { return files.size(); }
+
+    private:
+        friend class TrigramIndex;
+        std::unordered_map<std::string, std::pair<uint64_t, int64_t>> files; // yol -> boyut, zaman damgası
+    };
+
+    // Sorgu 3 byte'lık zorunlu literal içermiyorsa false (eleme yapılamaz, tam tarama gerekir)
+    bool exclusions(const std::string &text, bool use_regex, Exclusions &out);
+
+    size_t fileCount();
+    size_t postingBytes();
+
+    // Her eşleşmede mutlaka geçen literal parçalar (düzenli ifadede: alternation yoksa, grup/sınıf dışı)
+    static std::vector<std::string> requiredLiterals(const std::string &text, bool use_regex);
+    // Mutlak, sonda ayırıcı olmayan yol (indeks yolları bu biçimdedir)
+    static std::string normalize(const std::string &path);
+
+private:
+    enum FileFlags
+    {
+        FILE_DEAD = 1,     // yerine yeni kimlik geldi ya da silindi
+        FILE_BINARY = 2,   // hiç aday olmaz
+        FILE_UNINDEXED = 4 // çok büyük, trigram'ları tutulmaz, her sorguda adaydır
+    };
+
+    struct FileEntry
+    {
+        std::string path;
+        uint64_t size;
+        int64_t mtime;
+        uint8_t flags;
+    };
+
+    struct Posting
+    {
+        std::string deltas; // artan kimliklerin farkları (ilk değer kimliğin kendisi)
+        uint32_t last;
+        uint32_t count;
+    };
+
+    std::string root_path;
+
+    std::mutex mutex; // aşağıdakileri korur
+    std::vector<FileEntry> files; // kimlik = indeks
+    std::unordered_map<std::string, uint32_t> live_ids;
+    std::unordered_map<uint32_t, Posting> postings;
+    std::vector<uint32_t> unindexed;
+    size_t dead_count;
+    std::vector<std::string> queued; // updateFile ile sıraya konup henüz indekslenmemiş yollar
+
+    std::atomic<bool> is_ready;
+    std::atomic<bool> refresh_running;
+    std::atomic<bool> cancelled;
+    std::thread refresher;
+
+    void refresh(bool walk, std::function<void()> on_done);
+    void reindex(std::vector<FileEntry> &changed);
+    static bool stamp(const std::filesystem::directory_entry &entry, uint64_t &size, int64_t &mtime);
+    static bool extract(FileEntry &entry, std::vector<uint32_t> &trigrams);
+    void addFile(const FileEntry &entry, const std::vector<uint32_t> &trigrams);
+    void removeFile(const std::string &path);
+    void compact();
+    std::vector<uint32_t> decode(const Posting &posting) const;
+};
@@ -0,0 +1,554 @@
+#include "UndoHistory.h"
+#include "UndoJournal.h"
+
+#include <algorithm>
+
+namespace
+{
+    // Her yolda bu kadar derinlikte bir belge kopyası tutulur
+    const size_t CHECKPOINT_INTERVAL = 64;
+    // Yazma/silme birleştirmesi bu kadar beklemeden sonra ya da bu boyutta kesilir
+    const std::chrono::milliseconds MERGE_IDLE(1000);
+    const size_t MERGE_LIMIT = 256;
+
+    bool isBlank(char c)
+    {
+        return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+    }
+
+    // Düzenleme sırasında boşluktan kelimeye geçiş: yeni kelime ayrı kayıt olur,
+    // boşluk önceki kelimeyle birlikte geri alınır
+    bool wordStart(char last, char first)
+    {
+        return isBlank(last) && !isBlank(first);
+    }
+}
+
+unsigned long long UndoHistory::use_clock = 0;
+
+UndoHistory::UndoHistory() : current(0), bytes(0), last_used(0), next_serial(0), pending(false),
+                             pending_mergeable(false), group_depth(0), recording(false),
+                             applied_known(true), diverged(false)
+{
+    resetNodes();
+}
+
+void UndoHistory::resetNodes()
+{
+    Node root;
+    root.parent = 0;
+    root.redo_child = NONE;
+    root.depth = 0;
+    root.serial = 0;
+    root.time = std::time(nullptr);
+    root.record.cursor_row = 0;
+    root.record.cursor_col = 0;
+
+    nodes.clear();
+    nodes.push_back(std::move(root));
+    current = 0;
+    next_serial = 1;
+    bytes = nodeBytes(nodes[0]);
+}
+
+size_t UndoHistory::editBytes(const Edit &edit)
+{
+    return sizeof(Edit) + edit.removed.capacity() + edit.inserted.capacity();
+}
+
+size_t UndoHistory::checkpointBytes(const TextDocument &document)
+{
+    // Kopya canlı belgeyle rope node'larını paylaşır; kendine ait kısım en kötü ihtimalle
+    // kökten yaprağa ayrışmış bir yoldur
+    return sizeof(TextDocument) + static_cast<size_t>(document.treeDepth()) * 32 * sizeof(TextPiece);
+}
+
+size_t UndoHistory::nodeBytes(const Node &node)
+{
+    size_t total = sizeof(Node) + node.record.operation.capacity();
+    for (const Edit &edit : node.record.edits)
+        total += editBytes(edit);
+    if (node.checkpoint)
+        total += checkpointBytes(*node.checkpoint);
+    return total;
+}
+
+void UndoHistory::begin(const std::string &operation, int cursor_row, int cursor_col, bool mergeable)
+{
+    if (group_depth > 0)
+        return;
+
+    pending = true;
+    pending_mergeable = mergeable;
+    pending_record.operation = operation;
+    pending_record.cursor_row = cursor_row;
+    pending_record.cursor_col = cursor_col;
+    pending_record.edits.clear();
+}
+
+void UndoHistory::beginGroup(const std::string &operation, int cursor_row, int cursor_col)
+{
+    if (group_depth == 0)
+        begin(operation, cursor_row, cursor_col);
+    group_depth++;
+}
+
+void UndoHistory::endGroup()
+{
+    if (group_depth > 0)
+        group_depth--;
+}
+
+void UndoHistory::closeRecord()
+{
+    pending = false;
+    recording = false;
+    group_depth = 0;
+}
+
+void UndoHistory::logMove()
+{
+    if (journal)
+        journal->logMove(nodes[current].serial);
+}
+
+void UndoHistory::stampCurrent()
+{
+    // Mevcut duruma eklenen düzenleme durumun zamanını ileri taşır; günlüğe saniyede en fazla bir kez yazılır
+    std::time_t now = std::time(nullptr);
+    if (nodes[current].time == now)
+        return;
+    nodes[current].time = now;
+    if (journal)
+        journal->logTime(nodes[current].serial, now);
+}
+
+bool UndoHistory::mergeEdit(Edit &previous, const Edit &next)
+{
+    bool previous_insert = previous.removed.empty();
+    bool next_insert = next.removed.empty();
+
+    // Yazma: yeni metin öncekinin hemen sonuna eklendi
+    if (previous_insert && next_insert)
+    {
+        if (next.offset != previous.offset + previous.inserted.size() ||
+            previous.inserted.size() + next.inserted.size() > MERGE_LIMIT ||
+            wordStart(previous.inserted.back(), next.inserted.front()))
+            return false;
+        previous.inserted += next.inserted;
+        return true;
+    }
+
+    if (!previous.inserted.empty() || !next.inserted.empty() ||
+        previous.removed.size() + next.removed.size() > MERGE_LIMIT)
+        return false;
+
+    // Backspace: silinen aralık öncekinin hemen önünde; yazmanın tersi olarak
+    // kelime sonundaki boşluk kelimeyle birlikte silinir
+    if (next.offset + next.removed.size() == previous.offset)
+    {
+        if (wordStart(next.removed.back(), previous.removed.front()))
+            return false;
+        previous.removed.insert(0, next.removed);
+        previous.offset = next.offset;
+        return true;
+    }
+    // Delete: aynı offset'ten silmeye devam
+    if (next.offset == previous.offset)
+    {
+        if (wordStart(previous.removed.back(), next.removed.front()))
+            return false;
+        previous.removed += next.removed;
+        return true;
+    }
+    return false;
+}
+
+void UndoHistory::addEdit(const TextDocument &document, Edit edit)
+{
+    // Aynı türden bitişik düzenleme mevcut duruma katılır; uzun bir duraklama birleştirmeyi keser
+    std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+    bool idle = now - last_edit > MERGE_IDLE;
+    last_edit = now;
+    if (pending && pending_mergeable && recording && current != 0 && !idle)
+    {
+        Record &last = nodes[current].record;
+        if (last.operation == pending_record.operation && !last.edits.empty())
+        {
+            size_t before = editBytes(last.edits.back());
+            if (mergeEdit(last.edits.back(), edit))
+            {
+                bytes = bytes - before + editBytes(last.edits.back());
+                pending = false;
+                touch();
+                // Günlükte ayrı düzenleme olarak durur; sırayla oynatmak birleşik halle aynıdır
+                if (journal)
+                    journal->logEdit(nodes[current].serial, edit);
+                stampCurrent();
+                return;
+            }
+        }
+    }
+
+    Record &record = currentRecord(document);
+    if (journal)
+        journal->logEdit(nodes[current].serial, edit);
+    bytes += editBytes(edit);
+    record.edits.push_back(std::move(edit));
+    stampCurrent();
+    touch();
+}
+
+UndoHistory::Record &UndoHistory::currentRecord(const TextDocument &document)
+{
+    if (pending || !recording)
+    {
+        // Yeni durum mevcut durumun çocuğu olur; diğer dallar (redo geçmişi) korunur
+        Node &parent = nodes[current];
+        if (!parent.checkpoint && parent.depth % CHECKPOINT_INTERVAL == 0)
+        {
+            // Belge henüz parent durumunda - O(1) kopya
+            parent.checkpoint = std::make_shared<const TextDocument>(document);
+            bytes += checkpointBytes(*parent.checkpoint);
+        }
+
+        Node node;
+        node.parent = current;
+        node.redo_child = NONE;
+        node.depth = parent.depth + 1;
+        node.serial = next_serial++;
+        node.time = std::time(nullptr);
+        node.record = std::move(pending_record);
+        pending_record = Record();
+
+        parent.redo_child = nodes.size();
+        current = nodes.size();
+        nodes.push_back(std::move(node));
+        bytes += nodeBytes(nodes.back());
+
+        if (journal)
+            journal->logNode(nodes.back().serial, nodes[nodes.back().parent].serial, nodes.back().time, nodes.back().record);
+
+        pending = false;
+        recording = true;
+    }
+    return nodes[current].record;
+}
+
+void UndoHistory::insert(TextDocument &document, size_t offset, const std::string &text)
+{
+    if (text.empty())
+        return;
+
+    offset = std::min(offset, document.length());
+    addEdit(document, {offset, std::string(), text});
+    document.insert(offset, text);
+}
+
+void UndoHistory::erase(TextDocument &document, size_t offset, size_t count)
+{
+    if (offset >= document.length() || count == 0)
+        return;
+
+    count = std::min(count, document.length() - offset);
+    addEdit(document, {offset, document.getText(offset, count), std::string()});
+    document.erase(offset, count);
+}
+
+bool UndoHistory::matches(const TextDocument &document, size_t offset, const std::string &text)
+{
+    if (offset > document.length() || document.length() - offset < text.size())
+        return false;
+    size_t pos = 0;
+    bool equal = true;
+    document.forEachChunkUntil(offset, text.size(), [&](const char *data, size_t size)
+                               {
+        equal = text.compare(pos, size, data, size) == 0;
+        pos += size;
+        return equal; });
+    return equal;
+}
+
+bool UndoHistory::applyBackward(TextDocument &document, size_t state, int &cursor_row, int &cursor_col)
+{
+    // Düzenlemeleri ters sırada geri al
+    const Record &record = nodes[state].record;
+    for (size_t i = record.edits.size(); i-- > 0;)
+    {
+        const Edit &edit = record.edits[i];
+        if (!matches(document, edit.offset, edit.inserted))
+        {
+            // Belge kayıttan farklı (dosya dışarıda değişmiş): bu kaydın geri alınanları yeniden uygulanır
+            for (size_t j = i + 1; j < record.edits.size(); j++)
+            {
+                document.erase(record.edits[j].offset, record.edits[j].removed.size());
+                document.insert(record.edits[j].offset, record.edits[j].inserted);
+            }
+            return false;
+        }
+        document.erase(edit.offset, edit.inserted.size());
+        document.insert(edit.offset, edit.removed);
+        if (!edit.inserted.empty() || !edit.removed.empty())
+            applied.push_back({edit.offset, edit.inserted.size(), edit.removed.size()});
+    }
+
+    cursor_row = record.cursor_row;
+    cursor_col = record.cursor_col;
+    nodes[nodes[state].parent].redo_child = state;
+    current = nodes[state].parent;
+    return true;
+}
+
+bool UndoHistory::applyForward(TextDocument &document, size_t state, int &cursor_row, int &cursor_col)
+{
+    const Record &record = nodes[state].record;
+    for (size_t i = 0; i < record.edits.size(); i++)
+    {
+        const Edit &edit = record.edits[i];
+        if (!matches(document, edit.offset, edit.removed))
+        {
+            for (size_t j = i; j-- > 0;)
+            {
+                document.erase(record.edits[j].offset, record.edits[j].inserted.size());
+                document.insert(record.edits[j].offset, record.edits[j].removed);
+            }
+            return false;
+        }
+        document.erase(edit.offset, edit.removed.size());
+        document.insert(edit.offset, edit.inserted);
+        if (!edit.inserted.empty() || !edit.removed.empty())
+            applied.push_back({edit.offset, edit.removed.size(), edit.inserted.size()});
+    }
+
+    // Cursor son düzenlemenin sonuna gider
+    if (!record.edits.empty())
+    {
+        const Edit &last = record.edits.back();
+        document.positionAt(last.offset + last.inserted.size(), cursor_row, cursor_col);
+    }
+    nodes[nodes[state].parent].redo_child = state;
+    current = state;
+    return true;
+}
+
+void UndoHistory::dropDiverged()
+{
+    // Kalan kayıtların offset'lerine güvenilemez; belge olduğu gibi kalır, geçmiş (ve günlük bağı) atılır
+    clear();
+    applied_known = false;
+    diverged = true;
+}
+
+bool UndoHistory::undo(TextDocument &document, int &cursor_row, int &cursor_col, std::string &operation)
+{
+    closeRecord();
+    if (current == 0)
+        return false;
+
+    operation = nodes[current].record.operation;
+    applied.clear();
+    applied_known = true;
+    diverged = false;
+    if (!applyBackward(document, current, cursor_row, cursor_col))
+    {
+        dropDiverged();
+        return false;
+    }
+    logMove();
+    touch();
+    return true;
+}
+
+bool UndoHistory::redo(TextDocument &document, int &cursor_row, int &cursor_col, std::string &operation)
+{
+    closeRecord();
+    size_t next = nodes[current].redo_child;
+    if (next == NONE)
+        return false;
+
+    operation = nodes[next].record.operation;
+    applied.clear();
+    applied_known = true;
+    diverged = false;
+    if (!applyForward(document, next, cursor_row, cursor_col))
+    {
+        dropDiverged();
+        return false;
+    }
+    logMove();
+    touch();
+    return true;
+}
+
+bool UndoHistory::jumpTo(TextDocument &document, size_t state, int &cursor_row, int &cursor_col)
+{
+    closeRecord();
+    if (state >= nodes.size())
+        return false;
+    applied.clear();
+    applied_known = true;
+    diverged = false;
+    if (state == current)
+        return true;
+
+    // Ortak ata: büyük numaralı taraf her zaman daha derindedir ya da başka daldadır
+    size_t up = current;
+    size_t down = state;
+    size_t up_steps = 0;
+    std::vector<size_t> down_path;
+    while (up != down)
+    {
+        if (up > down)
+        {
+            up = nodes[up].parent;
+            up_steps++;
+        }
+        else
+        {
+            down_path.push_back(down);
+            down = nodes[down].parent;
+        }
+    }
+
+    // Hedefin en yakın checkpoint'li atası
+    std::vector<size_t> replay_path;
+    size_t checkpoint = state;
+    while (!nodes[checkpoint].checkpoint && checkpoint != 0)
+    {
+        replay_path.push_back(checkpoint);
+        checkpoint = nodes[checkpoint].parent;
+    }
+
+    if (nodes[checkpoint].checkpoint && replay_path.size() < up_steps + down_path.size())
+    {
+        document.restore(*nodes[checkpoint].checkpoint);
+        current = checkpoint;
+        applied_known = false;
+        for (size_t i = replay_path.size(); i-- > 0;)
+        {
+            if (!applyForward(document, replay_path[i], cursor_row, cursor_col))
+            {
+                dropDiverged();
+                return false;
+            }
+        }
+    }
+    else
+    {
+        // Yarıda kalırsa belge yoldaki son tutarlı durumda bırakılır
+        for (size_t i = 0; i < up_steps; i++)
+        {
+            if (!applyBackward(document, current, cursor_row, cursor_col))
+            {
+                dropDiverged();
+                return false;
+            }
+        }
+        for (size_t i = down_path.size(); i-- > 0;)
+        {
+            if (!applyForward(document, down_path[i], cursor_row, cursor_col))
+            {
+                dropDiverged();
+                return false;
+            }
+        }
+    }
+
+    logMove();
+    touch();
+    return true;
+}
+
+bool UndoHistory::lastChanges(std::vector<TextChange> &out) const
+{
+    if (!applied_known)
+        return false;
+    out = applied;
+    return true;
+}
+
+size_t UndoHistory::stateAt(std::time_t time) const
+{
+    for (size_t i = nodes.size(); i-- > 0;)
+    {
+        if (nodes[i].time <= time)
+            return i;
+    }
+    return 0;
+}
+
+size_t UndoHistory::redoCount() const
+{
+    size_t count = 0;
+    for (size_t state = nodes[current].redo_child; state != NONE; state = nodes[state].redo_child)
+        count++;
+    return count;
+}
+
+size_t UndoHistory::checkpointCount() const
+{
+    size_t count = 0;
+    for (const Node &node : nodes)
+    {
+        if (node.checkpoint)
+            count++;
+    }
+    return count;
+}
+
+void UndoHistory::clear()
+{
+    journal.reset();
+    resetNodes();
+    pending = false;
+    recording = false;
+    group_depth = 0;
+}
+
+bool UndoHistory::dropOldest()
+{
+    if (current == 0)
+        return false;
+
+    // En eski ~1/16'lık kısım tek seferde atılır, sıkıştırma maliyeti böylece amortize olur.
+    // Mevcut durumun parent'ı yeni kök olabilir ama mevcut durum kalır (en az bir undo adımı).
+    size_t cut = std::min<size_t>(1 + std::max<size_t>(1, nodes.size() / 16), nodes[current].parent + 1);
+    if (cut < 2)
+        return false;
+
+    size_t new_root = current;
+    while (new_root >= cut)
+        new_root = nodes[new_root].parent;
+
+    // Parent her zaman çocuktan önce geldiği için tek geçişte karar verilir
+    std::vector<size_t> remap(nodes.size(), NONE);
+    std::vector<Node> kept;
+    kept.reserve(nodes.size() - cut + 1);
+    for (size_t i = 0; i < nodes.size(); i++)
+    {
+        bool keep = (i == new_root) || (i >= cut && remap[nodes[i].parent] != NONE);
+        if (!keep)
+            continue;
+        remap[i] = kept.size();
+        kept.push_back(std::move(nodes[i]));
+    }
+
+    size_t root_depth = kept[0].depth;
+    for (Node &node : kept)
+    {
+        node.parent = remap[node.parent] == NONE ? 0 : remap[node.parent];
+        node.redo_child = node.redo_child == NONE ? NONE : remap[node.redo_child];
+        node.depth -= root_depth;
+    }
+    kept[0].record = Record();
+    kept[0].record.cursor_row = 0;
+    kept[0].record.cursor_col = 0;
+
+    nodes.swap(kept);
+    current = remap[current];
+
+    bytes = 0;
+    for (const Node &node : nodes)
+        bytes += nodeBytes(node);
+    return true;
+}
@@ -0,0 +1,147 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <ctime>
+#include <memory>
+#include <string>
+#include <vector>
+#include "TextDocument.h"
+
+class UndoJournal;
+
+// Ters işlem günlüğü tabanlı, dallanan undo ağacı
+// Belgenin kopyası yerine sadece düzenlemenin kendisi (offset + silinen/eklenen metin) saklanır;
+// bellek düzenleme boyutuyla orantılıdır, undo/redo O(düzenleme boyutu + log n) çalışır.
+// Her kayıt bir durumdur (state); undo sonrası yapılan düzenleme yeni dal açar, eski dal silinmez.
+// Periyodik checkpoint'ler O(1) belge kopyasıdır (COW rope), uzak durumlara atlarken
+// binlerce düzenlemeyi tek tek oynatmak yerine en yakın checkpoint'ten başlanır.
+// Sınır sayıyla değil byte ile konur: memoryUsage() ve dropOldest() ile sahibi bütçeyi uygular.
+class UndoHistory
+{
+public:
+    struct Edit
+    {
+        size_t offset;
+        std::string removed;  // offset'ten silinen metin
+        std::string inserted; // offset'e eklenen metin
+    };
+
+    struct Record
+    {
+        std::string operation;
+        int cursor_row; // düzenleme öncesi cursor
+        int cursor_col;
+        std::vector<Edit> edits;
+    };
+
+    UndoHistory();
+
+    // Yeni kayıt başlatır; kayıt ilk düzenleme geldiğinde oluşturulur.
+    // mergeable: aynı işlemin bitişik düzenlemeleri (yazma, backspace) önceki kayda katılır;
+    // birleştirme kelime başında, ~1 sn duraklamadan sonra ve boyut sınırında kesilir
+    void begin(const std::string &operation, int cursor_row, int cursor_col, bool mergeable = false);
+
+    // Birleşik komutlar için işlem grubu: endGroup'a kadarki tüm düzenlemeler tek kayıttır.
+    // Gruplar iç içe açılabilir, içteki begin/beginGroup çağrıları yok sayılır.
+    void beginGroup(const std::string &operation, int cursor_row, int cursor_col);
+    void endGroup();
+
+    // Düzenlemeyi belgeye uygular ve açık kayda ekler
+    void insert(TextDocument &document, size_t offset, const std::string &text);
+    void erase(TextDocument &document, size_t offset, size_t count);
+
+    // Kaydı geri alır / son ziyaret edilen dalı yeniden uygular; cursor ve kaydın adı döndürülür.
+    // Her düzenleme uygulanmadan önce belgedeki byte'lar kayıtla karşılaştırılır; tutmazsa
+    // (dosya dışarıda değişmiş, günlük eski) belge bozulmaz, geçmiş atılır ve historyDiverged() true olur.
+    bool undo(TextDocument &document, int &cursor_row, int &cursor_col, std::string &operation);
+    bool redo(TextDocument &document, int &cursor_row, int &cursor_col, std::string &operation);
+    bool historyDiverged() const { return diverged; }
+
+    // Son undo/redo/jumpTo'nun belgeye uyguladığı değişiklikler, uygulanma sırasıyla.
+    // Belge checkpoint'ten yeniden kurulduysa değişiklikler bilinmez, false döner.
+    bool lastChanges(std::vector<TextChange> &out) const;
+
+    // Durumlar oluşturulma sırasıyla numaralıdır (0: başlangıç durumu).
+    // jumpTo ağaçta en kısa yoldan ya da en yakın checkpoint'ten hedefe gider.
+    bool jumpTo(TextDocument &document, size_t state, int &cursor_row, int &cursor_col);
+    size_t currentState() const { return current; }
+    size_t stateCount() const { return nodes.size(); }
+    std::time_t stateTime(size_t state) const { return nodes[state].time; }
+    // Durumun zamanı son düzenlemesinin zamanıdır (birleşen yazma durumu ileri taşır);
+    // stateAt time anında ya da öncesinde son düzenlemesi olan en son durumu verir
+    size_t stateAt(std::time_t time) const;
+
+    void clear();
+    size_t undoCount() const { return nodes[current].depth; }
+    size_t redoCount() const;
+    size_t checkpointCount() const;
+
+    // Kayıtların gerçek bellek kullanımı (metin kapasiteleri dahil)
+    size_t memoryUsage() const { return bytes; }
+    // En son ne zaman düzenlendi/geri alındı - bütçe aşılınca en eski kullanılan geçmiş kırpılır
+    unsigned long long lastUsed() const { return last_used; }
+    // En eski durumların bir bölümünü (~1/16) siler; mevcut durumun son adımı her zaman tutulur
+    bool dropOldest();
+
+    // Kalıcı günlük: bağlıysa her yeni durum, düzenleme ve gezinme günlüğe de yazılır.
+    // clear() günlüğü ayırır; kopyalanan geçmiş (split) günlüğü paylaşmamalı.
+    void attachJournal(std::shared_ptr<UndoJournal> target) { journal = target; }
+
+private:
+    friend class UndoJournal;
+
+    static constexpr size_t NONE = static_cast<size_t>(-1);
+
+    struct Node
+    {
+        size_t parent;     // kökte kendisi
+        size_t redo_child; // redo'nun izleyeceği dal (yoksa NONE)
+        size_t depth;
+        uint64_t serial; // sıkıştırmada değişmeyen kimlik (günlük bunu kullanır)
+        std::time_t time; // son düzenleme zamanı
+        Record record; // parent -> bu durum geçişi
+        std::shared_ptr<const TextDocument> checkpoint;
+    };
+
+    std::vector<Node> nodes; // oluşturulma sırasında, parent her zaman çocuktan önce gelir
+    size_t current;
+    size_t bytes;
+    unsigned long long last_used;
+    static unsigned long long use_clock;
+    uint64_t next_serial;
+    std::shared_ptr<UndoJournal> journal;
+
+    // begin() ile açılan ama henüz düzenleme almamış kayıt
+    bool pending;
+    bool pending_mergeable;
+    Record pending_record;
+    int group_depth;
+    // Mevcut durum düzenleme almaya devam ediyor mu (undo/redo sonrası kapanır)
+    bool recording;
+    // Son düzenlemenin zamanı - duraklamadan sonra birleştirme yapılmaz
+    std::chrono::steady_clock::time_point last_edit;
+
+    // Son gezinmenin değişiklikleri (lastChanges)
+    std::vector<TextChange> applied;
+    bool applied_known;
+    // Son undo/redo/jumpTo belgeyle uyuşmayan bir kayıt bulup geçmişi attı
+    bool diverged;
+
+    void resetNodes();
+    void addEdit(const TextDocument &document, Edit edit);
+    Record &currentRecord(const TextDocument &document);
+    bool applyForward(TextDocument &document, size_t state, int &cursor_row, int &cursor_col);
+    bool applyBackward(TextDocument &document, size_t state, int &cursor_row, int &cursor_col);
+    void dropDiverged();
+    void closeRecord();
+    void logMove();
+    void stampCurrent();
+    void touch() { last_used = ++use_clock; }
+    static bool mergeEdit(Edit &previous, const Edit &next);
+    static bool matches(const TextDocument &document, size_t offset, const std::string &text);
+    static size_t editBytes(const Edit &edit);
+    static size_t nodeBytes(const Node &node);
+    static size_t checkpointBytes(const TextDocument &document);
+};
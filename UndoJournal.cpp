@@ -0,0 +1,628 @@
+#include "UndoJournal.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <unordered_map>
+#include "MappedFile.h"
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace
+{
+    const char MAGIC[] = "GLUJ\x01";
+    const size_t MAGIC_SIZE = 5;
+
+    // Olaylar bu kadar bekler ya da bu kadar birikince diske yazılır
+    const std::chrono::milliseconds BATCH_DELAY(500);
+    const size_t FLUSH_BYTES = 256 * 1024;
+
+    // Bu boyuta kadar parmak izi tüm içerikten, üstünde örneklenmiş bloklardan hesaplanır
+    const size_t FULL_HASH_LIMIT = 64 * 1024 * 1024;
+    const size_t SAMPLE_COUNT = 256;
+    const size_t SAMPLE_SIZE = 4096;
+
+    // LZ: 4 byte'lık dizilerin hash tablosu, 64 KB pencere
+    const size_t MIN_MATCH = 4;
+    const int HASH_BITS = 14;
+    const size_t MAX_DISTANCE = 65535;
+
+    const uint64_t FNV_OFFSET = 14695981039346656037ULL;
+    const uint64_t FNV_PRIME = 1099511628211ULL;
+
+    void putVarint(std::string &out, uint64_t value)
+    {
+        while (value >= 0x80)
+        {
+            out += static_cast<char>((value & 0x7F) | 0x80);
+            value >>= 7;
+        }
+        out += static_cast<char>(value);
+    }
+
+    void putString(std::string &out, const std::string &text)
+    {
+        putVarint(out, text.size());
+        out += text;
+    }
+
+    bool getVarint(const char *&p, const char *end, uint64_t &value)
+    {
+        value = 0;
+        for (int shift = 0; p < end && shift < 64; shift += 7)
+        {
+            uint8_t byte = static_cast<uint8_t>(*p++);
+            value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+            if (!(byte & 0x80))
+                return true;
+        }
+        return false;
+    }
+
+    bool getString(const char *&p, const char *end, std::string &text)
+    {
+        uint64_t length = 0;
+        if (!getVarint(p, end, length) || length > static_cast<uint64_t>(end - p))
+            return false;
+        text.assign(p, static_cast<size_t>(length));
+        p += length;
+        return true;
+    }
+
+    // Parçalara bölünmeden bağımsız, 8 byte'lık kelimelerle çalışan hash
+    struct Hasher
+    {
+        uint64_t hash;
+        uint64_t word;
+        int filled;
+
+        Hasher() : hash(FNV_OFFSET), word(0), filled(0) {}
+
+        void mix(uint64_t value)
+        {
+            hash = (hash ^ value) * FNV_PRIME;
+            hash ^= hash >> 29;
+        }
+
+        void add(const char *data, size_t size)
+        {
+            size_t i = 0;
+            while (i < size && filled != 0)
+                addByte(data[i++]);
+            for (; i + 8 <= size; i += 8)
+            {
+                uint64_t value;
+                memcpy(&value, data + i, 8);
+                mix(value);
+            }
+            while (i < size)
+                addByte(data[i++]);
+        }
+
+        void addByte(char byte)
+        {
+            word |= static_cast<uint64_t>(static_cast<uint8_t>(byte)) << (8 * filled);
+            if (++filled == 8)
+            {
+                mix(word);
+                word = 0;
+                filled = 0;
+            }
+        }
+
+        uint64_t finish()
+        {
+            mix(word ^ static_cast<uint64_t>(filled));
+            return hash;
+        }
+    };
+
+    void syncFile(FILE *file)
+    {
+#ifdef _WIN32
+        _commit(_fileno(file));
+#else
+        fsync(fileno(file));
+#endif
+    }
+}
+
+UndoJournal::UndoJournal(const std::string &file_path) : journal_path(journalPath(file_path)), stopping(false)
+{
+    writer = std::thread(&UndoJournal::run, this);
+}
+
+UndoJournal::~UndoJournal()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wake.notify_all();
+    writer.join();
+}
+
+std::string UndoJournal::sessionDirectory()
+{
+    std::string dir;
+    if (const char *custom = std::getenv("GLITCH_UNDO_DIR"))
+        dir = custom;
+#ifdef _WIN32
+    else if (const char *local = std::getenv("LOCALAPPDATA"))
+        dir = std::string(local) + "\\GlitchEditor\\undo";
+#else
+    else if (const char *state = std::getenv("XDG_STATE_HOME"))
+        dir = std::string(state) + "/glitch-editor/undo";
+    else if (const char *home = std::getenv("HOME"))
+        dir = std::string(home) + "/.local/state/glitch-editor/undo";
+#endif
+    else
+        dir = ".glitch-undo";
+
+    std::error_code error;
+    std::filesystem::create_directories(dir, error);
+    return dir;
+}
+
+std::string UndoJournal::journalPath(const std::string &file_path)
+{
+    // Aynı ada sahip farklı dosyalar karışmasın: mutlak yolun hash'i
+    std::error_code error;
+    std::filesystem::path absolute = std::filesystem::absolute(file_path, error);
+    std::string key = error ? file_path : absolute.string();
+
+    uint64_t hash = FNV_OFFSET;
+    for (char ch : key)
+        hash = (hash ^ static_cast<uint8_t>(ch)) * FNV_PRIME;
+
+    char suffix[32];
+    snprintf(suffix, sizeof(suffix), "-%016llx.undo", static_cast<unsigned long long>(hash));
+    std::string name = std::filesystem::path(file_path).filename().string();
+    return (std::filesystem::path(sessionDirectory()) / (name + suffix)).string();
+}
+
+uint64_t UndoJournal::fingerprint(const TextDocument &document)
+{
+    Hasher hasher;
+    size_t length = document.length();
+    hasher.mix(length);
+
+    auto add = [&hasher](const char *data, size_t size)
+    { hasher.add(data, size); };
+
+    if (length <= FULL_HASH_LIMIT)
+    {
+        document.forEachChunk(0, length, add);
+    }
+    else
+    {
+        for (size_t i = 0; i < SAMPLE_COUNT; i++)
+            document.forEachChunk((length - SAMPLE_SIZE) / (SAMPLE_COUNT - 1) * i, SAMPLE_SIZE, add);
+    }
+    return hasher.finish();
+}
+
+std::string UndoJournal::compress(const std::string &input)
+{
+    // LZ4 benzeri diziler: token (literal uzunluğu | eşleşme uzunluğu - 4), literal'ler,
+    // 2 byte mesafe, uzun uzunluklar için 255'lik devam byte'ları. Son dizi sadece literal'dir.
+    std::string out;
+    out.reserve(input.size() / 2 + 16);
+    std::vector<uint32_t> table(size_t(1) << HASH_BITS, UINT32_MAX);
+
+    const char *data = input.data();
+    size_t size = input.size();
+    size_t pos = 0;
+    size_t anchor = 0;
+
+    auto putLength = [&out](size_t length)
+    {
+        while (length >= 255)
+        {
+            out += static_cast<char>(255);
+            length -= 255;
+        }
+        out += static_cast<char>(length);
+    };
+
+    auto emit = [&](size_t literal_end, size_t distance, size_t match_length)
+    {
+        size_t literals = literal_end - anchor;
+        size_t match_code = match_length ? match_length - MIN_MATCH : 0;
+        out += static_cast<char>((std::min<size_t>(literals, 15) << 4) | std::min<size_t>(match_code, 15));
+        if (literals >= 15)
+            putLength(literals - 15);
+        out.append(data + anchor, literals);
+        if (match_length)
+        {
+            out += static_cast<char>(distance & 0xFF);
+            out += static_cast<char>(distance >> 8);
+            if (match_code >= 15)
+                putLength(match_code - 15);
+        }
+    };
+
+    while (pos + MIN_MATCH <= size)
+    {
+        uint32_t sequence;
+        memcpy(&sequence, data + pos, MIN_MATCH);
+        uint32_t slot = (sequence * 2654435761u) >> (32 - HASH_BITS);
+        uint32_t candidate = table[slot];
+        table[slot] = static_cast<uint32_t>(pos);
+
+        if (candidate != UINT32_MAX && pos - candidate <= MAX_DISTANCE && memcmp(data + candidate, data + pos, MIN_MATCH) == 0)
+        {
+            size_t length = MIN_MATCH;
+            while (pos + length < size && data[candidate + length] == data[pos + length])
+                length++;
+            emit(pos, pos - candidate, length);
+            pos += length;
+            anchor = pos;
+        }
+        else
+        {
+            pos++;
+        }
+    }
+
+    emit(size, 0, 0);
+    return out;
+}
+
+bool UndoJournal::decompress(const char *data, size_t size, size_t raw_size, std::string &out)
+{
+    out.clear();
+    out.reserve(raw_size);
+    const char *p = data;
+    const char *end = data + size;
+
+    auto getLength = [&p, end](size_t &length)
+    {
+        uint8_t byte = 255;
+        while (byte == 255)
+        {
+            if (p >= end)
+                return false;
+            byte = static_cast<uint8_t>(*p++);
+            length += byte;
+        }
+        return true;
+    };
+
+    while (p < end)
+    {
+        uint8_t token = static_cast<uint8_t>(*p++);
+        size_t literals = token >> 4;
+        if (literals == 15 && !getLength(literals))
+            return false;
+        if (literals > static_cast<size_t>(end - p) || out.size() + literals > raw_size)
+            return false;
+        out.append(p, literals);
+        p += literals;
+
+        if (p == end)
+            break;
+
+        if (end - p < 2)
+            return false;
+        size_t distance = static_cast<uint8_t>(p[0]) | (static_cast<size_t>(static_cast<uint8_t>(p[1])) << 8);
+        p += 2;
+        size_t length = token & 15;
+        if (length == 15 && !getLength(length))
+            return false;
+        length += MIN_MATCH;
+
+        if (distance == 0 || distance > out.size() || out.size() + length > raw_size)
+            return false;
+        // Örtüşen kopyalama (tekrarlı diziler) byte byte yapılır
+        size_t from = out.size() - distance;
+        for (size_t i = 0; i < length; i++)
+            out += out[from + i];
+    }
+    return out.size() == raw_size;
+}
+
+void UndoJournal::logNode(uint64_t serial, uint64_t parent_serial, std::time_t time, const UndoHistory::Record &record)
+{
+    std::string event = "N";
+    putVarint(event, serial);
+    putVarint(event, parent_serial);
+    putVarint(event, static_cast<uint64_t>(time));
+    putVarint(event, static_cast<uint64_t>(std::max(0, record.cursor_row)));
+    putVarint(event, static_cast<uint64_t>(std::max(0, record.cursor_col)));
+    putString(event, record.operation);
+    append(event);
+}
+
+void UndoJournal::logEdit(uint64_t serial, const UndoHistory::Edit &edit)
+{
+    std::string event = "E";
+    putVarint(event, serial);
+    putVarint(event, edit.offset);
+    putString(event, edit.removed);
+    putString(event, edit.inserted);
+    append(event);
+}
+
+void UndoJournal::logTime(uint64_t serial, std::time_t time)
+{
+    std::string event = "T";
+    putVarint(event, serial);
+    putVarint(event, static_cast<uint64_t>(time));
+    append(event);
+}
+
+void UndoJournal::logMove(uint64_t serial)
+{
+    std::string event = "M";
+    putVarint(event, serial);
+    append(event);
+}
+
+void UndoJournal::append(const std::string &event)
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        pending += event;
+    }
+    wake.notify_one();
+}
+
+void UndoJournal::encodeTree(const Dump &tree, std::string &out)
+{
+    // Başlık: kaydedilen içeriğin parmak izi ve o içeriğe karşılık gelen durum
+    out += 'S';
+    putVarint(out, tree.document.length());
+    putVarint(out, fingerprint(tree.document));
+    putVarint(out, tree.nodes[tree.current].serial);
+
+    for (const UndoHistory::Node &node : tree.nodes)
+    {
+        out += 'N';
+        putVarint(out, node.serial);
+        putVarint(out, tree.nodes[node.parent].serial);
+        putVarint(out, static_cast<uint64_t>(node.time));
+        putVarint(out, static_cast<uint64_t>(std::max(0, node.record.cursor_row)));
+        putVarint(out, static_cast<uint64_t>(std::max(0, node.record.cursor_col)));
+        putString(out, node.record.operation);
+
+        for (const UndoHistory::Edit &edit : node.record.edits)
+        {
+            out += 'E';
+            putVarint(out, node.serial);
+            putVarint(out, edit.offset);
+            putString(out, edit.removed);
+            putString(out, edit.inserted);
+        }
+    }
+
+    out += 'M';
+    putVarint(out, tree.nodes[tree.current].serial);
+}
+
+void UndoJournal::rewrite(const UndoHistory &history, const TextDocument &document)
+{
+    // Checkpoint'ler günlüğe yazılmaz, kopyada tutulmaz
+    std::unique_ptr<Dump> tree(new Dump{history.nodes, history.current, document.snapshot()});
+    for (UndoHistory::Node &node : tree->nodes)
+        node.checkpoint.reset();
+
+    std::vector<std::unique_ptr<Dump>> done;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        dump.swap(tree); // henüz yazılmamış eski döküm varsa tree'de kalır, burada bırakılır
+        done.swap(written);
+        pending.clear(); // eski olaylar yeni dökümün içinde
+    }
+    wake.notify_one();
+}
+
+bool UndoJournal::restore(UndoHistory &history, const TextDocument &document)
+{
+    FILE *file = fopen(journal_path.c_str(), "rb");
+    if (!file)
+        return false;
+
+    std::string content;
+    char buffer[65536];
+    size_t read = 0;
+    while ((read = fread(buffer, 1, sizeof(buffer), file)) > 0)
+        content.append(buffer, read);
+    fclose(file);
+
+    if (content.size() < MAGIC_SIZE || content.compare(0, MAGIC_SIZE, MAGIC, MAGIC_SIZE) != 0)
+        return false;
+
+    // Blokları aç; çökmede yarım kalan son blok atlanır
+    std::string events;
+    const char *p = content.data() + MAGIC_SIZE;
+    const char *end = content.data() + content.size();
+    std::string block;
+    while (p < end)
+    {
+        uint64_t raw_size = 0;
+        uint64_t packed_size = 0;
+        if (!getVarint(p, end, raw_size) || !getVarint(p, end, packed_size) ||
+            packed_size > static_cast<uint64_t>(end - p) ||
+            !decompress(p, static_cast<size_t>(packed_size), static_cast<size_t>(raw_size), block))
+            break;
+        p += packed_size;
+        events += block;
+    }
+
+    p = events.data();
+    end = events.data() + events.size();
+
+    uint64_t length = 0;
+    uint64_t saved_fingerprint = 0;
+    uint64_t saved_serial = 0;
+    if (p == end || *p++ != 'S' || !getVarint(p, end, length) || !getVarint(p, end, saved_fingerprint) ||
+        !getVarint(p, end, saved_serial))
+        return false;
+    if (length != document.length() || saved_fingerprint != fingerprint(document))
+        return false;
+
+    std::vector<UndoHistory::Node> nodes;
+    std::unordered_map<uint64_t, size_t> index;
+    uint64_t last_serial = saved_serial;
+
+    while (p < end)
+    {
+        char type = *p++;
+        uint64_t serial = 0;
+        if (!getVarint(p, end, serial))
+            break;
+
+        if (type == 'N')
+        {
+            uint64_t parent = 0, time = 0, row = 0, col = 0;
+            UndoHistory::Node node;
+            if (!getVarint(p, end, parent) || !getVarint(p, end, time) || !getVarint(p, end, row) ||
+                !getVarint(p, end, col) || !getString(p, end, node.record.operation))
+                break;
+
+            bool is_root = nodes.empty() && parent == serial;
+            auto found = index.find(parent);
+            if (!is_root && found == index.end())
+                break;
+
+            node.parent = is_root ? 0 : found->second;
+            node.redo_child = UndoHistory::NONE;
+            node.depth = is_root ? 0 : nodes[node.parent].depth + 1;
+            node.serial = serial;
+            node.time = static_cast<std::time_t>(time);
+            node.record.cursor_row = static_cast<int>(row);
+            node.record.cursor_col = static_cast<int>(col);
+            index[serial] = nodes.size();
+            last_serial = serial; // yeni durum aynı zamanda mevcut durum olur
+            if (!is_root)
+                nodes[node.parent].redo_child = nodes.size();
+            nodes.push_back(std::move(node));
+        }
+        else if (type == 'E')
+        {
+            UndoHistory::Edit edit;
+            uint64_t offset = 0;
+            auto found = index.find(serial);
+            if (!getVarint(p, end, offset) || !getString(p, end, edit.removed) || !getString(p, end, edit.inserted) ||
+                found == index.end() || found->second == 0)
+                break;
+            edit.offset = static_cast<size_t>(offset);
+            nodes[found->second].record.edits.push_back(std::move(edit));
+        }
+        else if (type == 'T')
+        {
+            uint64_t time = 0;
+            auto found = index.find(serial);
+            if (!getVarint(p, end, time) || found == index.end())
+                break;
+            nodes[found->second].time = static_cast<std::time_t>(time);
+        }
+        else if (type == 'M')
+        {
+            if (index.count(serial))
+                last_serial = serial;
+        }
+        else
+        {
+            break;
+        }
+    }
+
+    auto saved = index.find(saved_serial);
+    if (saved == index.end())
+        return false;
+
+    // Çökme öncesi son duruma giden yol redo ile izlenebilsin
+    for (size_t state = index[last_serial]; state != 0; state = nodes[state].parent)
+        nodes[nodes[state].parent].redo_child = state;
+
+    uint64_t max_serial = 0;
+    for (const UndoHistory::Node &node : nodes)
+        max_serial = std::max(max_serial, node.serial);
+
+    history.clear();
+    history.nodes.swap(nodes);
+    history.current = saved->second;
+    history.next_serial = max_serial + 1;
+    history.bytes = 0;
+    for (const UndoHistory::Node &node : history.nodes)
+        history.bytes += UndoHistory::nodeBytes(node);
+    return true;
+}
+
+bool UndoJournal::writeBlocks(const std::string &path, const std::string &events, bool truncate)
+{
+    // Baştan yazma geçici dosyaya yapılır, böylece yarım döküm eski günlüğü bozmaz
+    std::string target = truncate ? path + ".tmp" : path;
+    FILE *file = fopen(target.c_str(), truncate ? "wb" : "ab");
+    if (!file)
+        return false;
+
+    std::string block;
+    if (truncate)
+        block.append(MAGIC, MAGIC_SIZE);
+    std::string packed = compress(events);
+    putVarint(block, events.size());
+    putVarint(block, packed.size());
+    block += packed;
+
+    bool ok = fwrite(block.data(), 1, block.size(), file) == block.size();
+    ok = fflush(file) == 0 && ok;
+    syncFile(file);
+    ok = fclose(file) == 0 && ok;
+
+    if (truncate)
+    {
+        if (!ok || !MappedFile::replaceFile(target, path))
+        {
+            std::remove(target.c_str());
+            return false;
+        }
+    }
+    return ok;
+}
+
+void UndoJournal::run()
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    for (;;)
+    {
+        wake.wait(lock, [this]()
+                  { return stopping || !pending.empty() || dump; });
+
+        // Tuş vuruşlarını tek bloğa toplamak için kısa süre daha bekle
+        if (!stopping && !dump)
+            wake.wait_for(lock, BATCH_DELAY, [this]()
+                          { return stopping || pending.size() >= FLUSH_BYTES || dump; });
+
+        std::unique_ptr<Dump> tree = std::move(dump);
+        std::string events;
+        events.swap(pending);
+        bool stop = stopping;
+
+        lock.unlock();
+        if (tree)
+        {
+            std::string full;
+            encodeTree(*tree, full);
+            tree->nodes.clear();
+            writeBlocks(journal_path, full, true);
+        }
+        if (!events.empty())
+            writeBlocks(journal_path, events, false);
+        lock.lock();
+        if (tree)
+            written.push_back(std::move(tree));
+
+        if (stop && pending.empty() && !dump)
+            break;
+    }
+}
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <ctime>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "UndoHistory.h"
+
+// Dosya başına kalıcı undo günlüğü (oturum dizininde, dosya yolunun hash'i ile adlandırılır)
+// - Sadece sona eklenir: yeni durum, düzenleme, durum zamanı ve gezinme olayları küçük bloklar halinde yazılır
+// - Bloklar LZ ile sıkıştırılır; yazma ve fsync arka plan thread'inde toplu yapılır
+// - Kaydetmede günlük mevcut ağaçla baştan yazılır ve kaydedilen içeriğin parmak izini taşır;
+//   ağacın kodlanması ve parmak izi de arka plan thread'inde hesaplanır
+// - Bir dosyanın tek günlüğü olur ve tek geçmişi yazar (aynı dosyayı gösteren paneller günlüğü devralır)
+// - Açılışta parmak izi tutarsa ağaç geri yüklenir; kaydedilmemiş (çökme öncesi) düzenlemeler redo ile alınır
+// - Büyük dosyalarda parmak izi örneklemedir; dışarıdaki değişikliği undo/redo kayıtla belgeyi karşılaştırarak yakalar
+class UndoJournal
+{
+public:
+    explicit UndoJournal(const std::string &file_path);
+    ~UndoJournal();
+    UndoJournal(const UndoJournal &) = delete;
+    UndoJournal &operator=(const UndoJournal &) = delete;
+
+    // Günlük bu belge içeriğine aitse geçmişi geri yükler (belge kaydedilen durumda kalır)
+    bool restore(UndoHistory &history, const TextDocument &document);
+    // Günlüğü mevcut ağaçla baştan yazar (kaydetmeden ya da yeni açılıştan sonra). Ağaç kopyalanır,
+    // belgenin anlık görüntüsü alınır; kodlama ve yazma arka planda yapılır
+    void rewrite(const UndoHistory &history, const TextDocument &document);
+
+    // UndoHistory tarafından çağrılır
+    void logNode(uint64_t serial, uint64_t parent_serial, std::time_t time, const UndoHistory::Record &record);
+    void logEdit(uint64_t serial, const UndoHistory::Edit &edit);
+    void logTime(uint64_t serial, std::time_t time);
+    void logMove(uint64_t serial);
+
+    const std::string &path() const { return journal_path; }
+
+    // Oturum dizini (yoksa oluşturulur) ve dosya için günlük yolu
+    static std::string sessionDirectory();
+    static std::string journalPath(const std::string &file_path);
+    // Belge içeriğinin boyutu + hash'i; büyük dosyalarda örneklenmiş bloklar kullanılır
+    static uint64_t fingerprint(const TextDocument &document);
+
+    // LZ blok sıkıştırma (günlük bloklarında kullanılır)
+    static std::string compress(const std::string &input);
+    static bool decompress(const char *data, size_t size, size_t raw_size, std::string &out);
+
+private:
+    std::string journal_path;
+
+    // Baştan yazılacak ağaç ve kaydedilen içerik
+    struct Dump
+    {
+        std::vector<UndoHistory::Node> nodes;
+        size_t current;
+        TextDocument document;
+    };
+
+    std::mutex mutex;
+    std::condition_variable wake;
+    std::string pending;       // henüz yazılmamış olaylar
+    std::unique_ptr<Dump> dump; // varsa dosya önce bununla baştan yazılır
+    // Yazılmış dökümler: belge kopyaları paylaştıkları node'ları use_count ile kopyalar, bu yüzden
+    // anlık görüntünün son referansı thread'de değil UI thread'inde (sonraki rewrite ya da yıkıcı) bırakılır
+    std::vector<std::unique_ptr<Dump>> written;
+    bool stopping;
+    std::thread writer;
+
+    void append(const std::string &event);
+    void run();
+    bool writeBlocks(const std::string &path, const std::string &events, bool truncate);
+    static void encodeTree(const Dump &tree, std::string &out);
+};
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <atomic>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+// Çalışma alanındaki normal dosyaları gezer (indeksler için; FindInFiles ile aynı kurallar):
+// gizli girdiler (.git gibi) ve sembolik bağlantılı dizinler atlanır, adı çevrilemeyen girdiler yok sayılır.
+// fn her dosyanın directory_entry'si ile çağrılır.
+template <typename Fn>
+void walkWorkspace(const std::string &root, const std::atomic<bool> &cancelled, Fn fn)
+{
+    namespace fs = std::filesystem;
+    std::vector<fs::path> stack(1, fs::path(root));
+    while (!stack.empty() && !cancelled)
+    {
+        fs::path dir = stack.back();
+        stack.pop_back();
+        try
+        {
+            std::error_code error;
+            for (fs::directory_iterator it(dir, error), end; !error && it != end && !cancelled; it.increment(error))
+            {
+                const fs::directory_entry &entry = *it;
+                std::string name = entry.path().filename().string();
+                if (name.empty() || name[0] == '.')
+                    continue;
+
+                std::error_code type_error;
+                if (entry.is_directory(type_error))
+                {
+                    if (!entry.is_symlink(type_error))
+                        stack.push_back(entry.path());
+                }
+                else if (entry.is_regular_file(type_error))
+                {
+                    fn(entry);
+                }
+            }
+        }
+        catch (...)
+        {
+        }
+    }
+}
+
+// Mutlak, normalize edilmiş ve sonda ayırıcı olmayan kök yolu (indeksler yolları buna göre tutar);
+// sürücü ve dosya sistemi kökleri (C:\, /) ayırıcıyı korur
+inline std::string workspaceRoot(const std::string &path)
+{
+    std::error_code error;
+    std::filesystem::path absolute = std::filesystem::absolute(path, error);
+    if (error)
+        return path;
+    absolute = absolute.lexically_normal();
+    if (!absolute.has_filename() && absolute.has_relative_path())
+        absolute = absolute.parent_path(); // sondaki ayırıcı
+    return absolute.string();
+}
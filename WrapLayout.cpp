@@ -0,0 +1,519 @@
+#include "WrapLayout.h"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
+namespace
+{
+    // Bundan çok satır eklenince satırlar tek tek lineLength ile değil, byte'ları taranarak ölçülür
+    const int MEASURE_SCAN_LINES = 64;
+}
+
+WrapLayout::WrapLayout()
+    : nodes(1, Block{std::vector<uint32_t>(), 0, 0, 0, 0, 0, 0}), root(0), seed(2463534242u), width(0),
+      document_revision(0)
+{
+}
+
+uint32_t WrapLayout::rowsFor(size_t length, int columns)
+{
+    if (columns <= 0)
+        return 1;
+    size_t rows = length / static_cast<size_t>(columns) + 1;
+    return static_cast<uint32_t>(std::min<size_t>(rows, std::numeric_limits<uint32_t>::max()));
+}
+
+bool WrapLayout::measure(const TextDocument &document, int first, int count, int columns, std::vector<uint32_t> &out,
+                         const std::atomic<bool> *cancelled)
+{
+    int last = std::min(first + count, document.lineCount());
+    if (first >= last)
+        return true;
+
+    // Satır sonları memchr ile bulunur; CRLF'deki '\r' satır uzunluğuna dahil değil (lineLength gibi)
+    size_t start = document.lineStart(first);
+    int line = first;
+    size_t length = 0;
+    char previous = '\n';
+    bool stopped = false;
+    document.forEachChunkUntil(start, document.length() - start, [&](const char *data, size_t size)
+                               {
+        if (cancelled && *cancelled)
+        {
+            stopped = true;
+            return false;
+        }
+        const char *p = data;
+        const char *end = data + size;
+        while (p < end)
+        {
+            const char *newline = static_cast<const char *>(std::memchr(p, '\n', end - p));
+            if (!newline)
+            {
+                length += end - p;
+                previous = end[-1];
+                break;
+            }
+            length += newline - p;
+            bool carriage = length > 0 && (newline > p ? newline[-1] : previous) == '\r';
+            out.push_back(rowsFor(length - (carriage ? 1 : 0), columns));
+            previous = '\n';
+            length = 0;
+            p = newline + 1;
+            if (++line == last)
+                return false;
+        }
+        return true; });
+
+    if (stopped)
+        return false;
+    if (line < last)
+        out.push_back(rowsFor(length, columns)); // sonunda satır sonu olmayan son satır
+    return true;
+}
+
+void WrapLayout::reset(int line_count, int columns, size_t revision)
+{
+    if (lineCount() != line_count)
+        rebuild(std::vector<uint32_t>(static_cast<size_t>(std::max(line_count, 0)), 1));
+    width = columns;
+    document_revision = revision;
+}
+
+void WrapLayout::assign(std::vector<uint32_t> &&line_rows, int columns, size_t revision)
+{
+    rebuild(line_rows);
+    width = columns;
+    document_revision = revision;
+}
+
+long long WrapLayout::replaceLines(const TextDocument &document, int first, int removed, int inserted)
+{
+    first = std::max(0, std::min(first, lineCount()));
+    removed = std::max(0, std::min(removed, lineCount() - first));
+    inserted = std::max(inserted, 0);
+
+    // Satır sayısı değişmediyse sadece değişen sayılar yerinde güncellenir
+    if (removed == inserted)
+    {
+        long long delta = 0;
+        for (int i = 0; i < inserted; i++)
+            delta += setRows(root, static_cast<size_t>(first + i),
+                             rowsFor(static_cast<size_t>(document.lineLength(first + i)), width));
+        return delta;
+    }
+
+    std::vector<uint32_t> rows;
+    rows.reserve(static_cast<size_t>(inserted));
+    if (inserted > MEASURE_SCAN_LINES)
+    {
+        measure(document, first, inserted, width, rows);
+    }
+    else
+    {
+        for (int i = 0; i < inserted; i++)
+            rows.push_back(rowsFor(static_cast<size_t>(document.lineLength(first + i)), width));
+    }
+
+    // Değişen satırları (satır eklemede en az bir komşuyu) içeren bloklar ağaçtan ayrılır, sayılar orada
+    // değiştirilip yeniden bloklanır ve ağaca geri eklenir; bloklar böylece küçülüp parçalanmaz
+    size_t count = static_cast<size_t>(lineCount());
+    size_t low = static_cast<size_t>(first);
+    size_t high = std::max(low + static_cast<size_t>(removed), low + 1);
+    if (high > count)
+    {
+        high = count;
+        low = std::min(low, count > 0 ? count - 1 : 0);
+    }
+    uint32_t left = 0, middle = 0, right = 0;
+    size_t base = count > 0 ? blockStart(low) : 0;
+    split(root, base, left, middle);
+    split(middle, high - base, middle, right);
+
+    std::vector<uint32_t> local;
+    flatten(middle, local);
+    release(middle);
+    long long before = 0;
+    for (int i = 0; i < removed; i++)
+        before += local[static_cast<size_t>(first) - base + i];
+    auto at = local.begin() + (static_cast<size_t>(first) - base);
+    at = local.erase(at, at + removed);
+    local.insert(at, rows.begin(), rows.end());
+    root = merge(merge(left, build(local)), right);
+
+    long long after = 0;
+    for (uint32_t value : rows)
+        after += value;
+    return after - before;
+}
+
+long long WrapLayout::update(const TextDocument &document, int old_line_count, const std::vector<TextChange> &changes,
+                            LineEdit *edit)
+{
+    if (changes.empty() || lineCount() != old_line_count)
+        return 0;
+
+    // Değişikliklerin belgenin son halinde kapladığı bölge: önceki bölge her değişiklikle kaydırılır
+    size_t low = 0;
+    size_t high = 0;
+    for (size_t i = 0; i < changes.size(); i++)
+    {
+        const TextChange &change = changes[i];
+        size_t removed_end = change.offset + change.removed;
+        if (i > 0)
+        {
+            low = low <= change.offset ? low : (low >= removed_end ? low - change.removed + change.inserted : change.offset);
+            high = high <= change.offset ? high
+                                         : (high >= removed_end ? high - change.removed + change.inserted
+                                                                : change.offset + change.inserted);
+        }
+        low = i > 0 ? std::min(low, change.offset) : change.offset;
+        high = i > 0 ? std::max(high, change.offset + change.inserted) : change.offset + change.inserted;
+    }
+
+    int first = 0, last = 0, col = 0;
+    document.positionAt(low, first, col);
+    document.positionAt(high, last, col);
+    int inserted = last - first + 1;
+    int removed = inserted - (document.lineCount() - old_line_count);
+    long long delta = replaceLines(document, first, removed, inserted);
+    document_revision = document.revision();
+    if (edit)
+        *edit = LineEdit{first, removed, inserted};
+    return delta;
+}
+
+bool WrapLayout::merge(std::vector<uint32_t> &&measured, const std::vector<LineEdit> &edits)
+{
+    // Düzenlenen satırlar 0 ile işaretlenir (gerçek sayı en az 1'dir), sonra buradaki sayılarla doldurulur
+    for (const LineEdit &edit : edits)
+    {
+        if (edit.first < 0 || edit.removed < 0 || edit.inserted < 0 ||
+            static_cast<size_t>(edit.first) + edit.removed > measured.size())
+            return false;
+        auto first = measured.begin() + edit.first;
+        if (edit.removed == edit.inserted)
+        {
+            std::fill(first, first + edit.inserted, 0);
+        }
+        else
+        {
+            first = measured.erase(first, first + edit.removed);
+            measured.insert(first, static_cast<size_t>(edit.inserted), 0);
+        }
+    }
+    if (measured.size() != static_cast<size_t>(lineCount()))
+        return false;
+
+    std::vector<uint32_t> current;
+    current.reserve(measured.size());
+    flatten(root, current);
+    for (size_t i = 0; i < measured.size(); i++)
+    {
+        if (measured[i] == 0)
+            measured[i] = current[i];
+    }
+    rebuild(measured);
+    return true;
+}
+
+uint32_t WrapLayout::rows(int line) const
+{
+    if (line < 0 || line >= lineCount())
+        return 1;
+    size_t index = static_cast<size_t>(line);
+    uint32_t node = root;
+    while (node)
+    {
+        const Block &block = nodes[node];
+        size_t left_lines = nodes[block.left].lines;
+        if (index < left_lines)
+        {
+            node = block.left;
+            continue;
+        }
+        index -= left_lines;
+        if (index < block.rows.size())
+            return block.rows[index];
+        index -= block.rows.size();
+        node = block.right;
+    }
+    return 1;
+}
+
+size_t WrapLayout::rowsBefore(int line) const
+{
+    size_t index = static_cast<size_t>(std::max(0, std::min(line, lineCount())));
+    uint64_t sum = 0;
+    uint32_t node = root;
+    while (node)
+    {
+        const Block &block = nodes[node];
+        size_t left_lines = nodes[block.left].lines;
+        if (index < left_lines)
+        {
+            node = block.left;
+            continue;
+        }
+        sum += nodes[block.left].total;
+        index -= left_lines;
+        if (index < block.rows.size())
+        {
+            for (size_t i = 0; i < index; i++)
+                sum += block.rows[i];
+            break;
+        }
+        sum += block.block_total;
+        index -= block.rows.size();
+        node = block.right;
+    }
+    return static_cast<size_t>(sum);
+}
+
+int WrapLayout::lineAt(size_t row, int &sub_row) const
+{
+    sub_row = 0;
+    if (!root)
+        return 0;
+
+    // Görsel satırı içeren blok ağaçta yukarıdan aşağı inerek, satır blokta sırayla bulunur
+    uint64_t remaining = std::min<uint64_t>(row, nodes[root].total - 1);
+    size_t line = 0;
+    uint32_t node = root;
+    while (node)
+    {
+        const Block &block = nodes[node];
+        if (remaining < nodes[block.left].total)
+        {
+            node = block.left;
+            continue;
+        }
+        remaining -= nodes[block.left].total;
+        line += nodes[block.left].lines;
+        if (remaining < block.block_total)
+        {
+            for (uint32_t rows : block.rows)
+            {
+                if (remaining < rows)
+                    break;
+                remaining -= rows;
+                line++;
+            }
+            break;
+        }
+        remaining -= block.block_total;
+        line += block.rows.size();
+        node = block.right;
+    }
+    sub_row = static_cast<int>(remaining);
+    return static_cast<int>(line);
+}
+
+size_t WrapLayout::memoryUsage() const
+{
+    size_t bytes = nodes.capacity() * sizeof(Block) + free_nodes.capacity() * sizeof(uint32_t);
+    for (const Block &block : nodes)
+        bytes += block.rows.capacity() * sizeof(uint32_t);
+    return bytes;
+}
+
+uint32_t WrapLayout::allocate(const uint32_t *rows, size_t count)
+{
+    // xorshift: düğüm öncelikleri ağacı beklenen O(log n) derinlikte tutar
+    seed ^= seed << 13;
+    seed ^= seed >> 17;
+    seed ^= seed << 5;
+
+    uint32_t index;
+    if (!free_nodes.empty())
+    {
+        index = free_nodes.back();
+        free_nodes.pop_back();
+    }
+    else
+    {
+        nodes.push_back(Block{std::vector<uint32_t>(), 0, 0, 0, 0, 0, 0});
+        index = static_cast<uint32_t>(nodes.size() - 1);
+    }
+    Block &block = nodes[index];
+    block.rows.assign(rows, rows + count);
+    block.block_total = 0;
+    for (size_t i = 0; i < count; i++)
+        block.block_total += rows[i];
+    block.left = block.right = 0;
+    block.priority = seed;
+    pull(index);
+    return index;
+}
+
+void WrapLayout::release(uint32_t node)
+{
+    if (!node)
+        return;
+    release(nodes[node].left);
+    release(nodes[node].right);
+    nodes[node].rows.clear();
+    free_nodes.push_back(node);
+}
+
+void WrapLayout::pull(uint32_t node)
+{
+    Block &block = nodes[node];
+    block.lines = nodes[block.left].lines + block.rows.size() + nodes[block.right].lines;
+    block.total = nodes[block.left].total + block.block_total + nodes[block.right].total;
+}
+
+uint32_t WrapLayout::merge(uint32_t left, uint32_t right)
+{
+    if (!left || !right)
+        return left ? left : right;
+    if (nodes[left].priority > nodes[right].priority)
+    {
+        nodes[left].right = merge(nodes[left].right, right);
+        pull(left);
+        return left;
+    }
+    nodes[right].left = merge(left, nodes[right].left);
+    pull(right);
+    return right;
+}
+
+void WrapLayout::split(uint32_t node, size_t line, uint32_t &left, uint32_t &right)
+{
+    if (!node)
+    {
+        left = right = 0;
+        return;
+    }
+
+    size_t start = nodes[nodes[node].left].lines;
+    if (start < line)
+    {
+        split(nodes[node].right, line - start - nodes[node].rows.size(), nodes[node].right, right);
+        left = node;
+    }
+    else
+    {
+        split(nodes[node].left, line, left, nodes[node].left);
+        right = node;
+    }
+    pull(node);
+}
+
+uint32_t WrapLayout::build(const std::vector<uint32_t> &rows)
+{
+    // Bloklar eşit boyda (en fazla BLOCK_LINES); sıralı bloklardan O(k) treap, sağ kenar yığında tutulur
+    size_t block_count = (rows.size() + BLOCK_LINES - 1) / BLOCK_LINES;
+    std::vector<uint32_t> spine;
+    for (size_t k = 0; k < block_count; k++)
+    {
+        size_t from = rows.size() * k / block_count;
+        size_t to = rows.size() * (k + 1) / block_count;
+        uint32_t node = allocate(rows.data() + from, to - from);
+
+        uint32_t last = 0;
+        while (!spine.empty() && nodes[spine.back()].priority < nodes[node].priority)
+        {
+            last = spine.back();
+            spine.pop_back();
+            pull(last);
+        }
+        nodes[node].left = last;
+        if (!spine.empty())
+            nodes[spine.back()].right = node;
+        spine.push_back(node);
+    }
+    for (size_t i = spine.size(); i-- > 0;)
+        pull(spine[i]);
+    return spine.empty() ? 0 : spine.front();
+}
+
+void WrapLayout::flatten(uint32_t node, std::vector<uint32_t> &out) const
+{
+    if (!node)
+        return;
+    flatten(nodes[node].left, out);
+    out.insert(out.end(), nodes[node].rows.begin(), nodes[node].rows.end());
+    flatten(nodes[node].right, out);
+}
+
+size_t WrapLayout::blockStart(size_t line) const
+{
+    size_t start = 0;
+    uint32_t node = root;
+    while (node)
+    {
+        const Block &block = nodes[node];
+        size_t left_lines = nodes[block.left].lines;
+        if (line < left_lines)
+        {
+            node = block.left;
+            continue;
+        }
+        start += left_lines;
+        line -= left_lines;
+        if (line < block.rows.size())
+            break;
+        start += block.rows.size();
+        line -= block.rows.size();
+        node = block.right;
+    }
+    return start;
+}
+
+long long WrapLayout::setRows(uint32_t node, size_t line, uint32_t rows)
+{
+    if (!node)
+        return 0;
+    Block &block = nodes[node];
+    size_t left_lines = nodes[block.left].lines;
+    long long delta = 0;
+    if (line < left_lines)
+    {
+        delta = setRows(block.left, line, rows);
+    }
+    else if (line - left_lines < block.rows.size())
+    {
+        uint32_t &current = block.rows[line - left_lines];
+        delta = static_cast<long long>(rows) - current;
+        current = rows;
+        block.block_total += static_cast<uint64_t>(delta);
+    }
+    else
+    {
+        delta = setRows(block.right, line - left_lines - block.rows.size(), rows);
+    }
+    block.total += static_cast<uint64_t>(delta);
+    return delta;
+}
+
+void WrapLayout::rebuild(const std::vector<uint32_t> &rows)
+{
+    nodes.assign(1, Block{std::vector<uint32_t>(), 0, 0, 0, 0, 0, 0});
+    free_nodes.clear();
+    nodes.reserve((rows.size() + BLOCK_LINES - 1) / BLOCK_LINES + 1);
+    root = build(rows);
+}
+
+WrapWorker::WrapWorker(TextDocument snapshot, int columns, std::function<void()> done_callback)
+    : document(std::move(snapshot)), width(columns), on_done(std::move(done_callback)), done(false), cancelled(false)
+{
+    worker = std::thread(&WrapWorker::run, this);
+}
+
+WrapWorker::~WrapWorker()
+{
+    cancelled = true;
+    if (worker.joinable())
+        worker.join();
+}
+
+void WrapWorker::run()
+{
+    rows.reserve(static_cast<size_t>(document.lineCount()));
+    bool complete = WrapLayout::measure(document, 0, document.lineCount(), width, rows, &cancelled);
+    done = true;
+    if (complete && on_done && !cancelled)
+        on_done();
+}
@@ -0,0 +1,134 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <thread>
+#include <vector>
+#include "TextDocument.h"
+
+// Satır kaydırma (soft wrap) düzeni: her belge satırının kaç görsel satır tuttuğu ve önek toplamları
+// - Satırlar sütun sınırında bölünür; sabit genişlikli yazı tipinde görsel satır sayısı sadece
+//   satırın uzunluğuna bağlıdır (içeriğe bakılmaz, 50 MB'lık satır da O(log n) ile ölçülür)
+// - Sayılar en fazla BLOCK_LINES satırlık bloklarda, bloklar örtük (sıra anahtarlı) bir treap'te tutulur;
+//   her düğüm alt ağacındaki belge satırlarını ve görsel satırları saklar (MatchList'teki gap toplamları gibi).
+//   Görsel satır <-> belge satırı dönüşümleri O(log n + blok)
+// - Düzenlemede sadece değişen satırlar yeniden ölçülür. Satır sayısı aynı kalırsa sayılar yerinde, satır
+//   eklenip silinirse sadece etkilenen bloklar yeniden kurulup ağaca geri eklenir: O(log n + blok + değişen)
+// İmleç satır sonunda da bir hücre bulur: tam sığan satırın altında boş bir görsel satır vardır.
+class WrapLayout
+{
+public:
+    // Düzenlemenin belge satırlarındaki izi: [first, first + removed) satırlarının yerini inserted satır aldı
+    struct LineEdit
+    {
+        int first;
+        int removed;
+        int inserted;
+    };
+
+    WrapLayout();
+
+    // length karakterlik satırın görsel satır sayısı
+    static uint32_t rowsFor(size_t length, int columns);
+    // [first, first + count) satırlarının görsel satır sayılarını out'a ekler; belge byte'ları bir kez
+    // taranır (arka planda tüm belge için). cancelled gelirse yarıda bırakır, false döner
+    static bool measure(const TextDocument &document, int first, int count, int columns, std::vector<uint32_t> &out,
+                        const std::atomic<bool> *cancelled = nullptr);
+
+    int columns() const { return width; }
+    int lineCount() const { return static_cast<int>(nodes[root].lines); }
+    // Sayıların ait olduğu belge revizyonu
+    size_t revision() const { return document_revision; }
+    void setRevision(size_t revision) { document_revision = revision; }
+
+    // Satır sayısı aynıysa eski sayılar yaklaşık değer olarak kalır, değilse her satır tek görsel satır
+    // varsayılır; gerçek sayılar sonradan replaceLines ya da assign ile gelir
+    void reset(int line_count, int columns, size_t revision);
+    // Tüm satırların ölçülmüş sayıları (WrapWorker)
+    void assign(std::vector<uint32_t> &&line_rows, int columns, size_t revision);
+    // Belgede [first, first + removed) satırlarının yerini [first, first + inserted) aldı; yeniler ölçülür.
+    // Görsel satır sayısındaki değişim döner (0 değilse alttaki satırlar kaymıştır)
+    long long replaceLines(const TextDocument &document, int first, int removed, int inserted);
+    // Belgeye sırayla uygulanan değişiklikler; old_line_count değişikliklerden önceki satır sayısı.
+    // Uygulanırsa revizyon belgeninkine eşitlenir ve edit verildiyse değişen satırlar oraya yazılır
+    long long update(const TextDocument &document, int old_line_count, const std::vector<TextChange> &changes,
+                     LineEdit *edit = nullptr);
+    // Arka planda anlık görüntü üzerinde ölçülen sayılar, görüntüden sonraki düzenlemelerle (sırayla) kaydırılıp
+    // alınır; düzenlenen satırların sayıları bu düzenden gelir. Satır sayısı tutmazsa false döner
+    bool merge(std::vector<uint32_t> &&measured, const std::vector<LineEdit> &edits);
+
+    uint32_t rows(int line) const;
+    // line'dan önceki görsel satırlar (line == lineCount(): toplam)
+    size_t rowsBefore(int line) const;
+    size_t totalRows() const { return static_cast<size_t>(nodes[root].total); }
+    // Görsel satırı içeren belge satırı; sub_row satırın içindeki görsel satırdır (sona kırpılır)
+    int lineAt(size_t row, int &sub_row) const;
+
+    size_t memoryUsage() const;
+
+private:
+    static const size_t BLOCK_LINES = 256;
+
+    struct Block
+    {
+        std::vector<uint32_t> rows; // bloktaki satırların görsel satır sayıları
+        uint64_t block_total;       // bloğun görsel satırları
+        uint64_t total;             // alt ağaçtaki görsel satırlar
+        size_t lines;               // alt ağaçtaki belge satırları
+        uint32_t left, right;       // 0: yok
+        uint32_t priority;
+    };
+
+    std::vector<Block> nodes; // nodes[0] boş düğüm
+    std::vector<uint32_t> free_nodes;
+    uint32_t root;
+    uint32_t seed;
+    int width;
+    size_t document_revision;
+
+    uint32_t allocate(const uint32_t *rows, size_t count);
+    void release(uint32_t node);
+    void pull(uint32_t node);
+    uint32_t merge(uint32_t left, uint32_t right);
+    // line'dan önce başlayan bloklar left'e gider
+    void split(uint32_t node, size_t line, uint32_t &left, uint32_t &right);
+    // Sayıları eşit boyda bloklara bölüp ağaç kurar
+    uint32_t build(const std::vector<uint32_t> &rows);
+    void flatten(uint32_t node, std::vector<uint32_t> &out) const;
+    // line'ı içeren bloğun ilk satırı
+    size_t blockStart(size_t line) const;
+    long long setRows(uint32_t node, size_t line, uint32_t rows);
+    void rebuild(const std::vector<uint32_t> &rows);
+};
+
+// Pencere boyutu ya da yazı tipi değişince tüm satırları anlık görüntü üzerinde arka planda yeniden ölçer.
+// Bitince on_done worker thread'inden çağrılır; UI thread'i sonucu takeRows ile alır.
+// Belge bu sırada değişirse sonuç eskidir, worker yeniden başlatılır. Yıkıcı ölçümü iptal edip thread'i bekler.
+class WrapWorker
+{
+public:
+    WrapWorker(TextDocument snapshot, int columns, std::function<void()> on_done);
+    ~WrapWorker();
+    WrapWorker(const WrapWorker &) = delete;
+    WrapWorker &operator=(const WrapWorker &) = delete;
+
+    bool finished() const { return done; }
+    int columns() const { return width; }
+    size_t revision() const { return document.revision(); }
+    int lineCount() const { return document.lineCount(); }
+    // Sadece finished() sonrası
+    std::vector<uint32_t> takeRows() { return std::move(rows); }
+
+private:
+    TextDocument document;
+    int width;
+    std::function<void()> on_done;
+    std::vector<uint32_t> rows;
+    std::atomic<bool> done;
+    std::atomic<bool> cancelled;
+    std::thread worker;
+
+    void run();
+};
@@ -0,0 +1,114 @@
+#pragma once
+
+// Benchmark'lar arasında paylaşılan yardımcılar
+#include "TextDocument.h"
+
+#include <chrono>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace bench
+{
+    enum EditKind
+    {
+        EDIT_SPLIT, // VK_RETURN
+        EDIT_JOIN,  // satır başında VK_BACK
+        EDIT_CHAR   // handleChar
+    };
+
+    struct Edit
+    {
+        EditKind kind;
+        unsigned row_seed;
+        unsigned col_seed;
+    };
+
+    inline std::vector<std::string> makeLines(int line_count)
+    {
+        std::vector<std::string> lines;
+        lines.reserve(line_count);
+        for (int i = 0; i < line_count; i++)
+            lines.push_back("    int value_" + std::to_string(i) + " = compute(" + std::to_string(i % 97) + "); // generated");
+        return lines;
+    }
+
+    inline std::string joinLines(const std::vector<std::string> &lines)
+    {
+        std::string text;
+        for (size_t i = 0; i < lines.size(); i++)
+        {
+            if (i > 0)
+                text += '\n';
+            text += lines[i];
+        }
+        return text;
+    }
+
+    inline std::vector<Edit> makeEdits(int edit_count, unsigned seed = 12345)
+    {
+        std::mt19937 rng(seed);
+        std::vector<Edit> edits;
+        edits.reserve(edit_count);
+        for (int i = 0; i < edit_count; i++)
+        {
+            unsigned r = rng() % 10;
+            EditKind kind = r < 4 ? EDIT_SPLIT : (r < 7 ? EDIT_JOIN : EDIT_CHAR);
+            edits.push_back({kind, static_cast<unsigned>(rng()), static_cast<unsigned>(rng())});
+        }
+        return edits;
+    }
+
+    // Eski EditorPane::lines davranışının birebir kopyası
+    inline void applyToVector(std::vector<std::string> &lines, const Edit &edit)
+    {
+        int row = static_cast<int>(edit.row_seed % lines.size());
+        int col = static_cast<int>(edit.col_seed % (lines[row].length() + 1));
+
+        switch (edit.kind)
+        {
+        case EDIT_SPLIT:
+        {
+            std::string current_line = lines[row];
+            lines[row] = current_line.substr(0, col);
+            lines.insert(lines.begin() + row + 1, current_line.substr(col));
+            break;
+        }
+        case EDIT_JOIN:
+            if (row > 0)
+            {
+                lines[row - 1] += lines[row];
+                lines.erase(lines.begin() + row);
+            }
+            break;
+        case EDIT_CHAR:
+            lines[row].insert(col, "x");
+            break;
+        }
+    }
+
+    inline void applyToDocument(TextDocument &document, const Edit &edit)
+    {
+        int row = static_cast<int>(edit.row_seed % document.lineCount());
+        int col = static_cast<int>(edit.col_seed % (document.lineLength(row) + 1));
+
+        switch (edit.kind)
+        {
+        case EDIT_SPLIT:
+            document.insertAt(row, col, "\n");
+            break;
+        case EDIT_JOIN:
+            if (row > 0)
+                document.eraseRange(row - 1, document.lineLength(row - 1), row, 0);
+            break;
+        case EDIT_CHAR:
+            document.insertAt(row, col, "x");
+            break;
+        }
+    }
+
+    inline double elapsedMs(std::chrono::steady_clock::time_point start)
+    {
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+}
@@ -0,0 +1,40 @@
+// TextDocument (piece table) ile eski vector<string> modelinin düzenleme maliyeti karşılaştırması
+// Kullanım: bench_document [satir_sayisi] [duzenleme_sayisi]
+#include "bench_common.h"
+
+#include <cstdio>
+#include <cstdlib>
+
+using namespace bench;
+
+int main(int argc, char **argv)
+{
+    int line_count = argc > 1 ? std::atoi(argv[1]) : 200000;
+    int edit_count = argc > 2 ? std::atoi(argv[2]) : 2000;
+
+    std::vector<std::string> lines = makeLines(line_count);
+    std::vector<Edit> edits = makeEdits(edit_count);
+    TextDocument document(joinLines(lines));
+
+    auto start = std::chrono::steady_clock::now();
+    for (const Edit &edit : edits)
+        applyToVector(lines, edit);
+    double vector_ms = elapsedMs(start);
+
+    start = std::chrono::steady_clock::now();
+    for (const Edit &edit : edits)
+        applyToDocument(document, edit);
+    double document_ms = elapsedMs(start);
+
+    // İki model aynı sonucu üretmeli
+    if (joinLines(lines) != document.getText())
+    {
+        std::printf("MISMATCH: vector and piece table diverged\n");
+        return 1;
+    }
+
+    std::printf("lines=%d edits=%d pieces=%zu\n", line_count, edit_count, document.pieceCount());
+    std::printf("vector<string> : %10.2f ms  (%8.2f us/edit)\n", vector_ms, vector_ms * 1000.0 / edit_count);
+    std::printf("TextDocument   : %10.2f ms  (%8.2f us/edit)\n", document_ms, document_ms * 1000.0 / edit_count);
+    return 0;
+}
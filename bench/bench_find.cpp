@@ -0,0 +1,91 @@
+// Dosyalarda arama benchmark'ı: 1 thread ile tüm çekirdekler karşılaştırması (dosya/s, GB/s, işlemci süresi)
+// Kullanım: bench_find [dizin] [sentetik_dosya_sayısı]
+// Dizin verilmezse geçici dizinde sentetik bir ağaç oluşturulur (her 100 dosyadan biri ikili).
+#include "FindInFiles.h"
+#include "bench_common.h"
+
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <filesystem>
+#include <fstream>
+#include <thread>
+
+using namespace bench;
+
+namespace
+{
+    std::string makeTree(int file_count)
+    {
+        std::filesystem::path root = std::filesystem::temp_directory_path() / "glitch_bench_find";
+        std::error_code error;
+        std::filesystem::remove_all(root, error);
+
+        std::vector<std::string> lines = makeLines(60);
+        std::string text = joinLines(lines);
+        for (int i = 0; i < file_count; i++)
+        {
+            std::filesystem::path dir = root / ("dir" + std::to_string(i / 200)) / ("sub" + std::to_string(i % 7));
+            std::filesystem::create_directories(dir, error);
+            std::ofstream file(dir / ("file" + std::to_string(i) + ".cpp"), std::ios::binary);
+            file << text;
+            if (i % 100 == 0)
+                file << '\0' << "binary payload";
+            if (i % 1000 == 999)
+                file << "\n// needle_marker here\n";
+        }
+        return root.string();
+    }
+
+    void runCase(const std::string &root, const char *pattern, bool regex, unsigned threads)
+    {
+        std::mutex mutex;
+        std::condition_variable done;
+        auto start = std::chrono::steady_clock::now();
+        std::clock_t cpu_start = std::clock(); // tüm thread'lerin işlemci süresi; boşta dönen worker'lar burada görünür
+        FindInFiles search(root, pattern, false, regex, [&]()
+                           { std::lock_guard<std::mutex> lock(mutex); done.notify_all(); }, threads);
+
+        std::vector<FileMatch> results;
+        while (!search.finished())
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            done.wait_for(lock, std::chrono::milliseconds(5));
+            lock.unlock();
+            search.takeResults(results);
+        }
+        search.takeResults(results);
+        double ms = elapsedMs(start);
+        double cpu_ms = 1000.0 * static_cast<double>(std::clock() - cpu_start) / CLOCKS_PER_SEC;
+
+        std::printf("  %-24s %2u threads %9.2f ms  %9.2f cpu ms  %9.0f files/s  %6.2f GB/s  %zu results, %zu binary skipped\n",
+                    pattern, threads, ms, cpu_ms, search.filesSearched() / (ms / 1000.0),
+                    (search.bytesSearched() / 1e9) / (ms / 1000.0), results.size(), search.binaryFiles());
+    }
+}
+
+int main(int argc, char **argv)
+{
+    std::string root = argc > 1 ? argv[1] : "";
+    bool synthetic = root.empty();
+    if (synthetic)
+        root = makeTree(argc > 2 ? std::atoi(argv[2]) : 20000);
+
+    unsigned cores = std::max(1u, std::thread::hardware_concurrency());
+    std::printf("tree: %s, %u cores\n", root.c_str(), cores);
+    for (unsigned threads : {1u, cores})
+    {
+        runCase(root, "needle_marker", false, threads);
+        runCase(root, "value_59 = compute\\(\\d+\\)", true, threads);
+        if (cores == 1)
+            break;
+    }
+
+    if (synthetic)
+    {
+        std::error_code error;
+        std::filesystem::remove_all(root, error);
+    }
+    return 0;
+}
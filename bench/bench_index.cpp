@@ -0,0 +1,131 @@
+// Trigram indeksi benchmark'ı: kurma süresi, diskten yükleme, indeksle eleyen arama ile tam tarama karşılaştırması
+// Kullanım: bench_index [dizin] [sentetik_dosya_sayısı]
+// Dizin verilmezse geçici dizinde sentetik bir ağaç oluşturulur; indeks dosyası sonunda silinir.
+#include "FindInFiles.h"
+#include "TrigramIndex.h"
+#include "bench_common.h"
+
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <thread>
+
+using namespace bench;
+
+namespace
+{
+    std::string makeTree(int file_count)
+    {
+        std::filesystem::path root = std::filesystem::temp_directory_path() / "glitch_bench_index";
+        std::error_code error;
+        std::filesystem::remove_all(root, error);
+
+        std::vector<std::string> lines = makeLines(60);
+        for (int i = 0; i < file_count; i++)
+        {
+            std::filesystem::path dir = root / ("dir" + std::to_string(i / 200)) / ("sub" + std::to_string(i % 7));
+            std::filesystem::create_directories(dir, error);
+            std::ofstream file(dir / ("file" + std::to_string(i) + ".cpp"), std::ios::binary);
+            // Dosyalar farklı sayılar içersin ki trigram kümeleri ayrışsın
+            for (size_t k = 0; k < lines.size(); k++)
+                file << lines[k] << " id_" << (i * 61 + k) % 100003 << "\n";
+            if (i % 1000 == 999)
+                file << "// needle_marker here\n";
+        }
+        return root.string();
+    }
+
+    size_t runSearch(FindInFiles &search, double &ms, std::chrono::steady_clock::time_point start)
+    {
+        std::vector<FileMatch> results;
+        while (!search.finished())
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            search.takeResults(results);
+        }
+        search.takeResults(results);
+        ms = elapsedMs(start);
+        return results.size();
+    }
+
+    void runCase(TrigramIndex &index, const char *pattern, bool regex)
+    {
+        double full_ms = 0, indexed_ms = 0;
+        auto start = std::chrono::steady_clock::now();
+        FindInFiles full(index.root(), pattern, false, regex, nullptr);
+        size_t full_results = runSearch(full, full_ms, start);
+
+        start = std::chrono::steady_clock::now();
+        auto excluded = std::make_shared<TrigramIndex::Exclusions>();
+        bool narrowed = index.exclusions(pattern, regex, *excluded);
+        double lookup_ms = elapsedMs(start);
+        size_t indexed_results = full_results;
+        size_t skipped = 0;
+        if (narrowed)
+        {
+            FindInFiles indexed(index.root(), pattern, false, regex, [excluded](const std::filesystem::directory_entry &entry)
+                                { return excluded->skip(entry); },
+                                nullptr);
+            indexed_results = runSearch(indexed, indexed_ms, start);
+            skipped = indexed.skippedFiles();
+        }
+
+        if (narrowed)
+            std::printf("  %-28s full %9.2f ms  indexed %8.2f ms (lookup %.2f ms, %zu of %zu files ruled out)  %zu/%zu results\n",
+                        pattern, full_ms, indexed_ms, lookup_ms, skipped, index.fileCount(), indexed_results, full_results);
+        else
+            std::printf("  %-28s full %9.2f ms  (no required trigram, index not used)  %zu results\n", pattern, full_ms,
+                        full_results);
+    }
+}
+
+int main(int argc, char **argv)
+{
+    std::string root = argc > 1 ? argv[1] : "";
+    bool synthetic = root.empty();
+    if (synthetic)
+        root = makeTree(argc > 2 ? std::atoi(argv[2]) : 20000);
+
+    std::string path;
+    {
+        TrigramIndex index(root);
+        path = TrigramIndex::indexPath(index.root());
+        std::remove(path.c_str());
+
+        std::mutex mutex;
+        std::condition_variable done;
+        bool finished = false;
+        auto start = std::chrono::steady_clock::now();
+        index.startRefresh([&]()
+                           { std::lock_guard<std::mutex> lock(mutex); finished = true; done.notify_all(); });
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            done.wait(lock, [&]()
+                      { return finished; });
+        }
+        double build_ms = elapsedMs(start);
+        std::error_code error;
+        std::printf("tree: %s\nbuild: %.2f ms, %zu files, %.2f MB postings, %.2f MB on disk\n", root.c_str(), build_ms,
+                    index.fileCount(), index.postingBytes() / 1e6, std::filesystem::file_size(path, error) / 1e6);
+    }
+
+    TrigramIndex index(root);
+    auto start = std::chrono::steady_clock::now();
+    bool loaded = index.load();
+    std::printf("load: %.2f ms (%s)\n", elapsedMs(start), loaded ? "ok" : "failed");
+
+    runCase(index, "needle_marker", false);
+    runCase(index, "id_87654", false);
+    runCase(index, "value_59 = compute\\(\\d+\\)", true);
+    runCase(index, "[a-z]+_\\d", true);
+
+    std::remove(path.c_str());
+    if (synthetic)
+    {
+        std::error_code error;
+        std::filesystem::remove_all(root, error);
+    }
+    return 0;
+}
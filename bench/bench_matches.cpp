@@ -0,0 +1,144 @@
+// Eşleşme listesi benchmark'ı: her düzenlemeden sonra tüm belgeyi yeniden taramak ile
+// listeyi düzenlemeyle birlikte güncellemek (kaydırma + düzenlenen bölgeyi tarama) karşılaştırması,
+// ve arka plan taraması sürerken yapılan düzenlemelerin tarama sonuçlarına işlenmesi
+// Kullanım: bench_matches [satır_sayısı] [düzenleme_sayısı]
+#include "MatchList.h"
+#include "bench_common.h"
+
+#include <cstdio>
+#include <cstdlib>
+
+using namespace bench;
+
+namespace
+{
+    void runCase(const std::string &text, const char *pattern, bool regex, int edit_count)
+    {
+        TextDocument document;
+        document.setText(text);
+        SearchQuery query(pattern, false, regex);
+
+        // Tam tarama: düzenleme başına eski davranış
+        std::vector<SearchMatch> all;
+        auto start = std::chrono::steady_clock::now();
+        query.findAll(document, 0, document.length(), all);
+        double full_ms = elapsedMs(start);
+
+        MatchList list;
+        start = std::chrono::steady_clock::now();
+        list.replace(0, document.length(), all);
+        double build_ms = elapsedMs(start);
+
+        // Rastgele yerlerde yazma ve silme; her düzenlemeden sonra liste güncellenir
+        std::mt19937 rng(7);
+        std::vector<TextChange> changes(1);
+        start = std::chrono::steady_clock::now();
+        for (int i = 0; i < edit_count; i++)
+        {
+            size_t offset = rng() % document.length();
+            if (i % 3 == 2)
+            {
+                document.erase(offset, 1);
+                changes[0] = TextChange{offset, 1, 0};
+            }
+            else
+            {
+                document.insert(offset, i % 2 ? "compute(" : "x");
+                changes[0] = TextChange{offset, 0, i % 2 ? 8u : 1u};
+            }
+            list.update(document, query, changes);
+        }
+        double update_ms = elapsedMs(start);
+
+        // Doğrulama: son hali tam taramayla aynı olmalı
+        std::vector<SearchMatch> expected, actual;
+        query.findAll(document, 0, document.length(), expected);
+        list.collect(0, document.length(), actual);
+        bool same = expected.size() == actual.size();
+        for (size_t i = 0; same && i < expected.size(); i++)
+            same = expected[i].start == actual[i].start && expected[i].end == actual[i].end;
+
+        std::printf("  %-24s %8zu matches  full rescan %8.2f ms  build %6.2f ms  update %8.4f ms/edit  %s\n", pattern,
+                    list.size(), full_ms, build_ms, update_ms / edit_count, same ? "ok" : "MISMATCH");
+    }
+
+    // Tarama anlık görüntü üzerinde parça parça ilerler, parçalar arasında belge düzenlenir (taramayı
+    // baştan başlatmak yerine düzenlemeler EditMap ile parçalara işlenir)
+    void runScanCase(const std::string &text, const char *pattern, bool regex, int edit_count)
+    {
+        TextDocument document;
+        document.setText(text);
+        TextDocument snapshot = document.snapshot();
+        SearchQuery query(pattern, false, regex);
+        SearchQuery scan_query(pattern, false, regex);
+
+        MatchList list;
+        EditMap edits;
+        std::mt19937 rng(11);
+        std::vector<TextChange> changes(1);
+        const size_t slice = 256 * 1024;
+        size_t length = snapshot.length();
+        int edits_per_slice = std::max<int>(1, static_cast<int>(edit_count / (length / slice + 1)));
+        size_t scanned = 0;
+        int edited = 0;
+        double merge_ms = 0;
+        std::vector<SearchMatch> batch;
+        while (scanned < length)
+        {
+            batch.clear();
+            size_t next = scan_query.findAll(snapshot, scanned, length, batch, slice);
+            auto start = std::chrono::steady_clock::now();
+            list.merge(document, query, scanned, next, batch, edits);
+            merge_ms += elapsedMs(start);
+            scanned = next;
+
+            for (int i = 0; i < edits_per_slice && scanned < length; i++, edited++)
+            {
+                size_t offset = rng() % document.length();
+                if (edited % 3 == 2)
+                {
+                    document.erase(offset, 1);
+                    changes[0] = TextChange{offset, 1, 0};
+                }
+                else
+                {
+                    document.insert(offset, edited % 2 ? "compute(" : "x");
+                    changes[0] = TextChange{offset, 0, edited % 2 ? 8u : 1u};
+                }
+                list.update(document, query, changes);
+                edits.add(changes[0]);
+            }
+        }
+
+        std::vector<SearchMatch> expected, actual;
+        query.findAll(document, 0, document.length(), expected);
+        list.collect(0, document.length(), actual);
+        bool same = expected.size() == actual.size();
+        for (size_t i = 0; same && i < expected.size(); i++)
+            same = expected[i].start == actual[i].start && expected[i].end == actual[i].end;
+
+        std::printf("  %-24s %8zu matches  %5d edits during scan  merge %8.2f ms total  %s\n", pattern, list.size(),
+                    edited, merge_ms, same ? "ok" : "MISMATCH");
+    }
+}
+
+int main(int argc, char **argv)
+{
+    int line_count = argc > 1 ? std::atoi(argv[1]) : 1000000;
+    int edit_count = argc > 2 ? std::atoi(argv[2]) : 10000;
+
+    std::string text = joinLines(makeLines(line_count));
+    std::printf("%d lines, %.2f MB, %d edits\n", line_count, text.size() / 1e6, edit_count);
+
+    runCase(text, "compute(", false, edit_count);
+    runCase(text, "value_1", false, edit_count);
+    runCase(text, "compute\\(\\d+\\)", true, edit_count);
+    runCase(text, "\\bvalue_\\d*7\\b", true, edit_count);
+
+    std::printf("edits during a background scan\n");
+    runScanCase(text, "compute(", false, edit_count);
+    runScanCase(text, "value_1", false, edit_count);
+    runScanCase(text, "compute\\(\\d+\\)", true, edit_count);
+    runScanCase(text, "\\bvalue_\\d*7\\b", true, edit_count);
+    return 0;
+}
@@ -0,0 +1,85 @@
+// Hızlı dosya açma benchmark'ı: sentetik yol listesinde yazdıkça (harf harf) bulanık sorgu süresi
+// Kullanım: bench_quickopen [yol_sayısı] [dizin]
+// Dizin verilirse yollar oradan taranır, yoksa kaynak ağacına benzeyen sentetik yollar üretilir.
+#include "PathIndex.h"
+#include "bench_common.h"
+
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+
+using namespace bench;
+
+namespace
+{
+    std::vector<std::string> makePaths(int count)
+    {
+        const char *dirs[] = {"src", "include", "lib", "test", "tools", "third_party", "docs", "build", "platform",
+                              "core", "ui", "net", "render", "storage", "util"};
+        const char *words[] = {"buffer", "window", "Text", "Editor", "search", "Index", "file", "view", "render",
+                               "cache", "Layout", "input", "parser", "token", "stream", "thread", "pool", "config"};
+        const char *exts[] = {".cpp", ".h", ".c", ".py", ".js", ".md", ".txt", ".json"};
+
+        std::mt19937 rng(42);
+        std::vector<std::string> paths;
+        paths.reserve(count);
+        for (int i = 0; i < count; i++)
+        {
+            std::string path;
+            int depth = 1 + static_cast<int>(rng() % 5);
+            for (int d = 0; d < depth; d++)
+                path += std::string(dirs[rng() % 15]) + (rng() % 3 == 0 ? std::to_string(rng() % 50) : "") + "/";
+            path += words[rng() % 18];
+            path += words[rng() % 18];
+            path += std::to_string(i);
+            path += exts[rng() % 8];
+            paths.push_back(path);
+        }
+        return paths;
+    }
+
+    void typeQuery(PathIndex &index, const std::string &query)
+    {
+        // Her tuşta yeni sorgu, bir öncekinin uzantısı
+        std::printf("  \"%s\"\n", query.c_str());
+        for (size_t i = 1; i <= query.size(); i++)
+        {
+            std::vector<PathMatch> results;
+            auto start = std::chrono::steady_clock::now();
+            size_t total = index.query(query.substr(0, i), 50, results);
+            double ms = elapsedMs(start);
+            std::printf("    %-24s %8.3f ms  %8zu matches  best: %s\n", query.substr(0, i).c_str(), ms, total,
+                        results.empty() ? "-" : results[0].path.c_str());
+        }
+    }
+}
+
+int main(int argc, char **argv)
+{
+    int count = argc > 1 ? std::atoi(argv[1]) : 500000;
+    PathIndex index(argc > 2 ? argv[2] : ".");
+
+    auto start = std::chrono::steady_clock::now();
+    if (argc > 2)
+    {
+        std::mutex mutex;
+        std::condition_variable done;
+        bool finished = false;
+        index.startRefresh([&]()
+                           { std::lock_guard<std::mutex> lock(mutex); finished = true; done.notify_all(); });
+        std::unique_lock<std::mutex> lock(mutex);
+        done.wait(lock, [&]()
+                  { return finished; });
+    }
+    else
+    {
+        index.assign(makePaths(count));
+    }
+    std::printf("%zu paths indexed in %.2f ms\n", index.size(), elapsedMs(start));
+
+    typeQuery(index, "texteditor.cpp");
+    typeQuery(index, "srcrendercache");
+    typeQuery(index, "zzq");
+    return 0;
+}
@@ -0,0 +1,71 @@
+// Düzenli ifade benchmark'ı: satır satır std::regex_search ile lazy DFA (Regex) karşılaştırması
+// Kullanım: bench_regex [satır_sayısı]
+#include "Regex.h"
+#include "bench_common.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <regex>
+
+using namespace bench;
+
+namespace
+{
+    bool stdRegex(const TextDocument &document, const std::string &pattern, size_t &start, size_t &end)
+    {
+        std::regex expression(pattern, std::regex::ECMAScript | std::regex::optimize);
+        std::string line;
+        for (int row = 0; row < document.lineCount(); row++)
+        {
+            document.getLine(row, line);
+            std::smatch match;
+            if (std::regex_search(line, match, expression))
+            {
+                start = document.lineStart(row) + match.position(0);
+                end = start + match.length(0);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool runCase(const TextDocument &document, const char *title, const std::string &pattern)
+    {
+        size_t old_start = 0, old_end = 0;
+        auto start = std::chrono::steady_clock::now();
+        bool old_found = stdRegex(document, pattern, old_start, old_end);
+        double old_ms = elapsedMs(start);
+
+        size_t new_start = 0, new_end = 0;
+        start = std::chrono::steady_clock::now();
+        Regex regex(pattern);
+        bool new_found = regex.find(document, 0, document.length(), new_start, new_end);
+        double new_ms = elapsedMs(start);
+
+        bool ok = regex.valid() && old_found == new_found && (!old_found || (old_start == new_start && old_end == new_end));
+        std::printf("  %-30s std::regex %9.2f ms  lazy DFA %8.2f ms (%6.2f GB/s, %zu states, %zu resets)  %s\n", title,
+                    old_ms, new_ms, new_ms > 0 ? (document.length() / 1e9) / (new_ms / 1000.0) : 0.0, regex.dfaStates(),
+                    regex.cacheResets(), ok ? (new_found ? "hit" : "miss") : "MISMATCH");
+        return ok;
+    }
+}
+
+int main(int argc, char **argv)
+{
+    int line_count = argc > 1 ? std::atoi(argv[1]) : 300000;
+
+    TextDocument document(joinLines(makeLines(line_count)));
+    for (const Edit &edit : makeEdits(line_count / 100))
+        applyToDocument(document, edit);
+
+    std::printf("document: %.1f MB, %d lines, %zu pieces\n", document.length() / (1024.0 * 1024.0),
+                document.lineCount(), document.pieceCount());
+
+    bool ok = runCase(document, "literal miss", "no_such_symbol");
+    ok = runCase(document, "class + repeat miss", "value_[0-9]+ = compute\\(98\\)") && ok;
+    ok = runCase(document, "alternation miss", "(foo|bar|baz|qux)_[a-z]+\\(") && ok;
+    ok = runCase(document, "anchored last line", "^    int value_" + std::to_string(line_count - 1) + " ") && ok;
+    ok = runCase(document, "word boundary miss", "\\bcompute\\b\\s*\\(\\s*-") && ok;
+    ok = runCase(document, "many DFA states", "[a-z](.){12}x") && ok;
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,243 @@
+// Çizim benchmark'ı: panel metin alanının headless framebuffer'a çizim süresi
+// (tam kare, arama vurgulu kare, tek satırlık kısmi çizim, her karede bir satır kaydırma, vurgularda imleç gezinmesi)
+// yumuşak kaydırmada her karede tam çizim ile pikselleri kaydırıp sadece açılan şeridi çizme
+// 50 MB'lık tek satırda yatay kaydırma ve düzenleme, 4K pencerede 8-24 punto yazı tipi boyutlarında tam kare süreleri
+// Kullanım: bench_render [satır_sayısı] [kare_sayısı] [--budget ms]
+// --budget verilirse kare başına süre bu değeri aşan durumda 1 ile çıkar (CI'da kare süresi gerilemesi için)
+#include "HeadlessRenderer.h"
+#include "TextView.h"
+#include "bench_common.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+using namespace bench;
+
+namespace
+{
+    // 1080p pencere, 9x18 piksel hücre (16 punto sabit genişlikli yazı tipine yakın)
+    const int FRAME_WIDTH = 1920;
+    const int FRAME_HEIGHT = 1080;
+    const int CHAR_WIDTH = 9;
+    const int CHAR_HEIGHT = 18;
+
+    enum RenderCase
+    {
+        CASE_FULL,
+        CASE_HIGHLIGHT,
+        CASE_LINE,
+        CASE_SCROLL,
+        CASE_CURSOR
+    };
+
+    double runCase(const char *name, RenderCase kind, const TextDocument &document, const MatchList &matches,
+                   int frame_count)
+    {
+        HeadlessRenderer renderer(FRAME_WIDTH, FRAME_HEIGHT, CHAR_WIDTH, CHAR_HEIGHT);
+        TextView view = {RenderRect{0, 0, FRAME_WIDTH, FRAME_HEIGHT}, 0, 0, 0, 0, 10, 12, true, false,
+                         kind == CASE_HIGHLIGHT || kind == CASE_CURSOR ? &matches : nullptr, CHAR_WIDTH, CHAR_HEIGHT, nullptr};
+        RenderRect area = view.rect;
+        if (kind == CASE_LINE)
+        {
+            // İmleç satırı: düzenlemeden sonraki kısmi çizim
+            int line_y = 30 + (view.cursor_row - view.scroll_top) * (CHAR_HEIGHT + 2);
+            area = RenderRect{0, line_y, FRAME_WIDTH, line_y + CHAR_HEIGHT + 2};
+        }
+        renderer.setClip(area);
+
+        int lines = 0;
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < frame_count; i++)
+        {
+            if (kind == CASE_SCROLL)
+                view.scroll_top = i % (document.lineCount() - 1);
+            if (kind == CASE_CURSOR)
+            {
+                // Vurgular açıkken imleç satırlar ve eşleşmeler arasında gezer
+                view.cursor_row = i % 50;
+                view.cursor_col = i % 40;
+            }
+            lines += drawTextView(renderer, document, view, area);
+        }
+        double ms = elapsedMs(start) / frame_count;
+
+        std::printf("  %-18s %9.4f ms/frame  %5d lines/frame  %10llu pixels/frame  checksum %016llx\n",
+                    name, ms, lines / frame_count, renderer.pixelsWritten() / frame_count,
+                    static_cast<unsigned long long>(renderer.checksum()));
+        return ms;
+    }
+
+    // Tekerlek kaydırması gibi her karede SMOOTH_STEP piksel; blit=true ise mevcut pikseller kaydırılır ve
+    // sadece açılan şerit çizilir. Son kare tam çizimle karşılaştırılır
+    double runSmoothScroll(const char *name, bool blit, const TextDocument &document, int frame_count)
+    {
+        const int SMOOTH_STEP = 7;
+        int line_height = CHAR_HEIGHT + 2;
+        HeadlessRenderer renderer(FRAME_WIDTH, FRAME_HEIGHT, CHAR_WIDTH, CHAR_HEIGHT);
+        TextView view = {RenderRect{0, 0, FRAME_WIDTH, FRAME_HEIGHT}, 0, 0, 0, 0, 10, 12, false, false, nullptr,
+                         CHAR_WIDTH, CHAR_HEIGHT, nullptr};
+        RenderRect viewport = textViewport(view.rect, CHAR_HEIGHT);
+        drawTextView(renderer, document, view, view.rect);
+        renderer.resetCounters();
+
+        int lines = 0;
+        long long position = 0;
+        long long max_position = static_cast<long long>(document.lineCount() - 60) * line_height;
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < frame_count; i++)
+        {
+            position = (position + SMOOTH_STEP) % max_position;
+            int previous = view.scroll_top * line_height + view.scroll_pixel;
+            view.scroll_top = static_cast<int>(position / line_height);
+            view.scroll_pixel = static_cast<int>(position % line_height);
+            int dy = previous - static_cast<int>(position);
+
+            RenderRect area = view.rect;
+            if (blit && dy < 0 && -dy < viewport.bottom - viewport.top)
+            {
+                renderer.scroll(viewport, dy);
+                area = RenderRect{viewport.left, viewport.bottom + dy, viewport.right, viewport.bottom};
+            }
+            renderer.setClip(area);
+            lines += drawTextView(renderer, document, view, area);
+        }
+        double ms = elapsedMs(start) / frame_count;
+
+        HeadlessRenderer expected(FRAME_WIDTH, FRAME_HEIGHT, CHAR_WIDTH, CHAR_HEIGHT);
+        drawTextView(expected, document, view, view.rect);
+        std::printf("  %-18s %9.4f ms/frame  %5d lines/frame  %10llu pixels/frame  %s\n", name, ms,
+                    lines / frame_count, renderer.pixelsWritten() / frame_count,
+                    expected.checksum() == renderer.checksum() ? "ok" : "MISMATCH");
+        return ms;
+    }
+
+    // Tek satırlık küçültülmüş JSON (byte_count byte): her karede başka bir sütuna yatay kaydırma ve imleçte
+    // bir karakter ekleme. Süre satırın uzunluğuna değil görünür sütunlara bağlı olmalı; son kare, görünür
+    // kısmından oluşan kısa bir belgenin çizimiyle karşılaştırılır
+    double runLongLine(size_t byte_count, int frame_count)
+    {
+        std::string text;
+        text.reserve(byte_count + 64);
+        text += '[';
+        for (int i = 0; text.size() < byte_count; i++)
+            text += "{\"id\":" + std::to_string(i) + ",\"value_" + std::to_string(i % 97) + "\":true},";
+        text.back() = ']';
+        TextDocument document;
+        document.setText(text);
+
+        SearchQuery query("value_1", false, false);
+        std::vector<SearchMatch> found;
+        query.findAll(document, 0, document.length(), found);
+        MatchList matches;
+        matches.replace(0, document.length(), found);
+
+        HeadlessRenderer renderer(FRAME_WIDTH, FRAME_HEIGHT, CHAR_WIDTH, CHAR_HEIGHT);
+        TextView view = {RenderRect{0, 0, FRAME_WIDTH, FRAME_HEIGHT}, 0, 0, 0, 0, 0, 0, true, false, &matches,
+                         CHAR_WIDTH, CHAR_HEIGHT, nullptr};
+        std::mt19937 rng(11);
+        int columns = (FRAME_WIDTH - 50) / CHAR_WIDTH;
+
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < frame_count; i++)
+        {
+            int length = document.lineLength(0);
+            view.scroll_left = static_cast<int>(rng() % static_cast<unsigned>(length - columns));
+            view.cursor_col = view.scroll_left + columns / 2;
+            size_t offset = static_cast<size_t>(view.cursor_col);
+            document.insert(offset, "x");
+            std::vector<TextChange> changes{{offset, 0, 1}};
+            matches.update(document, query, changes);
+            drawTextView(renderer, document, view, view.rect);
+        }
+        double ms = elapsedMs(start) / frame_count;
+
+        // Aynı görünür metin kısa bir satır olarak (vurgusuz)
+        view.matches = nullptr;
+        view.show_cursor = false;
+        renderer.setClip(view.rect);
+        drawTextView(renderer, document, view, view.rect);
+        TextDocument visible;
+        visible.setText(document.getText(static_cast<size_t>(view.scroll_left), static_cast<size_t>(columns + 1)));
+        TextView short_view = view;
+        short_view.scroll_left = 0;
+        HeadlessRenderer expected(FRAME_WIDTH, FRAME_HEIGHT, CHAR_WIDTH, CHAR_HEIGHT);
+        drawTextView(expected, visible, short_view, short_view.rect);
+
+        std::printf("  %-18s %9.4f ms/frame  %.1f MB line, edit + horizontal scroll per frame  %s\n", "long line", ms,
+                    document.length() / 1e6, expected.checksum() == renderer.checksum() ? "ok" : "MISMATCH");
+        return ms;
+    }
+
+    // 4K pencerede her karede bir satır kaydırılan tam kare
+    double runFontSize(int font_size, const TextDocument &document, const MatchList &matches, int frame_count)
+    {
+        // Sabit genişlikli yazı tiplerinde hücre yaklaşık 0.6 x 1.25 punto
+        int char_width = (font_size * 6 + 5) / 10;
+        int char_height = (font_size * 5 + 2) / 4;
+        HeadlessRenderer renderer(3840, 2160, char_width, char_height);
+        TextView view = {RenderRect{0, 0, 3840, 2160}, 0, 0, 0, 0, 10, 12, true, false, &matches, char_width,
+                         char_height, nullptr};
+
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < frame_count; i++)
+        {
+            view.scroll_top = i % (document.lineCount() - 1);
+            drawTextView(renderer, document, view, view.rect);
+        }
+        return elapsedMs(start) / frame_count;
+    }
+}
+
+int main(int argc, char **argv)
+{
+    int line_count = 100000;
+    int frame_count = 200;
+    double budget = 0;
+    int position = 0;
+    for (int i = 1; i < argc; i++)
+    {
+        if (std::strcmp(argv[i], "--budget") == 0 && i + 1 < argc)
+            budget = std::atof(argv[++i]);
+        else if (position++ == 0)
+            line_count = std::atoi(argv[i]);
+        else
+            frame_count = std::atoi(argv[i]);
+    }
+
+    TextDocument document;
+    document.setText(joinLines(makeLines(line_count)));
+    SearchQuery query("value_", false, false);
+    std::vector<SearchMatch> found;
+    query.findAll(document, 0, document.length(), found);
+    MatchList matches;
+    matches.replace(0, document.length(), found);
+
+    std::printf("%dx%d, %dx%d cells, %d lines, %d frames\n", FRAME_WIDTH, FRAME_HEIGHT, CHAR_WIDTH, CHAR_HEIGHT,
+                line_count, frame_count);
+
+    double worst = 0;
+    worst = std::max(worst, runCase("full frame", CASE_FULL, document, matches, frame_count));
+    worst = std::max(worst, runCase("highlighted frame", CASE_HIGHLIGHT, document, matches, frame_count));
+    worst = std::max(worst, runCase("cursor line", CASE_LINE, document, matches, frame_count));
+    worst = std::max(worst, runCase("scroll", CASE_SCROLL, document, matches, frame_count));
+    worst = std::max(worst, runCase("cursor moves", CASE_CURSOR, document, matches, frame_count));
+    worst = std::max(worst, runSmoothScroll("smooth redraw", false, document, frame_count));
+    worst = std::max(worst, runSmoothScroll("smooth blit", true, document, frame_count));
+    worst = std::max(worst, runLongLine(50 * 1000 * 1000, frame_count));
+
+    std::printf("3840x2160 highlighted scrolling frames by font size\n");
+    for (int size = 8; size <= 24; size += 2)
+    {
+        double ms = runFontSize(size, document, matches, frame_count);
+        std::printf("  %2d pt  %8.4f ms/frame\n", size, ms);
+        worst = std::max(worst, ms);
+    }
+
+    if (budget > 0 && worst > budget)
+    {
+        std::printf("frame budget exceeded: %.4f ms > %.4f ms\n", worst, budget);
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,100 @@
+// Rope (B-tree piece ağacı) micro-benchmark'ı: 1M satırlık girdide rastgele düzenleme,
+// satır -> offset / offset -> satır dönüşümleri ve undo snapshot kopyalama maliyeti
+// Kullanım: bench_rope [satir_sayisi] [duzenleme_sayisi] [arama_sayisi]
+#include "bench_common.h"
+
+#include <cstdio>
+#include <cstdlib>
+
+using namespace bench;
+
+int main(int argc, char **argv)
+{
+    int line_count = argc > 1 ? std::atoi(argv[1]) : 1000000;
+    int edit_count = argc > 2 ? std::atoi(argv[2]) : 1000;
+    int lookup_count = argc > 3 ? std::atoi(argv[3]) : 200000;
+
+    std::vector<std::string> lines = makeLines(line_count);
+    std::vector<Edit> edits = makeEdits(edit_count);
+    TextDocument document(joinLines(lines));
+
+    // Rastgele düzenlemeler
+    auto start = std::chrono::steady_clock::now();
+    for (const Edit &edit : edits)
+        applyToVector(lines, edit);
+    double vector_edit_ms = elapsedMs(start);
+
+    start = std::chrono::steady_clock::now();
+    for (const Edit &edit : edits)
+        applyToDocument(document, edit);
+    double rope_edit_ms = elapsedMs(start);
+
+    if (joinLines(lines) != document.getText())
+    {
+        std::printf("MISMATCH: vector and rope diverged\n");
+        return 1;
+    }
+
+    // Satır -> offset ve offset -> satır ("goto N", PageUp/PageDown, mouse click)
+    std::mt19937 rng(777);
+    size_t checksum = 0;
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < lookup_count; i++)
+    {
+        int row = static_cast<int>(rng() % document.lineCount());
+        checksum += document.lineStart(row) + document.lineLength(row);
+    }
+    double line_to_offset_ms = elapsedMs(start);
+
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < lookup_count; i++)
+    {
+        int row = 0;
+        int col = 0;
+        document.positionAt(rng() % (document.length() + 1), row, col);
+        checksum += row + col;
+    }
+    double offset_to_line_ms = elapsedMs(start);
+
+    // Eski saveUndoState tüm satırları kopyalıyordu; rope kopyası node'ları paylaşır
+    const int snapshot_count = 20;
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < snapshot_count; i++)
+    {
+        std::vector<std::string> copy = lines;
+        checksum += copy.size();
+    }
+    double vector_copy_ms = elapsedMs(start);
+
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < snapshot_count; i++)
+    {
+        TextDocument copy = document;
+        copy.insertAt(i, 0, "x");
+        checksum += copy.lineCount();
+    }
+    double rope_copy_ms = elapsedMs(start);
+
+    // Arama ve kaydırma thread'lerine verilen anlık görüntü + bir tuş vuruşu, append buffer'ı büyük bir
+    // ekleme (:%s sonucu gibi) doldurduktan sonra
+    document.insert(document.length(), joinLines(lines));
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < snapshot_count; i++)
+    {
+        TextDocument view = document.snapshot();
+        document.insertAt(i, 0, "x");
+        checksum += view.length();
+    }
+    double thread_snapshot_ms = elapsedMs(start);
+
+    std::printf("lines=%d edits=%d pieces=%zu depth=%d checksum=%zu\n",
+                line_count, edit_count, document.pieceCount(), document.treeDepth(), checksum);
+    std::printf("random edits   vector<string> : %10.2f ms  (%8.2f us/edit)\n", vector_edit_ms, vector_edit_ms * 1000.0 / edit_count);
+    std::printf("random edits   Rope           : %10.2f ms  (%8.2f us/edit)\n", rope_edit_ms, rope_edit_ms * 1000.0 / edit_count);
+    std::printf("line -> offset Rope           : %10.2f ms  (%8.3f us/lookup)\n", line_to_offset_ms, line_to_offset_ms * 1000.0 / lookup_count);
+    std::printf("offset -> line Rope           : %10.2f ms  (%8.3f us/lookup)\n", offset_to_line_ms, offset_to_line_ms * 1000.0 / lookup_count);
+    std::printf("snapshot+edit  vector<string> : %10.2f ms  (%8.2f ms/copy)\n", vector_copy_ms, vector_copy_ms / snapshot_count);
+    std::printf("snapshot+edit  Rope           : %10.2f ms  (%8.4f ms/copy)\n", rope_copy_ms, rope_copy_ms / snapshot_count);
+    std::printf("thread snapshot after paste   : %10.2f ms  (%8.4f ms/copy)\n", thread_snapshot_ms, thread_snapshot_ms / snapshot_count);
+    return 0;
+}
@@ -0,0 +1,155 @@
+// Satır sonu tarayıcısı benchmark'ı: scalar / SSE2 / AVX2 ve paralel indeksleyici için GB/s
+// Kullanım: bench_scan [kaynak_dizini] [sentetik_MB]
+// Dizin verilirse altındaki tüm dosyalar birleştirilip gerçek kaynak ağacı olarak taranır.
+#include "LineScanner.h"
+#include "bench_common.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <thread>
+
+using namespace bench;
+
+namespace
+{
+    std::string makeSynthetic(size_t megabytes, bool crlf)
+    {
+        std::string text;
+        text.reserve(megabytes * 1024 * 1024 + 256);
+        std::mt19937 rng(42);
+        while (text.size() < megabytes * 1024 * 1024)
+        {
+            // 0-120 karakterlik değişken uzunlukta satırlar
+            size_t length = rng() % 120;
+            for (size_t i = 0; i < length; i++)
+                text += static_cast<char>(' ' + rng() % 94);
+            text += crlf ? "\r\n" : "\n";
+        }
+        return text;
+    }
+
+    std::string loadTree(const std::string &root, size_t limit)
+    {
+        std::string text;
+        std::error_code error;
+        for (auto it = std::filesystem::recursive_directory_iterator(root, std::filesystem::directory_options::skip_permission_denied, error);
+             it != std::filesystem::recursive_directory_iterator() && text.size() < limit; it.increment(error))
+        {
+            if (error || !it->is_regular_file(error))
+                continue;
+            std::ifstream file(it->path(), std::ios::binary);
+            text.append(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+        }
+        return text;
+    }
+
+    double gbPerSecond(size_t bytes, double ms)
+    {
+        return ms > 0 ? (bytes / 1e9) / (ms / 1000.0) : 0.0;
+    }
+
+    void report(const char *name, size_t bytes, double ms, size_t newlines)
+    {
+        std::printf("  %-22s %8.2f ms  %7.2f GB/s  newlines=%zu\n", name, ms, gbPerSecond(bytes, ms), newlines);
+    }
+
+    bool runSuite(const char *title, const std::string &text)
+    {
+        const int repeats = 3;
+        std::printf("%s: %.1f MB\n", title, text.size() / (1024.0 * 1024.0));
+
+        // Referanslar da konum listesi üretir (tarayıcılarla aynı iş)
+        std::vector<uint32_t> reference;
+        auto start = std::chrono::steady_clock::now();
+        for (int r = 0; r < repeats; r++)
+        {
+            reference.clear();
+            for (size_t i = 0; i < text.size(); i++)
+            {
+                if (text[i] == '\n')
+                    reference.push_back(static_cast<uint32_t>(i));
+            }
+        }
+        size_t expected = reference.size();
+        report("byte loop", text.size(), elapsedMs(start) / repeats, expected);
+
+        start = std::chrono::steady_clock::now();
+        for (int r = 0; r < repeats; r++)
+        {
+            reference.clear();
+            const char *pos = text.data();
+            const char *end = pos + text.size();
+            while ((pos = static_cast<const char *>(std::memchr(pos, '\n', end - pos))) != nullptr)
+            {
+                reference.push_back(static_cast<uint32_t>(pos - text.data()));
+                pos++;
+            }
+        }
+        report("memchr", text.size(), elapsedMs(start) / repeats, reference.size());
+
+        bool ok = reference.size() == expected;
+        const ScannerKind kinds[] = {SCANNER_SCALAR, SCANNER_SSE2, SCANNER_AVX2};
+        for (ScannerKind kind : kinds)
+        {
+            if (!scannerSupported(kind))
+                continue;
+
+            std::vector<uint32_t> positions;
+            positions.reserve(expected);
+            ScanStats stats;
+            start = std::chrono::steady_clock::now();
+            for (int r = 0; r < repeats; r++)
+            {
+                positions.clear();
+                stats = ScanStats();
+                scanNewlines(kind, text.data(), 0, text.size(), positions, stats);
+            }
+            std::string name = std::string("scan ") + scannerName(kind);
+            report(name.c_str(), text.size(), elapsedMs(start) / repeats, stats.newlines);
+            ok = ok && stats.newlines == expected && positions.size() == expected;
+        }
+
+        unsigned threads = std::max(1u, std::thread::hardware_concurrency());
+        LineIndex index;
+        ScanStats stats;
+        start = std::chrono::steady_clock::now();
+        for (int r = 0; r < repeats; r++)
+        {
+            index.clear();
+            stats = ScanStats();
+            indexLines(text.data(), 0, text.size(), index, stats, threads);
+        }
+        std::string name = "indexLines x" + std::to_string(threads);
+        report(name.c_str(), text.size(), elapsedMs(start) / repeats, index.size());
+        std::printf("  crlf=%zu (%s)\n", stats.crlf, stats.isCrlf() ? "CRLF" : "LF");
+        ok = ok && index.size() == expected;
+
+        if (!ok)
+            std::printf("  MISMATCH: scanners disagree on newline count\n");
+        return ok;
+    }
+}
+
+int main(int argc, char **argv)
+{
+    const char *tree = argc > 1 ? argv[1] : nullptr;
+    size_t megabytes = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 256;
+
+    std::printf("selected scanner: %s, hardware threads: %u\n",
+                scannerName(detectScanner()), std::thread::hardware_concurrency());
+
+    bool ok = runSuite("synthetic LF", makeSynthetic(megabytes, false));
+    ok = runSuite("synthetic CRLF", makeSynthetic(megabytes / 4 + 1, true)) && ok;
+
+    if (tree)
+    {
+        std::string text = loadTree(tree, static_cast<size_t>(2) << 30);
+        std::string title = std::string("source tree ") + tree;
+        ok = runSuite(title.c_str(), text) && ok;
+    }
+    return ok ? 0 : 1;
+}
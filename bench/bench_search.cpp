@@ -0,0 +1,121 @@
+// Arama benchmark'ı: eski performSearch döngüsü (satır satır getLine + std::string::find) ile TextSearcher
+// Kullanım: bench_search [satır_sayısı] [düzenleme_sayısı]
+// Düzenlemeler belgeyi piece'lere böler, böylece parça sınırını aşan arama da ölçülür.
+#include "TextSearch.h"
+#include "bench_common.h"
+
+#include <cstdio>
+#include <cstdlib>
+
+using namespace bench;
+
+namespace
+{
+    std::string lowered(std::string text)
+    {
+        for (char &ch : text)
+        {
+            if (ch >= 'A' && ch <= 'Z')
+                ch = static_cast<char>(ch + 32);
+        }
+        return text;
+    }
+
+    // Eski performSearch: imleçten sona, sonra baştan imlece; büyük/küçük harf duyarsızda satır kopyası küçültülür
+    bool lineLoop(const TextDocument &document, const std::string &needle, bool ignore_case,
+                  int start_row, int start_col, int &row, int &col)
+    {
+        std::string pattern = ignore_case ? lowered(needle) : needle;
+        std::string line;
+        for (int i = start_row; i < document.lineCount(); i++)
+        {
+            document.getLine(i, line);
+            if (ignore_case)
+                line = lowered(line);
+            size_t pos = line.find(pattern, i == start_row ? static_cast<size_t>(start_col) : 0);
+            if (pos != std::string::npos)
+            {
+                row = i;
+                col = static_cast<int>(pos);
+                return true;
+            }
+        }
+        for (int i = 0; i <= start_row; i++)
+        {
+            document.getLine(i, line);
+            if (ignore_case)
+                line = lowered(line);
+            size_t pos = line.find(pattern);
+            if (pos != std::string::npos && (i < start_row || pos < static_cast<size_t>(start_col)))
+            {
+                row = i;
+                col = static_cast<int>(pos);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool engine(const TextDocument &document, const std::string &needle, bool ignore_case,
+                int start_row, int start_col, int &row, int &col)
+    {
+        TextSearcher searcher(needle, ignore_case);
+        size_t cursor = document.offsetAt(start_row, start_col);
+        size_t pos = searcher.find(document, cursor, document.length());
+        if (pos == TextSearcher::npos)
+            pos = searcher.find(document, 0, cursor + needle.size());
+        if (pos == TextSearcher::npos)
+            return false;
+        document.positionAt(pos, row, col);
+        return true;
+    }
+
+    bool runCase(const TextDocument &document, const char *title, const std::string &needle, bool ignore_case)
+    {
+        const int repeats = 3;
+        int start_row = document.lineCount() / 2;
+        double gigabytes = document.length() / 1e9;
+
+        int old_row = -1, old_col = -1;
+        bool old_found = false;
+        auto start = std::chrono::steady_clock::now();
+        for (int r = 0; r < repeats; r++)
+            old_found = lineLoop(document, needle, ignore_case, start_row, 0, old_row, old_col);
+        double old_ms = elapsedMs(start) / repeats;
+
+        int new_row = -1, new_col = -1;
+        bool new_found = false;
+        start = std::chrono::steady_clock::now();
+        for (int r = 0; r < repeats; r++)
+            new_found = engine(document, needle, ignore_case, start_row, 0, new_row, new_col);
+        double new_ms = elapsedMs(start) / repeats;
+
+        bool ok = old_found == new_found && (!old_found || (old_row == new_row && old_col == new_col));
+        std::printf("  %-28s line loop %9.2f ms  engine %8.2f ms (%6.2f GB/s)  x%-7.1f %s\n", title, old_ms, new_ms,
+                    new_ms > 0 ? gigabytes / (new_ms / 1000.0) : 0.0, new_ms > 0 ? old_ms / new_ms : 0.0,
+                    ok ? (new_found ? "hit" : "miss") : "MISMATCH");
+        return ok;
+    }
+}
+
+int main(int argc, char **argv)
+{
+    int line_count = argc > 1 ? std::atoi(argv[1]) : 2000000;
+    int edit_count = argc > 2 ? std::atoi(argv[2]) : 5000;
+
+    TextDocument document(joinLines(makeLines(line_count)));
+    for (const Edit &edit : makeEdits(edit_count))
+        applyToDocument(document, edit);
+
+    std::printf("document: %.1f MB, %d lines, %zu pieces, scanner %s\n", document.length() / (1024.0 * 1024.0),
+                document.lineCount(), document.pieceCount(), scannerName(detectScanner()));
+
+    std::string last_line = document.getLine(document.lineCount() - 2);
+    bool ok = runCase(document, "short miss", "no_such_symbol", false);
+    ok = runCase(document, "hit before cursor (wrap)", last_line.substr(4, 16), false) && ok;
+    ok = runCase(document, "single byte miss", "#", false) && ok;
+    ok = runCase(document, "long miss (two-way)", "compute(42); // generated, but never with this tail", false) && ok;
+    ok = runCase(document, "ignore case miss", "COMPUTE(96); // Missing", true) && ok;
+    ok = runCase(document, "ignore case long miss", "INT VALUE_12 = COMPUTE(12); // GENERATED AND NOT HERE", true) && ok;
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,140 @@
+// Satır kaydırma benchmark'ı: tüm belgenin ölçülmesi (byte taraması / satır satır lineLength),
+// görsel satır <-> belge satırı sorguları, satır içi düzenleme (yerinde güncelleme),
+// satır ekleyen düzenleme (etkilenen blokların yeniden kurulması) ve kaydırmalı tam kare çizimi
+// Sonuçlar her adımda satır satır ölçülen doğru sayılarla karşılaştırılır
+// Kullanım: bench_wrap [satır_sayısı] [sütun_sayısı]
+#include "HeadlessRenderer.h"
+#include "TextView.h"
+#include "WrapLayout.h"
+#include "bench_common.h"
+
+#include <cstdio>
+#include <cstdlib>
+
+using namespace bench;
+
+namespace
+{
+    const int FRAME_WIDTH = 1920;
+    const int FRAME_HEIGHT = 1080;
+    const int CHAR_WIDTH = 9;
+    const int CHAR_HEIGHT = 18;
+    const int QUERY_COUNT = 1000000;
+    const int EDIT_COUNT = 10000;
+    const int FRAME_COUNT = 200;
+
+    // Her satırın sayısı ve önek toplamı doğrudan hesaplananla aynı mı
+    bool verify(const WrapLayout &wrap, const TextDocument &document, int columns)
+    {
+        if (wrap.lineCount() != document.lineCount())
+            return false;
+        size_t total = 0;
+        for (int line = 0; line < document.lineCount(); line++)
+        {
+            uint32_t rows = WrapLayout::rowsFor(document.lineLength(line), columns);
+            if (wrap.rows(line) != rows || (line % 997 == 0 && wrap.rowsBefore(line) != total))
+                return false;
+            total += rows;
+        }
+        return wrap.totalRows() == total;
+    }
+}
+
+int main(int argc, char **argv)
+{
+    int line_count = argc > 1 ? std::atoi(argv[1]) : 1000000;
+    int columns = argc > 2 ? std::atoi(argv[2]) : 40;
+
+    // Satırların bir kısmı sütun sayısından birkaç kat uzun olsun
+    std::vector<std::string> lines = makeLines(line_count);
+    for (int i = 0; i < line_count; i += 7)
+        lines[i] += std::string(static_cast<size_t>(i % (columns * 5)), 'x');
+    TextDocument document(joinLines(lines));
+    lines.clear();
+    std::printf("%d lines, %.1f MB, wrapped at %d columns\n", document.lineCount(), document.length() / 1e6, columns);
+    bool ok = true;
+
+    auto start = std::chrono::steady_clock::now();
+    std::vector<uint32_t> rows;
+    WrapLayout::measure(document, 0, document.lineCount(), columns, rows);
+    double scan_ms = elapsedMs(start);
+
+    start = std::chrono::steady_clock::now();
+    std::vector<uint32_t> by_line;
+    by_line.reserve(static_cast<size_t>(document.lineCount()));
+    for (int line = 0; line < document.lineCount(); line++)
+        by_line.push_back(WrapLayout::rowsFor(document.lineLength(line), columns));
+    double line_ms = elapsedMs(start);
+    ok = ok && rows == by_line;
+
+    WrapLayout wrap;
+    start = std::chrono::steady_clock::now();
+    wrap.assign(std::move(rows), columns, document.revision());
+    size_t total = wrap.totalRows();
+    double build_ms = elapsedMs(start);
+    std::printf("  measure (byte scan)   %9.2f ms\n  measure (lineLength)  %9.2f ms\n  tree build            %9.2f ms"
+                "  %zu visual rows, %.1f MB\n",
+                scan_ms, line_ms, build_ms, total, wrap.memoryUsage() / 1e6);
+
+    std::mt19937 rng(12345);
+    start = std::chrono::steady_clock::now();
+    size_t sink = 0;
+    for (int i = 0; i < QUERY_COUNT; i++)
+    {
+        int sub_row = 0;
+        int line = wrap.lineAt(rng() % total, sub_row);
+        sink += wrap.rowsBefore(line) + sub_row;
+    }
+    std::printf("  lineAt + rowsBefore   %9.4f us/query\n", elapsedMs(start) * 1000.0 / QUERY_COUNT);
+
+    // Satır içi yazma: satır sayısı değişmez, ağaç yerinde güncellenir
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < EDIT_COUNT; i++)
+    {
+        int line = static_cast<int>(rng() % document.lineCount());
+        int old_line_count = document.lineCount();
+        size_t offset = document.lineStart(line);
+        std::string text(1 + rng() % 30, 'y');
+        document.insert(offset, text);
+        wrap.update(document, old_line_count, {TextChange{offset, 0, text.size()}});
+        int sub_row = 0;
+        sink += wrap.lineAt(wrap.rowsBefore(line), sub_row);
+    }
+    std::printf("  in-line edit          %9.4f us/edit (update + query)\n", elapsedMs(start) * 1000.0 / EDIT_COUNT);
+    ok = ok && verify(wrap, document, columns);
+
+    // Enter: satır sayısı değişir, sadece bölünen satırın bloğu yeniden kurulur
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < EDIT_COUNT / 10; i++)
+    {
+        int line = static_cast<int>(rng() % document.lineCount());
+        int old_line_count = document.lineCount();
+        size_t offset = document.lineStart(line) + document.lineLength(line) / 2;
+        document.insert(offset, "\n");
+        wrap.update(document, old_line_count, {TextChange{offset, 0, 1}});
+        int sub_row = 0;
+        sink += wrap.lineAt(wrap.rowsBefore(line), sub_row);
+    }
+    std::printf("  line split            %9.4f us/edit (update + query)\n",
+                elapsedMs(start) * 1000.0 / (EDIT_COUNT / 10));
+    ok = ok && verify(wrap, document, columns);
+
+    // Kaydırmalı tam kare: her karede bir görsel satır aşağı
+    HeadlessRenderer renderer(FRAME_WIDTH, FRAME_HEIGHT, CHAR_WIDTH, CHAR_HEIGHT);
+    TextView view = {RenderRect{0, 0, FRAME_WIDTH, FRAME_HEIGHT}, 0, 0, 0, 0, 0, 0, true, false, nullptr,
+                     CHAR_WIDTH, CHAR_HEIGHT, &wrap};
+    renderer.setClip(view.rect);
+    size_t top = total / 2;
+    int drawn = 0;
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < FRAME_COUNT; i++)
+    {
+        view.scroll_top = wrap.lineAt(top + i, view.scroll_row);
+        drawn += drawTextView(renderer, document, view, view.rect);
+    }
+    std::printf("  wrapped frame         %9.4f ms/frame  %5d rows/frame at %d columns\n", elapsedMs(start) / FRAME_COUNT,
+                drawn / FRAME_COUNT, columns);
+
+    std::printf("%s (%zu)\n", ok ? "ok" : "MISMATCH", sink % 10);
+    return ok ? 0 : 1;
+}
@@ -22,36 +22,19 @@ LRESULT CALLBACK WndProc(HWND hwnd, UINT msg, WPARAM wParam, LPARAM lParam)
         PAINTSTRUCT ps;
         HDC hdc = BeginPaint(hwnd, &ps);
 
-        RECT client_rect;
-        GetClientRect(hwnd, &client_rect);
-
-        HDC mem_dc = CreateCompatibleDC(hdc);
-        HBITMAP mem_bitmap = CreateCompatibleBitmap(hdc, client_rect.right, client_rect.bottom);
-        SelectObject(mem_dc, mem_bitmap);
-
+        // Sadece geçersiz kılınan bölge editörün kalıcı arka tamponuna çizilip kopyalanır
         if (g_editor)
         {
-            g_editor->paint(mem_dc);
+            g_editor->paint(hdc, ps.rcPaint);
         }
 
-        BitBlt(hdc, 0, 0, client_rect.right, client_rect.bottom, mem_dc, 0, 0, SRCCOPY);
-
-        DeleteObject(mem_bitmap);
-        DeleteDC(mem_dc);
-
         EndPaint(hwnd, &ps);
     }
     break;
 
     case WM_ERASEBKGND:
-    {
-        RECT client_rect;
-        GetClientRect(hwnd, &client_rect);
-        HBRUSH black_brush = CreateSolidBrush(RGB(0, 0, 0));
-        FillRect((HDC)wParam, &client_rect, black_brush);
-        DeleteObject(black_brush);
+        // Arka plan WM_PAINT'te arka tamponla birlikte çizilir; ayrıca silmek titreme ve fırça demek
         return TRUE;
-    }
 
     case WM_LBUTTONDOWN:
         if (g_editor)
@@ -60,6 +43,22 @@ LRESULT CALLBACK WndProc(HWND hwnd, UINT msg, WPARAM wParam, LPARAM lParam)
         }
         break;
 
+    case WM_MOUSEWHEEL:
+        if (g_editor)
+        {
+            // Koordinatlar ekrana göre ve çoklu monitörde negatif olabilir
+            g_editor->handleMouseWheel(GET_WHEEL_DELTA_WPARAM(wParam), static_cast<short>(LOWORD(lParam)),
+                                       static_cast<short>(HIWORD(lParam)));
+        }
+        return 0;
+
+    case WM_TIMER:
+        if (g_editor)
+        {
+            g_editor->handleTimer(wParam);
+        }
+        break;
+
     case WM_KEYDOWN:
         if (g_editor)
         {
@@ -81,6 +80,48 @@ LRESULT CALLBACK WndProc(HWND hwnd, UINT msg, WPARAM wParam, LPARAM lParam)
         }
         break;
 
+    case WM_LOAD_PROGRESS:
+        if (g_editor)
+        {
+            g_editor->handleLoadProgress();
+        }
+        break;
+
+    case WM_SEARCH_PROGRESS:
+        if (g_editor)
+        {
+            g_editor->handleSearchProgress();
+        }
+        break;
+
+    case WM_FIND_PROGRESS:
+        if (g_editor)
+        {
+            g_editor->handleFindProgress();
+        }
+        break;
+
+    case WM_INDEX_PROGRESS:
+        if (g_editor)
+        {
+            g_editor->handleIndexProgress();
+        }
+        break;
+
+    case WM_PATHS_PROGRESS:
+        if (g_editor)
+        {
+            g_editor->handlePathsProgress();
+        }
+        break;
+
+    case WM_WRAP_PROGRESS:
+        if (g_editor)
+        {
+            g_editor->handleWrapProgress();
+        }
+        break;
+
     case WM_DESTROY:
         delete g_editor;
         g_editor = nullptr;